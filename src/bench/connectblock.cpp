@@ -0,0 +1,77 @@
+// Copyright (c) 2026 The PirateCash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+
+#include <chain.h>
+#include <coins.h>
+#include <saltedhasher.h>
+#include <script/interpreter.h>
+#include <streams.h>
+#include <util/system.h>
+#include <validation.h>
+
+#include <bench/data/block813851.raw.h>
+
+#include <unordered_set>
+
+// The first phase of ConnectBlock on a real block, with every input which
+// isn't created by the block itself funded by a made up coin.
+
+static void PrecheckBlockInputsTest(benchmark::Bench& bench, bool fParallel)
+{
+    CDataStream stream((const char*)raw_bench::block813851,
+            (const char*)&raw_bench::block813851[sizeof(raw_bench::block813851)],
+            SER_NETWORK, PROTOCOL_VERSION);
+    CBlock block;
+    stream >> block;
+
+    CCoinsView viewDummy;
+    CCoinsViewCache view(&viewDummy);
+    std::unordered_set<uint256, StaticSaltedHasher> setBlockTxs;
+    for (const auto& tx : block.vtx) {
+        if (!tx->IsCoinBase()) {
+            for (size_t j = 0; j < tx->vin.size(); j++) {
+                if (setBlockTxs.count(tx->vin[j].prevout.hash)) continue;
+                // the first input pays for all outputs
+                CTxOut out(j == 0 ? tx->GetValueOut() : 0, CScript());
+                view.AddCoin(tx->vin[j].prevout, Coin(out, 1, false, false), false);
+            }
+        }
+        setBlockTxs.emplace(tx->GetHash());
+    }
+
+    CBlockIndex indexPrev;
+    indexPrev.nHeight = 813850;
+    CBlockIndex index;
+    index.pprev = &indexPrev;
+    index.nHeight = 813851;
+
+    if (fParallel) {
+        // The main thread should be counted to prevent thread oversubscription
+        StartTxInputsCheckWorkerThreads(GetNumCores() - 1);
+    }
+    bench.unit("block").run([&] {
+        auto prechecks = PrecheckBlockInputs(block, view, index, SCRIPT_VERIFY_P2SH, 0, fParallel);
+        for (const auto& precheck : prechecks) {
+            assert(precheck.fInputsValid);
+        }
+    });
+    if (fParallel) {
+        StopTxInputsCheckWorkerThreads();
+    }
+}
+
+static void PrecheckBlockInputsSerial(benchmark::Bench& bench)
+{
+    PrecheckBlockInputsTest(bench, false);
+}
+
+static void PrecheckBlockInputsParallel(benchmark::Bench& bench)
+{
+    PrecheckBlockInputsTest(bench, true);
+}
+
+BENCHMARK(PrecheckBlockInputsSerial);
+BENCHMARK(PrecheckBlockInputsParallel);
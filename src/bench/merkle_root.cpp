@@ -7,6 +7,8 @@
 #include <uint256.h>
 #include <random.h>
 #include <consensus/merkle.h>
+#include <hash.h>
+#include <merkleblock.h>
 
 static void MerkleRoot(benchmark::Bench& bench)
 {
@@ -23,4 +25,58 @@ static void MerkleRoot(benchmark::Bench& bench)
     });
 }
 
+// Leaves of about the size of a serialized simplified masternode list entry
+static std::vector<std::vector<unsigned char>> SerializedLeaves(size_t count)
+{
+    FastRandomContext rng(true);
+    std::vector<std::vector<unsigned char>> leaves;
+    for (size_t i = 0; i < count; i++) {
+        leaves.emplace_back(rng.randbytes(150));
+    }
+    return leaves;
+}
+
+static void MerkleRootSerializedLeaves(benchmark::Bench& bench)
+{
+    const auto leaves = SerializedLeaves(4000);
+    bench.batch(leaves.size()).unit("leaf").run([&] {
+        std::vector<uint256> hashes;
+        hashes.reserve(leaves.size());
+        for (const auto& leaf : leaves) {
+            hashes.emplace_back(SerializeHash(leaf));
+        }
+        ankerl::nanobench::doNotOptimizeAway(ComputeMerkleRoot(std::move(hashes)));
+    });
+}
+
+static void MerkleRootSerializedLeavesBatched(benchmark::Bench& bench)
+{
+    const auto leaves = SerializedLeaves(4000);
+    bench.batch(leaves.size()).unit("leaf").run([&] {
+        CBatchHashWriter hw(SER_GETHASH, PROTOCOL_VERSION);
+        for (const auto& leaf : leaves) {
+            hw.Add(leaf);
+        }
+        ankerl::nanobench::doNotOptimizeAway(ComputeMerkleRoot(hw.GetHashes()));
+    });
+}
+
+static void PartialMerkleTree(benchmark::Bench& bench)
+{
+    FastRandomContext rng(true);
+    std::vector<uint256> txids(9001);
+    std::vector<bool> match(txids.size());
+    for (size_t i = 0; i < txids.size(); i++) {
+        txids[i] = rng.rand256();
+        match[i] = rng.randrange(100) == 0;
+    }
+    bench.batch(txids.size()).unit("leaf").run([&] {
+        CPartialMerkleTree tree(txids, match);
+        ankerl::nanobench::doNotOptimizeAway(tree);
+    });
+}
+
 BENCHMARK(MerkleRoot);
+BENCHMARK(MerkleRootSerializedLeaves);
+BENCHMARK(MerkleRootSerializedLeavesBatched);
+BENCHMARK(PartialMerkleTree);
@@ -0,0 +1,33 @@
+// Copyright (c) 2026 The PirateCash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <interfaces/chain.h>
+#include <wallet/wallet.h>
+
+#include <cassert>
+
+// Keys per second when topping up the keypool of an HD wallet, every run derives a fresh keypool
+// of DEFAULT_KEYPOOL_SIZE external and as many internal keys.
+static void WalletKeypoolTopUp(benchmark::Bench& bench)
+{
+    std::unique_ptr<interfaces::Chain> chain = interfaces::MakeChain();
+    CWallet wallet{*chain.get(), WalletLocation(), CreateMockWalletDatabase()};
+    {
+        bool first_run;
+        if (wallet.LoadWallet(first_run) != DBErrors::LOAD_OK) assert(false);
+    }
+    {
+        LOCK(wallet.cs_wallet);
+        wallet.SetMinVersion(FEATURE_LATEST);
+        wallet.GenerateNewHDChain(/* secureMnemonic */ "", /* secureMnemonicPassphrase */ "");
+    }
+
+    bench.batch(DEFAULT_KEYPOOL_SIZE * 2).unit("key").run([&] {
+        bool ret = wallet.NewKeyPool();
+        assert(ret);
+    });
+}
+
+BENCHMARK(WalletKeypoolTopUp);
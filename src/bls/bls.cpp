@@ -7,11 +7,18 @@
 #include <random.h>
 
 #ifndef BUILD_BITCOIN_INTERNAL
+#include <crypto/sha256.h>
+#include <cuckoocache.h>
+#include <script/sigcache.h>
 #include <support/allocators/mt_pooled_secure.h>
 #endif
 
+#include <atomic>
 #include <cassert>
 #include <cstring>
+#ifndef BUILD_BITCOIN_INTERNAL
+#include <shared_mutex>
+#endif
 
 static const std::unique_ptr<bls::CoreMPL> pSchemeLegacy{std::make_unique<bls::LegacySchemeMPL>()};
 static const std::unique_ptr<bls::CoreMPL> pScheme(std::make_unique<bls::BasicSchemeMPL>());
@@ -258,17 +265,143 @@ void CBLSSignature::SubInsecure(const CBLSSignature& o)
     cachedHash.SetNull();
 }
 
-bool CBLSSignature::VerifyInsecure(const CBLSPublicKey& pubKey, const uint256& hash) const
+#ifndef BUILD_BITCOIN_INTERNAL
+namespace {
+/**
+ * Cache of successful BLS signature verifications. The same quorum and masternode signatures
+ * are usually verified several times (on receipt, when relaying, again when connecting a block
+ * that includes them), and a pairing check is far more expensive than a salted SHA256.
+ */
+class CBLSSignatureCache
+{
+private:
+    //! Entries are SHA256(nonce || scheme || hash || public key || signature)
+    CSHA256 m_salted_hasher;
+    CuckooCache::cache<uint256, SignatureCacheHasher> setValid;
+    std::shared_mutex cs_blssigcache;
+    std::atomic<bool> fSetup{false};
+    size_t nMaxEntries{0};
+
+public:
+    std::atomic<uint64_t> nHits{0};
+    std::atomic<uint64_t> nMisses{0};
+
+    CBLSSignatureCache()
+    {
+        uint256 nonce = GetRandHash();
+        // 64 bytes of salt, see CSignatureCache
+        m_salted_hasher.Write(nonce.begin(), 32);
+        m_salted_hasher.Write(nonce.begin(), 32);
+    }
+
+    bool IsSetup() const { return fSetup.load(std::memory_order_acquire); }
+
+    uint256 ComputeEntry(bool fLegacy, const uint256& hash, const std::vector<uint8_t>& vchPubKey, const std::vector<uint8_t>& vchSig) const
+    {
+        uint256 entry;
+        const uint8_t scheme = fLegacy ? 1 : 0;
+        CSHA256 hasher = m_salted_hasher;
+        hasher.Write(&scheme, 1).Write(hash.begin(), 32).Write(vchPubKey.data(), vchPubKey.size()).Write(vchSig.data(), vchSig.size()).Finalize(entry.begin());
+        return entry;
+    }
+
+    bool Get(const uint256& entry)
+    {
+        std::shared_lock<std::shared_mutex> lock(cs_blssigcache);
+        return setValid.contains(entry, false);
+    }
+
+    void Set(const uint256& entry)
+    {
+        std::unique_lock<std::shared_mutex> lock(cs_blssigcache);
+        setValid.insert(entry);
+    }
+
+    size_t Setup(size_t nBytes)
+    {
+        std::unique_lock<std::shared_mutex> lock(cs_blssigcache);
+        nMaxEntries = setValid.setup_bytes(nBytes);
+        fSetup.store(true, std::memory_order_release);
+        return nMaxEntries;
+    }
+
+    size_t GetMaxEntries()
+    {
+        std::shared_lock<std::shared_mutex> lock(cs_blssigcache);
+        return nMaxEntries;
+    }
+};
+
+static CBLSSignatureCache blsSignatureCache;
+} // namespace
+
+size_t InitBLSSignatureCache(size_t nMaxCacheBytes)
+{
+    return blsSignatureCache.Setup(nMaxCacheBytes);
+}
+
+CBLSSignatureCacheStats GetBLSSignatureCacheStats()
+{
+    CBLSSignatureCacheStats stats;
+    stats.nHits = blsSignatureCache.nHits.load(std::memory_order_relaxed);
+    stats.nMisses = blsSignatureCache.nMisses.load(std::memory_order_relaxed);
+    stats.nMaxEntries = blsSignatureCache.GetMaxEntries();
+    return stats;
+}
+
+void CountBLSSignatureCacheLookup(bool fHit)
+{
+    if (!blsSignatureCache.IsSetup()) {
+        return;
+    }
+    (fHit ? blsSignatureCache.nHits : blsSignatureCache.nMisses).fetch_add(1, std::memory_order_relaxed);
+}
+
+bool CBLSSignature::IsVerificationCached(const CBLSPublicKey& pubKey, const uint256& hash) const
+{
+    if (!IsValid() || !pubKey.IsValid() || !blsSignatureCache.IsSetup()) {
+        return false;
+    }
+    return blsSignatureCache.Get(blsSignatureCache.ComputeEntry(fLegacy, hash, pubKey.ToByteVector(), ToByteVector()));
+}
+
+void CBLSSignature::CacheVerification(const CBLSPublicKey& pubKey, const uint256& hash) const
+{
+    if (!IsValid() || !pubKey.IsValid() || !blsSignatureCache.IsSetup()) {
+        return;
+    }
+    blsSignatureCache.Set(blsSignatureCache.ComputeEntry(fLegacy, hash, pubKey.ToByteVector(), ToByteVector()));
+}
+#endif
+
+bool CBLSSignature::VerifyInsecure(const CBLSPublicKey& pubKey, const uint256& hash, bool fCheckCache) const
 {
     if (!IsValid() || !pubKey.IsValid()) {
         return false;
     }
 
+#ifndef BUILD_BITCOIN_INTERNAL
+    if (fCheckCache) {
+        const bool fCached = IsVerificationCached(pubKey, hash);
+        CountBLSSignatureCacheLookup(fCached);
+        if (fCached) {
+            return true;
+        }
+    }
+#endif
+
     try {
-        return Scheme(fLegacy)->Verify(pubKey.impl, bls::Bytes(hash.begin(), hash.size()), impl);
+        if (!Scheme(fLegacy)->Verify(pubKey.impl, bls::Bytes(hash.begin(), hash.size()), impl)) {
+            return false;
+        }
     } catch (...) {
         return false;
     }
+
+#ifndef BUILD_BITCOIN_INTERNAL
+    CacheVerification(pubKey, hash);
+#endif
+    return true;
 }
 
 bool CBLSSignature::VerifyInsecureAggregated(const std::vector<CBLSPublicKey>& pubKeys, const std::vector<uint256>& hashes) const
@@ -290,12 +290,23 @@ public:
 
     void SubInsecure(const CBLSSignature& o);
 
-    bool VerifyInsecure(const CBLSPublicKey& pubKey, const uint256& hash) const;
+    //! fCheckCache = false skips the signature cache lookup, for callers which did it themselves already
+    bool VerifyInsecure(const CBLSPublicKey& pubKey, const uint256& hash, bool fCheckCache = true) const;
+#ifndef BUILD_BITCOIN_INTERNAL
+    //! Returns true if VerifyInsecure() already succeeded for this signature, pubKey and hash. Callers which
+    //! decide on a verification with this have to count it with CountBLSSignatureCacheLookup()
+    bool IsVerificationCached(const CBLSPublicKey& pubKey, const uint256& hash) const;
+#endif
     bool VerifyInsecureAggregated(const std::vector<CBLSPublicKey>& pubKeys, const std::vector<uint256>& hashes) const;
 
     bool VerifySecureAggregated(const std::vector<CBLSPublicKey>& pks, const uint256& hash) const;
 
     bool Recover(const std::vector<CBLSSignature>& sigs, const std::vector<CBLSId>& ids);
+
+private:
+#ifndef BUILD_BITCOIN_INTERNAL
+    void CacheVerification(const CBLSPublicKey& pubKey, const uint256& hash) const;
+#endif
 };
 
 #ifndef BUILD_BITCOIN_INTERNAL
@@ -455,4 +466,22 @@ using BLSSignatureVectorPtr = std::shared_ptr<BLSSignatureVector>;
 
 bool BLSInit();
 
+#ifndef BUILD_BITCOIN_INTERNAL
+// Default size of the BLS signature verification cache in MiB
+static const int64_t DEFAULT_MAX_BLS_SIG_CACHE_SIZE = 8;
+
+struct CBLSSignatureCacheStats
+{
+    uint64_t nHits{0};
+    uint64_t nMisses{0};
+    size_t nMaxEntries{0};
+};
+
+// To be called once in AppInitMain/BasicTestingSetup, verifications are not cached before that
+size_t InitBLSSignatureCache(size_t nMaxCacheBytes);
+CBLSSignatureCacheStats GetBLSSignatureCacheStats();
+// Count one verification which looked up the signature cache as a hit or a miss
+void CountBLSSignatureCacheLookup(bool fHit);
+#endif
+
 #endif // DASH_CRYPTO_BLS_H
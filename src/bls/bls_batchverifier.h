@@ -8,6 +8,7 @@
 #include <bls/bls.h>
 
 #include <map>
+#include <set>
 #include <vector>
 
 template<typename SourceId, typename MessageId>
@@ -70,14 +71,25 @@ public:
 
     void Verify()
     {
+        // Messages which were already verified successfully (e.g. the same recovered signature received from
+        // multiple peers) don't need to take part in the aggregated pairing check again
+        std::set<MessageId> cachedMessages;
         std::map<uint256, std::vector<MessageMapIterator>> byMessageHash;
 
         for (auto it = messages.begin(); it != messages.end(); ++it) {
+            // each message is counted here once, the per-message fallback below doesn't look it up again
+            const bool fCached = it->second.sig.IsVerificationCached(it->second.pubKey, it->second.msgHash);
+            CountBLSSignatureCacheLookup(fCached);
+            if (fCached) {
+                cachedMessages.emplace(it->first);
+                continue;
+            }
             byMessageHash[it->second.msgHash].emplace_back(it);
         }
 
         if (VerifyBatch(byMessageHash)) {
-            // full batch is valid
+            // full batch is valid. Note that results are not added to the cache here, as a valid aggregate does not
+            // prove each individual signature to be valid. Only VerifyInsecure() populates the cache.
             return;
         }
 
@@ -85,12 +97,19 @@ public:
         for (const auto& p : messagesBySource) {
             bool batchValid = false;
 
-            // no need to verify it again if there was just one source
-            if (messagesBySource.size() != 1) {
-                byMessageHash.clear();
-                for (auto it = p.second.begin(); it != p.second.end(); ++it) {
-                    byMessageHash[(*it)->second.msgHash].emplace_back(*it);
+            byMessageHash.clear();
+            for (auto it = p.second.begin(); it != p.second.end(); ++it) {
+                if (cachedMessages.count((*it)->first)) {
+                    continue;
                 }
+                byMessageHash[(*it)->second.msgHash].emplace_back(*it);
+            }
+
+            if (byMessageHash.empty()) {
+                // all messages from this source were verified before
+                batchValid = true;
+            } else if (messagesBySource.size() != 1) {
+                // no need to verify it again if there was just one source
                 batchValid = VerifyBatch(byMessageHash);
             }
             if (!batchValid) {
@@ -103,13 +122,13 @@ public:
                         badMessages.emplace(p.second[0]->second.msgId);
                     } else {
                         for (const auto& msgIt : p.second) {
-                            if (badMessages.count(msgIt->first)) {
+                            if (badMessages.count(msgIt->first) || cachedMessages.count(msgIt->first)) {
                                 // same message might be invalid from different source, so no need to re-verify it
                                 continue;
                             }
 
                             const auto& msg = msgIt->second;
-                            if (!msg.sig.VerifyInsecure(msg.pubKey, msg.msgHash)) {
+                            if (!msg.sig.VerifyInsecure(msg.pubKey, msg.msgHash, false /* fCheckCache */)) {
                                 badMessages.emplace(msg.msgId);
                             }
                         }
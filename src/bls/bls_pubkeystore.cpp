@@ -0,0 +1,121 @@
+// Copyright (c) 2026 The PirateCash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bls/bls_pubkeystore.h>
+
+#include <hash.h>
+
+#include <algorithm>
+
+static uint256 CalcKeyHash(const CBLSPublicKeyStore::KeyBytes& vecBytes)
+{
+    // must match CBLSLazyWrapper::GetHash()
+    CHashWriter ss(SER_GETHASH, PROTOCOL_VERSION);
+    ss.write((const char*)vecBytes.data(), vecBytes.size());
+    return ss.GetHash();
+}
+
+static bool IsNullKey(const CBLSPublicKeyStore::KeyBytes& vecBytes)
+{
+    return std::all_of(vecBytes.begin(), vecBytes.end(), [](uint8_t c) { return c == 0; });
+}
+
+const CBLSPublicKey& CBLSPublicKeyStore::Entry::Get() const
+{
+    std::unique_lock<std::mutex> l(mutex);
+    if (!objInitialized) {
+        std::vector<uint8_t> vecTmp(vecBytes.begin(), vecBytes.end());
+        obj.SetByteVector(vecTmp);
+        if (!obj.CheckMalleable(vecTmp)) {
+            obj.Reset();
+        }
+        objInitialized = true;
+    }
+    return obj;
+}
+
+CBLSPublicKeyStore& CBLSPublicKeyStore::Instance()
+{
+    // Intentionally leaked, entries may be released from static destructors of other objects at shutdown
+    static CBLSPublicKeyStore* store = new CBLSPublicKeyStore();
+    return *store;
+}
+
+void CBLSPublicKeyStore::Release(const Entry* entry)
+{
+    {
+        LOCK(cs);
+        auto it = mapEntries.find(entry->hash);
+        // The key might have been interned again after the last reference went away, in which case the map
+        // already points to the new entry
+        if (it != mapEntries.end() && it->second.expired()) {
+            mapEntries.erase(it);
+        }
+    }
+    delete entry;
+}
+
+CBLSPublicKeyStore::EntryPtr CBLSPublicKeyStore::Intern(const KeyBytes& vecBytes)
+{
+    if (IsNullKey(vecBytes)) {
+        return nullptr;
+    }
+
+    const uint256 hash = CalcKeyHash(vecBytes);
+
+    LOCK(cs);
+    auto& weakEntry = mapEntries[hash];
+    if (auto entry = weakEntry.lock()) {
+        return entry;
+    }
+    EntryPtr entry(new Entry(vecBytes, hash), [this](const Entry* e) { Release(e); });
+    weakEntry = entry;
+    return entry;
+}
+
+CBLSPublicKeyStore::EntryPtr CBLSPublicKeyStore::Intern(const CBLSPublicKey& pubKey)
+{
+    if (!pubKey.IsValid()) {
+        return nullptr;
+    }
+
+    KeyBytes vecBytes;
+    const auto vecTmp = pubKey.ToByteVector();
+    std::copy(vecTmp.begin(), vecTmp.end(), vecBytes.begin());
+
+    auto entry = Intern(vecBytes);
+    if (entry != nullptr) {
+        // we already have the decompressed key, no need to do it again on first use
+        std::unique_lock<std::mutex> l(entry->mutex);
+        if (!entry->objInitialized) {
+            entry->obj = pubKey;
+            entry->objInitialized = true;
+        }
+    }
+    return entry;
+}
+
+size_t CBLSPublicKeyStore::Size() const
+{
+    LOCK(cs);
+    return mapEntries.size();
+}
+
+const CBLSPublicKey& CBLSInternedPublicKey::Get() const
+{
+    static const CBLSPublicKey invalidObj;
+    if (entry == nullptr) {
+        return invalidObj;
+    }
+    return entry->Get();
+}
+
+uint256 CBLSInternedPublicKey::GetHash() const
+{
+    if (entry == nullptr) {
+        static const uint256 nullHash = CalcKeyHash(CBLSPublicKeyStore::KeyBytes{});
+        return nullHash;
+    }
+    return entry->hash;
+}
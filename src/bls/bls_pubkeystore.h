@@ -0,0 +1,130 @@
+// Copyright (c) 2026 The PirateCash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef DASH_CRYPTO_BLS_PUBKEYSTORE_H
+#define DASH_CRYPTO_BLS_PUBKEYSTORE_H
+
+#include <bls/bls.h>
+#include <saltedhasher.h>
+#include <serialize.h>
+#include <sync.h>
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+/**
+ * Process wide store of BLS public keys, deduplicated by their serialized form.
+ *
+ * Every version of the deterministic MN list holds its own copy of each operator key. Most of these copies are
+ * identical, so instead of keeping the bytes and the decompressed G1 point per copy, they all share a refcounted
+ * entry from this store. The point is decompressed at most once per entry, no matter how many list versions
+ * reference it. Entries are removed from the store when the last reference goes away.
+ */
+class CBLSPublicKeyStore
+{
+public:
+    using KeyBytes = std::array<uint8_t, BLS_CURVE_PUBKEY_SIZE>;
+
+    class Entry
+    {
+        friend class CBLSPublicKeyStore;
+
+    private:
+        mutable std::mutex mutex;
+        mutable CBLSPublicKey obj;
+        mutable bool objInitialized{false};
+
+    public:
+        const KeyBytes vecBytes;
+        const uint256 hash;
+
+        Entry(const KeyBytes& _vecBytes, const uint256& _hash) : vecBytes(_vecBytes), hash(_hash) {}
+
+        const CBLSPublicKey& Get() const;
+    };
+    using EntryPtr = std::shared_ptr<const Entry>;
+
+private:
+    mutable Mutex cs;
+    std::unordered_map<uint256, std::weak_ptr<const Entry>, StaticSaltedHasher> mapEntries GUARDED_BY(cs);
+
+    CBLSPublicKeyStore() = default;
+
+    void Release(const Entry* entry);
+
+public:
+    static CBLSPublicKeyStore& Instance();
+
+    /** Returns the shared entry for the serialized key, creating it if necessary. All-zero keys are represented by nullptr */
+    EntryPtr Intern(const KeyBytes& vecBytes);
+    /** Same as above, but seeds a newly created entry with an already decompressed key */
+    EntryPtr Intern(const CBLSPublicKey& pubKey);
+
+    size_t Size() const;
+};
+
+/**
+ * Drop-in replacement for CBLSLazyPublicKey which references an interned key from CBLSPublicKeyStore. Copies are
+ * cheap (a refcount increment) and share the decompressed key.
+ */
+class CBLSInternedPublicKey
+{
+private:
+    CBLSPublicKeyStore::EntryPtr entry;
+
+public:
+    CBLSInternedPublicKey() = default;
+
+    inline void Serialize(CSizeComputer& s) const
+    {
+        s.seek(BLS_CURVE_PUBKEY_SIZE);
+    }
+
+    template<typename Stream>
+    inline void Serialize(Stream& s) const
+    {
+        if (entry == nullptr) {
+            static const CBLSPublicKeyStore::KeyBytes nullBytes{};
+            s.write((const char*)nullBytes.data(), nullBytes.size());
+        } else {
+            s.write((const char*)entry->vecBytes.data(), entry->vecBytes.size());
+        }
+    }
+
+    template<typename Stream>
+    inline void Unserialize(Stream& s)
+    {
+        CBLSPublicKeyStore::KeyBytes vecBytes;
+        s.read((char*)vecBytes.data(), vecBytes.size());
+        entry = CBLSPublicKeyStore::Instance().Intern(vecBytes);
+    }
+
+    void Set(const CBLSPublicKey& pubKey)
+    {
+        entry = CBLSPublicKeyStore::Instance().Intern(pubKey);
+    }
+
+    const CBLSPublicKey& Get() const;
+    uint256 GetHash() const;
+
+    bool operator==(const CBLSInternedPublicKey& r) const
+    {
+        if (entry == r.entry) {
+            return true;
+        }
+        if (entry == nullptr || r.entry == nullptr) {
+            return false;
+        }
+        return entry->hash == r.entry->hash;
+    }
+
+    bool operator!=(const CBLSInternedPublicKey& r) const
+    {
+        return !(*this == r);
+    }
+};
+
+#endif // DASH_CRYPTO_BLS_PUBKEYSTORE_H
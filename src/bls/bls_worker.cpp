@@ -3,6 +3,7 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <bls/bls_worker.h>
+#include <bls/bls_ies.h>
 #include <hash.h>
 #include <serialize.h>
 
@@ -74,6 +75,11 @@ void CBLSWorker::Stop()
     workerPool.stop(true);
 }
 
+bool CBLSWorker::IsStarted()
+{
+    return workerPool.size() != 0;
+}
+
 bool CBLSWorker::GenerateContributions(int quorumThreshold, const BLSIdVector& ids, BLSVerificationVectorPtr& vvecRet, BLSSecretKeyVector& skSharesRet)
 {
     auto svec = BLSSecretKeyVector((size_t)quorumThreshold);
@@ -826,6 +832,47 @@ std::future<bool> CBLSWorker::AsyncVerifySig(const CBLSSignature& sig, const CBL
     return std::move(p.second);
 }
 
+std::future<bool> CBLSWorker::AsyncVerifySigUnbatched(const CBLSSignature& sig, const CBLSPublicKey& pubKey, const uint256& msgHash)
+{
+    if (!sig.IsValid() || !pubKey.IsValid()) {
+        auto p = BuildFutureDoneCallback<bool>();
+        p.first(false);
+        return std::move(p.second);
+    }
+
+    auto f = [sig, pubKey, msgHash](int threadId) {
+        return sig.VerifyInsecure(pubKey, msgHash);
+    };
+    return workerPool.push(f);
+}
+
+std::future<bool> CBLSWorker::AsyncVerifySecureAggregatedSig(const CBLSSignature& sig, const BLSPublicKeyVector& pubKeys, const uint256& msgHash)
+{
+    if (!sig.IsValid() || pubKeys.empty()) {
+        auto p = BuildFutureDoneCallback<bool>();
+        p.first(false);
+        return std::move(p.second);
+    }
+
+    auto f = [sig, pubKeys, msgHash](int threadId) {
+        return sig.VerifySecureAggregated(pubKeys, msgHash);
+    };
+    return workerPool.push(f);
+}
+
+std::future<CBLSSecretKey> CBLSWorker::AsyncDecryptSecretKey(const std::shared_ptr<CBLSIESMultiRecipientObjects<CBLSSecretKey>>& objects,
+                                                             size_t idx, const CBLSSecretKey& secretKey, int nVersion)
+{
+    auto f = [objects, idx, secretKey, nVersion](int threadId) {
+        CBLSSecretKey ret;
+        if (!objects->Decrypt(idx, secretKey, ret, nVersion)) {
+            return CBLSSecretKey();
+        }
+        return ret;
+    };
+    return workerPool.push(f);
+}
+
 bool CBLSWorker::IsAsyncVerifyInProgress()
 {
     std::unique_lock<std::mutex> l(sigVerifyMutex);
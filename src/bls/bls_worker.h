@@ -13,6 +13,9 @@
 #include <mutex>
 #include <utility>
 
+template <typename Object>
+class CBLSIESMultiRecipientObjects;
+
 // Low level BLS/DKG stuff. All very compute intensive and optimized for parallelization
 // The worker tries to parallelize as much as possible and utilizes a few properties of BLS aggregation to speed up things
 // For example, public key vectors can be aggregated in parallel if they are split into batches and the batched aggregations are
@@ -54,6 +57,8 @@ public:
 
     void Start();
     void Stop();
+    // Async* functions must not be waited for before the worker was started
+    bool IsStarted();
 
     bool GenerateContributions(int threshold, const BLSIdVector& ids, BLSVerificationVectorPtr& vvecRet, BLSSecretKeyVector& skSharesRet);
 
@@ -129,6 +134,19 @@ public:
     std::future<bool> AsyncVerifySig(const CBLSSignature& sig, const CBLSPublicKey& pubKey, const uint256& msgHash, CancelCond cancelCond = [] { return false; });
     bool IsAsyncVerifyInProgress();
 
+    // Verification of a single signature on its own. Unlike AsyncVerifySig, a tampered signature can't pass by
+    // cancelling out against another one of the same batch, so use this when a valid result is cached
+    std::future<bool> AsyncVerifySigUnbatched(const CBLSSignature& sig, const CBLSPublicKey& pubKey, const uint256& msgHash);
+
+    // Verification of a signature aggregated from multiple signers, see CBLSSignature::VerifySecureAggregated.
+    // Not batched, as this is usually expensive enough on its own (e.g. final commitments with hundreds of signers)
+    std::future<bool> AsyncVerifySecureAggregatedSig(const CBLSSignature& sig, const BLSPublicKeyVector& pubKeys, const uint256& msgHash);
+
+    // Decryption of the secret key meant for recipient idx, e.g. this member's share of a DKG contribution
+    // The returned key is invalid if decryption failed
+    std::future<CBLSSecretKey> AsyncDecryptSecretKey(const std::shared_ptr<CBLSIESMultiRecipientObjects<CBLSSecretKey>>& objects,
+                                                     size_t idx, const CBLSSecretKey& secretKey, int nVersion);
+
 private:
     void PushSigVerifyBatch();
 };
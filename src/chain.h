@@ -197,6 +197,9 @@ public:
     // proof-of-stake specific fields
     uint256 posStakeHash;
     uint32_t posStakeN;
+    //! (memory only) Key ID recovered from vchBlockSig of a PoSv2 block, null until recovered
+    CKeyID posSignerID;
+
     bool IsProofOfWork() const
     {
         return !((nFlags & BLOCK_PROOF_OF_STAKE)||(nVersion & CBlockHeader::POS_BIT));
@@ -262,6 +265,7 @@ public:
         posStakeHash   = uint256();
         posStakeN      = 0;
         vchBlockSig.clear();
+        posSignerID.SetNull();
     }
 
     CBlockIndex()
@@ -199,18 +199,12 @@ void CCoinJoinServer::ProcessDSSIGNFINALTX(CNode* pfrom, const std::string& strC
 
     LogPrint(BCLog::COINJOIN, "DSSIGNFINALTX -- vecTxIn.size() %s\n", vecTxIn.size());
 
-    int nTxInIndex = 0;
-    int nTxInsCount = (int)vecTxIn.size();
-
-    for (const auto& txin : vecTxIn) {
-        nTxInIndex++;
-        if (!AddScriptSig(txin)) {
-            LogPrint(BCLog::COINJOIN, "DSSIGNFINALTX -- AddScriptSig() failed at %d/%d, session: %d\n", nTxInIndex, nTxInsCount, nSessionID);
-            RelayStatus(STATUS_REJECTED, connman);
-            return;
-        }
-        LogPrint(BCLog::COINJOIN, "DSSIGNFINALTX -- AddScriptSig() %d/%d success\n", nTxInIndex, nTxInsCount);
+    if (!AddScriptSigs(vecTxIn)) {
+        LogPrint(BCLog::COINJOIN, "DSSIGNFINALTX -- AddScriptSigs() failed for %d inputs, session: %d\n", vecTxIn.size(), nSessionID);
+        RelayStatus(STATUS_REJECTED, connman);
+        return;
     }
+    LogPrint(BCLog::COINJOIN, "DSSIGNFINALTX -- AddScriptSigs() %d inputs success\n", vecTxIn.size());
     // all is good
     CheckPool(connman);
 }
@@ -219,6 +213,7 @@ void CCoinJoinServer::SetNull()
 {
     // MN side
     vecSessionCollaterals.clear();
+    WITH_LOCK(cs_coinjoin, mapFinalTxInputs.clear(); setFinalScriptSigs.clear());
 
     CCoinJoinBaseSession::SetNull();
     CCoinJoinBaseManager::SetNull();
@@ -266,21 +261,30 @@ void CCoinJoinServer::CreateFinalTransaction(CConnman& connman)
     LOCK(cs_coinjoin);
 
     CMutableTransaction txNew;
+    std::map<COutPoint, CFinalTxInput> mapInputs;
 
     // make our new transaction
-    for (int i = 0; i < GetEntriesCount(); i++) {
+    for (size_t i = 0; i < vecEntries.size(); i++) {
         for (const auto& txout : vecEntries[i].vecTxOut) {
             txNew.vout.push_back(txout);
         }
-        for (const auto& txdsin : vecEntries[i].vecTxDSIn) {
-            txNew.vin.push_back(txdsin);
+        for (size_t j = 0; j < vecEntries[i].vecTxDSIn.size(); j++) {
+            txNew.vin.push_back(vecEntries[i].vecTxDSIn[j]);
+            mapInputs.emplace(vecEntries[i].vecTxDSIn[j].prevout, CFinalTxInput{0, i, j});
         }
     }
 
     sort(txNew.vin.begin(), txNew.vin.end(), CompareInputBIP69());
     sort(txNew.vout.begin(), txNew.vout.end(), CompareOutputBIP69());
 
+    // remember where each input ended up so that signatures can be matched without rebuilding the transaction
+    for (size_t i = 0; i < txNew.vin.size(); i++) {
+        mapInputs.at(txNew.vin[i].prevout).nTxIn = i;
+    }
+
     finalMutableTransaction = txNew;
+    mapFinalTxInputs = std::move(mapInputs);
+    setFinalScriptSigs.clear();
     LogPrint(BCLog::COINJOIN, "CCoinJoinServer::CreateFinalTransaction -- finalMutableTransaction=%s", txNew.ToString()); /* Continued */
 
     // request signatures from clients
@@ -488,51 +492,6 @@ void CCoinJoinServer::CheckForCompleteQueue(CConnman& connman)
     }
 }
 
-// Check to make sure a given input matches an input in the pool and its scriptSig is valid
-bool CCoinJoinServer::IsInputScriptSigValid(const CTxIn& txin) const
-{
-    CMutableTransaction txNew;
-    txNew.vin.clear();
-    txNew.vout.clear();
-
-    int nTxInIndex = -1;
-    CScript sigPubKey = CScript();
-
-    {
-        LOCK(cs_coinjoin);
-        int i = 0;
-        for (const auto &entry: vecEntries) {
-            for (const auto &txout: entry.vecTxOut) {
-                txNew.vout.push_back(txout);
-            }
-            for (const auto &txdsin: entry.vecTxDSIn) {
-                txNew.vin.push_back(txdsin);
-
-                if (txdsin.prevout == txin.prevout) {
-                    nTxInIndex = i;
-                    sigPubKey = txdsin.prevPubKey;
-                }
-                i++;
-            }
-        }
-    }
-    if (nTxInIndex >= 0) { //might have to do this one input at a time?
-        txNew.vin[nTxInIndex].scriptSig = txin.scriptSig;
-        LogPrint(BCLog::COINJOIN, "CCoinJoinServer::IsInputScriptSigValid -- verifying scriptSig %s\n", ScriptToAsmStr(txin.scriptSig).substr(0, 24));
-        // TODO we're using amount=0 here but we should use the correct amount. This works because Dash ignores the amount while signing/verifying (only used in Bitcoin/Segwit)
-        if (!VerifyScript(txNew.vin[nTxInIndex].scriptSig, sigPubKey, SCRIPT_VERIFY_P2SH | SCRIPT_VERIFY_STRICTENC, MutableTransactionSignatureChecker(&txNew, nTxInIndex, 0))) {
-            LogPrint(BCLog::COINJOIN, "CCoinJoinServer::IsInputScriptSigValid -- VerifyScript() failed on input %d\n", nTxInIndex);
-            return false;
-        }
-    } else {
-        LogPrint(BCLog::COINJOIN, "CCoinJoinServer::IsInputScriptSigValid -- Failed to find matching input in pool, %s\n", txin.ToString());
-        return false;
-    }
-
-    LogPrint(BCLog::COINJOIN, "CCoinJoinServer::IsInputScriptSigValid -- Successfully validated input and scriptSig\n");
-    return true;
-}
-
 //
 // Add a client's transaction inputs/outputs to the pool
 //
@@ -598,41 +557,88 @@ bool CCoinJoinServer::AddEntry(CConnman& connman, const CCoinJoinEntry& entry, P
     return true;
 }
 
-bool CCoinJoinServer::AddScriptSig(const CTxIn& txinNew)
+bool CCoinJoinServer::AddScriptSigs(const std::vector<CTxIn>& vecTxIn)
 {
-    LogPrint(BCLog::COINJOIN, "CCoinJoinServer::AddScriptSig -- scriptSig=%s\n", ScriptToAsmStr(txinNew.scriptSig).substr(0, 24));
-
-    LOCK(cs_coinjoin);
-    for (const auto& entry : vecEntries) {
-        if (ranges::any_of(entry.vecTxDSIn,
-                        [&txinNew](const auto& txdsin){ return txdsin.scriptSig == txinNew.scriptSig; })){
-            LogPrint(BCLog::COINJOIN, "CCoinJoinServer::AddScriptSig -- already exists\n");
+    if (vecTxIn.empty()) return false;
+
+    // Clients sign the BIP69 sorted final transaction with SIGHASH_ALL|SIGHASH_ANYONECANPAY,
+    // so the signature hash of an input only depends on the input itself and on the outputs.
+    // Verify against the final transaction with just this batch's scriptSigs filled in.
+    CMutableTransaction txVerify;
+    std::vector<std::pair<CFinalTxInput, CScript>> vecInputs;
+    std::vector<CTxOut> vecSpent;
+    int nSessionIDVerify;
+    {
+        LOCK(cs_coinjoin);
+        if (nState != POOL_STATE_SIGNING) {
+            LogPrint(BCLog::COINJOIN, "CCoinJoinServer::%s -- not signing, state: %s\n", __func__, GetStateString());
             return false;
         }
+
+        std::set<CScript> setBatchScriptSigs;
+        for (const auto& txinNew : vecTxIn) {
+            LogPrint(BCLog::COINJOIN, "CCoinJoinServer::%s -- scriptSig=%s\n", __func__, ScriptToAsmStr(txinNew.scriptSig).substr(0, 24));
+            if (setFinalScriptSigs.count(txinNew.scriptSig) || !setBatchScriptSigs.emplace(txinNew.scriptSig).second) {
+                LogPrint(BCLog::COINJOIN, "CCoinJoinServer::%s -- already exists\n", __func__);
+                return false;
+            }
+            auto it = mapFinalTxInputs.find(txinNew.prevout);
+            if (it == mapFinalTxInputs.end() || finalMutableTransaction.vin[it->second.nTxIn].nSequence != txinNew.nSequence) {
+                LogPrint(BCLog::COINJOIN, "CCoinJoinServer::%s -- Failed to find matching input in pool, %s\n", __func__, txinNew.ToString());
+                return false;
+            }
+            const auto& txdsin = vecEntries[it->second.nEntry].vecTxDSIn[it->second.nEntryTxIn];
+            if (txdsin.fHasSig) {
+                LogPrint(BCLog::COINJOIN, "CCoinJoinServer::%s -- input is signed already, %s\n", __func__, txinNew.ToString());
+                return false;
+            }
+            // TODO we're using amount=0 here but we should use the correct amount. This works because Dash ignores the amount while signing/verifying (only used in Bitcoin/Segwit)
+            vecSpent.emplace_back(0, txdsin.prevPubKey);
+            vecInputs.emplace_back(it->second, txinNew.scriptSig);
+        }
+
+        txVerify = finalMutableTransaction;
+        nSessionIDVerify = nSessionID;
     }
 
-    if (!IsInputScriptSigValid(txinNew)) {
-        LogPrint(BCLog::COINJOIN, "CCoinJoinServer::AddScriptSig -- Invalid scriptSig\n");
+    for (const auto& [input, scriptSig] : vecInputs) {
+        txVerify.vin[input.nTxIn].scriptSig = scriptSig;
+    }
+    const CTransaction tx(txVerify);
+    PrecomputedTransactionData txdata(tx);
+    std::vector<CScriptCheck> vChecks;
+    vChecks.reserve(vecInputs.size());
+    for (size_t i = 0; i < vecInputs.size(); i++) {
+        // Store the signatures in the cache, CommitFinalTransaction doesn't have to verify them again
+        vChecks.emplace_back(vecSpent[i], tx, vecInputs[i].first.nTxIn, SCRIPT_VERIFY_P2SH | SCRIPT_VERIFY_STRICTENC, true /* cacheStore */, &txdata);
+    }
+    if (!RunScriptChecks(vChecks)) {
+        LogPrint(BCLog::COINJOIN, "CCoinJoinServer::%s -- VerifyScript() failed, invalid scriptSig\n", __func__);
         return false;
     }
 
-    LogPrint(BCLog::COINJOIN, "CCoinJoinServer::AddScriptSig -- scriptSig=%s new\n", ScriptToAsmStr(txinNew.scriptSig).substr(0, 24));
-
-    for (auto& txin : finalMutableTransaction.vin) {
-        if (txin.prevout == txinNew.prevout && txin.nSequence == txinNew.nSequence) {
-            txin.scriptSig = txinNew.scriptSig;
-            LogPrint(BCLog::COINJOIN, "CCoinJoinServer::AddScriptSig -- adding to finalMutableTransaction, scriptSig=%s\n", ScriptToAsmStr(txinNew.scriptSig).substr(0, 24));
-        }
+    LOCK(cs_coinjoin);
+    // the session could have moved on while we were verifying
+    if (nState != POOL_STATE_SIGNING || nSessionID != nSessionIDVerify) {
+        LogPrint(BCLog::COINJOIN, "CCoinJoinServer::%s -- session changed, state: %s\n", __func__, GetStateString());
+        return false;
     }
-    for (int i = 0; i < GetEntriesCount(); i++) {
-        if (vecEntries[i].AddScriptSig(txinNew)) {
-            LogPrint(BCLog::COINJOIN, "CCoinJoinServer::AddScriptSig -- adding to entries, scriptSig=%s\n", ScriptToAsmStr(txinNew.scriptSig).substr(0, 24));
-            return true;
+    for (const auto& [input, scriptSig] : vecInputs) {
+        if (vecEntries[input.nEntry].vecTxDSIn[input.nEntryTxIn].fHasSig || setFinalScriptSigs.count(scriptSig)) {
+            LogPrint(BCLog::COINJOIN, "CCoinJoinServer::%s -- already exists\n", __func__);
+            return false;
         }
     }
+    for (const auto& [input, scriptSig] : vecInputs) {
+        finalMutableTransaction.vin[input.nTxIn].scriptSig = scriptSig;
+        auto& txdsin = vecEntries[input.nEntry].vecTxDSIn[input.nEntryTxIn];
+        txdsin.scriptSig = scriptSig;
+        txdsin.fHasSig = true;
+        setFinalScriptSigs.emplace(scriptSig);
+    }
 
-    LogPrint(BCLog::COINJOIN, "CCoinJoinServer::AddScriptSig -- Couldn't set sig!\n");
-    return false;
+    LogPrint(BCLog::COINJOIN, "CCoinJoinServer::%s -- added %d scriptSigs\n", __func__, vecInputs.size());
+    return true;
 }
 
 // Check to make sure everything is signed
@@ -8,6 +8,9 @@
 #include <coinjoin/coinjoin.h>
 #include <net.h>
 
+#include <map>
+#include <set>
+
 class CCoinJoinServer;
 class UniValue;
 
@@ -25,10 +28,22 @@ private:
 
     bool fUnitTest;
 
+    /// Where a final transaction input lives in the final transaction and in the entries
+    struct CFinalTxInput
+    {
+        size_t nTxIn;
+        size_t nEntry;
+        size_t nEntryTxIn;
+    };
+    /// Inputs of the final transaction by outpoint, built once together with the final transaction
+    std::map<COutPoint, CFinalTxInput> mapFinalTxInputs GUARDED_BY(cs_coinjoin);
+    /// scriptSigs accepted for the final transaction so far
+    std::set<CScript> setFinalScriptSigs GUARDED_BY(cs_coinjoin);
+
     /// Add a clients entry to the pool
     bool AddEntry(CConnman& connman, const CCoinJoinEntry& entry, PoolMessage& nMessageIDRet);
-    /// Add signature to a txin
-    bool AddScriptSig(const CTxIn& txin);
+    /// Verify a batch of signed txins of one client and add their signatures, all or nothing
+    bool AddScriptSigs(const std::vector<CTxIn>& vecTxIn);
 
     /// Charge fees to bad actors (Charge clients a fee if they're abusive)
     void ChargeFees(CConnman& connman) const;
@@ -52,8 +67,6 @@ private:
 
     /// Check that all inputs are signed. (Are all inputs signed?)
     bool IsSignaturesComplete() const;
-    /// Check to make sure a given input matches an input in the pool and its scriptSig is valid
-    bool IsInputScriptSigValid(const CTxIn& txin) const;
 
     // Set the 'state' value, with some logging and capturing when the state changed
     void SetState(PoolState nStateNew);
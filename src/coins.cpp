@@ -230,6 +230,14 @@ void CCoinsViewCache::Uncache(const COutPoint& hash)
     }
 }
 
+void CCoinsViewCache::ForEachDirtyCoin(const std::function<void(const COutPoint&, const Coin&)>& func) const {
+    for (const auto& entry : cacheCoins) {
+        if (entry.second.flags & CCoinsCacheEntry::DIRTY) {
+            func(entry.first, entry.second.coin);
+        }
+    }
+}
+
 unsigned int CCoinsViewCache::GetCacheSize() const {
     return cacheCoins.size();
 }
@@ -316,6 +316,12 @@ public:
      */
     void Uncache(const COutPoint &outpoint);
 
+    /**
+     * Call func for every coin modified in this cache and not yet flushed to the
+     * base view, including spent ones (for which coin.IsSpent() is true).
+     */
+    void ForEachDirtyCoin(const std::function<void(const COutPoint&, const Coin&)>& func) const;
+
     //! Calculate the size of the cache (in number of transaction outputs)
     unsigned int GetCacheSize() const;
 
@@ -12,6 +12,12 @@
 
 uint256 ComputeMerkleRoot(std::vector<uint256> hashes, bool* mutated = nullptr);
 
+/*
+ * Compute all levels of the Merkle tree over the given leaves, from the leaves
+ * themselves (level 0) up to the root. Each level is hashed in a single pass.
+ */
+std::vector<std::vector<uint256>> ComputeMerkleLevels(std::vector<uint256> leaves);
+
 /*
  * Compute the Merkle root of the transactions in a block.
  * *mutated is set to true if a duplicated subtree was found.
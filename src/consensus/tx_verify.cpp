@@ -17,6 +17,8 @@
 #include <coins.h>
 #include <util/moneystr.h>
 
+#include <algorithm>
+
 bool IsFinalTx(const CTransaction &tx, int nBlockHeight, int64_t nBlockTime)
 {
     if (tx.nLockTime == 0)
@@ -130,7 +132,26 @@ unsigned int GetLegacySigOpCount(const CTransaction& tx)
     return nSigOps;
 }
 
+static std::vector<const Coin*> AccessInputCoins(const CTransaction& tx, const CCoinsViewCache& inputs)
+{
+    std::vector<const Coin*> coins;
+    coins.reserve(tx.vin.size());
+    for (const CTxIn& txin : tx.vin) {
+        const Coin& coin = inputs.AccessCoin(txin.prevout);
+        coins.emplace_back(coin.IsSpent() ? nullptr : &coin);
+    }
+    return coins;
+}
+
 unsigned int GetP2SHSigOpCount(const CTransaction& tx, const CCoinsViewCache& inputs)
+{
+    if (tx.IsCoinBase())
+        return 0;
+
+    return GetP2SHSigOpCount(tx, AccessInputCoins(tx, inputs));
+}
+
+unsigned int GetP2SHSigOpCount(const CTransaction& tx, const std::vector<const Coin*>& coins)
 {
     if (tx.IsCoinBase())
         return 0;
@@ -138,9 +159,8 @@ unsigned int GetP2SHSigOpCount(const CTransaction& tx, const CCoinsViewCache& in
     unsigned int nSigOps = 0;
     for (unsigned int i = 0; i < tx.vin.size(); i++)
     {
-        const Coin& coin = inputs.AccessCoin(tx.vin[i].prevout);
-        assert(!coin.IsSpent());
-        const CTxOut &prevout = coin.out;
+        assert(coins[i] != nullptr);
+        const CTxOut &prevout = coins[i]->out;
         if (prevout.scriptPubKey.IsPayToScriptHash())
             nSigOps += prevout.scriptPubKey.GetSigOpCount(tx.vin[i].scriptSig);
     }
@@ -161,19 +181,36 @@ unsigned int GetTransactionSigOpCount(const CTransaction& tx, const CCoinsViewCa
     return nSigOps;
 }
 
+unsigned int GetTransactionSigOpCount(const CTransaction& tx, const std::vector<const Coin*>& coins, int flags)
+{
+    unsigned int nSigOps = GetLegacySigOpCount(tx);
+
+    if (tx.IsCoinBase())
+        return nSigOps;
+
+    if (flags & SCRIPT_VERIFY_P2SH) {
+        nSigOps += GetP2SHSigOpCount(tx, coins);
+    }
+
+    return nSigOps;
+}
+
 bool Consensus::CheckTxInputs(const CTransaction& tx, CValidationState& state, const CCoinsViewCache& inputs, int nSpendHeight, CAmount& txfee)
+{
+    return CheckTxInputs(tx, state, AccessInputCoins(tx, inputs), nSpendHeight, txfee);
+}
+
+bool Consensus::CheckTxInputs(const CTransaction& tx, CValidationState& state, const std::vector<const Coin*>& coins, int nSpendHeight, CAmount& txfee)
 {
     // are the actual inputs available?
-    if (!inputs.HaveInputs(tx)) {
+    if (std::find(coins.begin(), coins.end(), nullptr) != coins.end()) {
         return state.DoS(100, false, REJECT_INVALID, "bad-txns-inputs-missingorspent", false,
                          strprintf("%s: inputs missing/spent", __func__));
     }
 
     CAmount nValueIn = 0;
     for (unsigned int i = 0; i < tx.vin.size(); ++i) {
-        const COutPoint &prevout = tx.vin[i].prevout;
-        const Coin& coin = inputs.AccessCoin(prevout);
-        assert(!coin.IsSpent());
+        const Coin& coin = *coins[i];
 
         // If prev is coinbase, check that it's matured
         if (coin.IsCoinBase() && nSpendHeight - coin.nHeight < COINBASE_MATURITY) {
@@ -12,6 +12,7 @@
 
 class CBlockIndex;
 class CCoinsViewCache;
+class Coin;
 class CTransaction;
 class CValidationState;
 
@@ -25,6 +26,11 @@ namespace Consensus {
  * Preconditions: tx.IsCoinBase() is false.
  */
 bool CheckTxInputs(const CTransaction& tx, CValidationState& state, const CCoinsViewCache& inputs, int nSpendHeight, CAmount& txfee);
+/**
+ * Same as above, against the coins already resolved for every input.
+ * A nullptr entry means the input is missing or spent.
+ */
+bool CheckTxInputs(const CTransaction& tx, CValidationState& state, const std::vector<const Coin*>& coins, int nSpendHeight, CAmount& txfee);
 } // namespace Consensus
 
 /** Auxiliary functions for transaction validation (ideally should not be exposed) */
@@ -44,6 +50,7 @@ unsigned int GetLegacySigOpCount(const CTransaction& tx);
  * @see CTransaction::FetchInputs
  */
 unsigned int GetP2SHSigOpCount(const CTransaction& tx, const CCoinsViewCache& mapInputs);
+unsigned int GetP2SHSigOpCount(const CTransaction& tx, const std::vector<const Coin*>& coins);
 
 /**
  * Count total signature operations for a transaction.
@@ -53,6 +60,7 @@ unsigned int GetP2SHSigOpCount(const CTransaction& tx, const CCoinsViewCache& ma
  * @return Total signature operation count for a tx
  */
 unsigned int GetTransactionSigOpCount(const CTransaction& tx, const CCoinsViewCache& inputs, int flags);
+unsigned int GetTransactionSigOpCount(const CTransaction& tx, const std::vector<const Coin*>& coins, int flags);
 
 /**
  * Check if transaction is final and can be included in a block with the
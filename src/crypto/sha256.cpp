@@ -8,6 +8,8 @@
 #include <assert.h>
 #include <string.h>
 
+#include <vector>
+
 #if defined(__linux__) && defined(ENABLE_ARM_SHANI) && !defined(BUILD_BITCOIN_INTERNAL)
 #include <sys/auxv.h>
 #include <asm/hwcap.h>
@@ -31,11 +33,13 @@ void Transform(uint32_t* s, const unsigned char* chunk, size_t blocks);
 namespace sha256d64_sse41
 {
 void Transform_4way(unsigned char* out, const unsigned char* in);
+void TransformMulti_4way(uint32_t* s, const unsigned char* in);
 }
 
 namespace sha256d64_avx2
 {
 void Transform_8way(unsigned char* out, const unsigned char* in);
+void TransformMulti_8way(uint32_t* s, const unsigned char* in);
 }
 
 namespace sha256d64_x86_shani
@@ -435,6 +439,7 @@ void TransformD64(unsigned char* out, const unsigned char* in)
 
 typedef void (*TransformType)(uint32_t*, const unsigned char*, size_t);
 typedef void (*TransformD64Type)(unsigned char*, const unsigned char*);
+typedef void (*TransformMultiType)(uint32_t*, const unsigned char*);
 
 template<TransformType tr>
 void TransformD64Wrapper(unsigned char* out, const unsigned char* in)
@@ -480,6 +485,8 @@ TransformD64Type TransformD64 = sha256::TransformD64;
 TransformD64Type TransformD64_2way = nullptr;
 TransformD64Type TransformD64_4way = nullptr;
 TransformD64Type TransformD64_8way = nullptr;
+TransformMultiType TransformMulti_4way = nullptr;
+TransformMultiType TransformMulti_8way = nullptr;
 
 bool SelfTest() {
     // Input state (equal to the initial SHA256 state)
@@ -563,6 +570,25 @@ bool SelfTest() {
         if (!std::equal(out, out + 256, result_d64)) return false;
     }
 
+    // Test TransformMulti_4way and TransformMulti_8way, if available. Lane i
+    // continues from the state after i transformations with the (i+1)th block.
+    if (TransformMulti_4way) {
+        uint32_t states[32];
+        for (int i = 0; i < 4; ++i) std::copy(result[i], result[i] + 8, states + 8 * i);
+        TransformMulti_4way(states, data + 1);
+        for (int i = 0; i < 4; ++i) {
+            if (!std::equal(states + 8 * i, states + 8 * i + 8, result[i + 1])) return false;
+        }
+    }
+    if (TransformMulti_8way) {
+        uint32_t states[64];
+        for (int i = 0; i < 8; ++i) std::copy(result[i], result[i] + 8, states + 8 * i);
+        TransformMulti_8way(states, data + 1);
+        for (int i = 0; i < 8; ++i) {
+            if (!std::equal(states + 8 * i, states + 8 * i + 8, result[i + 1])) return false;
+        }
+    }
+
     return true;
 }
 
@@ -641,6 +667,7 @@ std::string SHA256AutoDetect()
 #endif
 #if defined(ENABLE_SSE41) && !defined(BUILD_BITCOIN_INTERNAL)
         TransformD64_4way = sha256d64_sse41::Transform_4way;
+        TransformMulti_4way = sha256d64_sse41::TransformMulti_4way;
         ret += ",sse41(4way)";
 #endif
     }
@@ -648,6 +675,7 @@ std::string SHA256AutoDetect()
 #if defined(ENABLE_AVX2) && !defined(BUILD_BITCOIN_INTERNAL)
     if (have_avx2 && have_avx && enabled_avx) {
         TransformD64_8way = sha256d64_avx2::Transform_8way;
+        TransformMulti_8way = sha256d64_avx2::TransformMulti_8way;
         ret += ",avx2(8way)";
     }
 #endif
@@ -779,3 +807,79 @@ void SHA256D64(unsigned char* out, const unsigned char* in, size_t blocks)
         --blocks;
     }
 }
+
+namespace {
+/** Compute the SHA256 of count messages, keeping one message in each lane of
+ *  the multi-way kernel and refilling a lane as soon as its message is done. */
+void SHA256Multi(unsigned char* out, const unsigned char* const* in, const size_t* len, size_t count)
+{
+    const TransformMultiType transform = TransformMulti_8way ? TransformMulti_8way : TransformMulti_4way;
+    const size_t lanes = TransformMulti_8way ? 8 : 4;
+    if (!transform) {
+        for (size_t i = 0; i < count; ++i) {
+            CSHA256().Write(in[i], len[i]).Finalize(out + 32 * i);
+        }
+        return;
+    }
+
+    struct Lane {
+        size_t msg;
+        size_t block;
+        size_t full_blocks;
+        size_t blocks;
+        unsigned char tail[128]; // padded remainder of the message
+    } lane[8];
+    uint32_t states[64];
+    unsigned char chunk[512] = {};
+    size_t next = 0;
+    size_t active = 0;
+
+    auto fill = [&](size_t l) {
+        Lane& ln = lane[l];
+        if (next == count) {
+            ln.block = ln.blocks = 0;
+            return;
+        }
+        ln.msg = next++;
+        ln.block = 0;
+        ln.full_blocks = len[ln.msg] / 64;
+        const size_t rem = len[ln.msg] % 64;
+        const size_t tail_size = rem < 56 ? 64 : 128;
+        memcpy(ln.tail, in[ln.msg] + 64 * ln.full_blocks, rem);
+        memset(ln.tail + rem, 0, tail_size - rem);
+        ln.tail[rem] = 0x80;
+        WriteBE64(ln.tail + tail_size - 8, uint64_t{len[ln.msg]} << 3);
+        ln.blocks = ln.full_blocks + tail_size / 64;
+        sha256::Initialize(states + 8 * l);
+        ++active;
+    };
+
+    for (size_t l = 0; l < lanes; ++l) fill(l);
+    while (active) {
+        for (size_t l = 0; l < lanes; ++l) {
+            const Lane& ln = lane[l];
+            if (ln.block >= ln.blocks) continue; // idle lane, its output is ignored
+            const unsigned char* src = ln.block < ln.full_blocks ? in[ln.msg] + 64 * ln.block : ln.tail + 64 * (ln.block - ln.full_blocks);
+            memcpy(chunk + 64 * l, src, 64);
+        }
+        transform(states, chunk);
+        for (size_t l = 0; l < lanes; ++l) {
+            Lane& ln = lane[l];
+            if (ln.block >= ln.blocks || ++ln.block < ln.blocks) continue;
+            for (int j = 0; j < 8; ++j) WriteBE32(out + 32 * ln.msg + 4 * j, states[8 * l + j]);
+            --active;
+            fill(l);
+        }
+    }
+}
+} // namespace
+
+void SHA256DMulti(unsigned char* output, const unsigned char* const* inputs, const size_t* lengths, size_t count)
+{
+    std::vector<unsigned char> first(32 * count);
+    SHA256Multi(first.data(), inputs, lengths, count);
+    std::vector<const unsigned char*> digests(count);
+    for (size_t i = 0; i < count; ++i) digests[i] = first.data() + 32 * i;
+    const std::vector<size_t> digest_lengths(count, 32);
+    SHA256Multi(output, digests.data(), digest_lengths.data(), count);
+}
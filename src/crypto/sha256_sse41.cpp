@@ -311,6 +311,65 @@ void Transform_4way(unsigned char* out, const unsigned char* in)
     Write4(out, 28, Add(h, K(0x5be0cd19ul)));
 }
 
+/** Apply one SHA-256 compression to 4 independent states at once.
+ *  s:  4 consecutive 8-word states, updated in place
+ *  in: 4 consecutive 64-byte blocks, one per state
+ */
+void TransformMulti_4way(uint32_t* s, const unsigned char* in)
+{
+    static const uint32_t k[64] = {
+        0x428a2f98ul, 0x71374491ul, 0xb5c0fbcful, 0xe9b5dba5ul, 0x3956c25bul, 0x59f111f1ul, 0x923f82a4ul, 0xab1c5ed5ul,
+        0xd807aa98ul, 0x12835b01ul, 0x243185beul, 0x550c7dc3ul, 0x72be5d74ul, 0x80deb1feul, 0x9bdc06a7ul, 0xc19bf174ul,
+        0xe49b69c1ul, 0xefbe4786ul, 0x0fc19dc6ul, 0x240ca1ccul, 0x2de92c6ful, 0x4a7484aaul, 0x5cb0a9dcul, 0x76f988daul,
+        0x983e5152ul, 0xa831c66dul, 0xb00327c8ul, 0xbf597fc7ul, 0xc6e00bf3ul, 0xd5a79147ul, 0x06ca6351ul, 0x14292967ul,
+        0x27b70a85ul, 0x2e1b2138ul, 0x4d2c6dfcul, 0x53380d13ul, 0x650a7354ul, 0x766a0abbul, 0x81c2c92eul, 0x92722c85ul,
+        0xa2bfe8a1ul, 0xa81a664bul, 0xc24b8b70ul, 0xc76c51a3ul, 0xd192e819ul, 0xd6990624ul, 0xf40e3585ul, 0x106aa070ul,
+        0x19a4c116ul, 0x1e376c08ul, 0x2748774cul, 0x34b0bcb5ul, 0x391c0cb3ul, 0x4ed8aa4aul, 0x5b9cca4ful, 0x682e6ff3ul,
+        0x748f82eeul, 0x78a5636ful, 0x84c87814ul, 0x8cc70208ul, 0x90befffaul, 0xa4506cebul, 0xbef9a3f7ul, 0xc67178f2ul
+    };
+
+    __m128i a = _mm_set_epi32(s[0], s[8], s[16], s[24]);
+    __m128i b = _mm_set_epi32(s[1], s[9], s[17], s[25]);
+    __m128i c = _mm_set_epi32(s[2], s[10], s[18], s[26]);
+    __m128i d = _mm_set_epi32(s[3], s[11], s[19], s[27]);
+    __m128i e = _mm_set_epi32(s[4], s[12], s[20], s[28]);
+    __m128i f = _mm_set_epi32(s[5], s[13], s[21], s[29]);
+    __m128i g = _mm_set_epi32(s[6], s[14], s[22], s[30]);
+    __m128i h = _mm_set_epi32(s[7], s[15], s[23], s[31]);
+
+    __m128i w[64];
+    for (int i = 0; i < 16; ++i) w[i] = Read4(in, 4 * i);
+    for (int i = 16; i < 64; ++i) w[i] = Add(sigma1(w[i - 2]), w[i - 7], sigma0(w[i - 15]), w[i - 16]);
+
+    for (int i = 0; i < 64; i += 8) {
+        Round(a, b, c, d, e, f, g, h, Add(K(k[i + 0]), w[i + 0]));
+        Round(h, a, b, c, d, e, f, g, Add(K(k[i + 1]), w[i + 1]));
+        Round(g, h, a, b, c, d, e, f, Add(K(k[i + 2]), w[i + 2]));
+        Round(f, g, h, a, b, c, d, e, Add(K(k[i + 3]), w[i + 3]));
+        Round(e, f, g, h, a, b, c, d, Add(K(k[i + 4]), w[i + 4]));
+        Round(d, e, f, g, h, a, b, c, Add(K(k[i + 5]), w[i + 5]));
+        Round(c, d, e, f, g, h, a, b, Add(K(k[i + 6]), w[i + 6]));
+        Round(b, c, d, e, f, g, h, a, Add(K(k[i + 7]), w[i + 7]));
+    }
+
+    a = Add(a, _mm_set_epi32(s[0], s[8], s[16], s[24]));
+    b = Add(b, _mm_set_epi32(s[1], s[9], s[17], s[25]));
+    c = Add(c, _mm_set_epi32(s[2], s[10], s[18], s[26]));
+    d = Add(d, _mm_set_epi32(s[3], s[11], s[19], s[27]));
+    e = Add(e, _mm_set_epi32(s[4], s[12], s[20], s[28]));
+    f = Add(f, _mm_set_epi32(s[5], s[13], s[21], s[29]));
+    g = Add(g, _mm_set_epi32(s[6], s[14], s[22], s[30]));
+    h = Add(h, _mm_set_epi32(s[7], s[15], s[23], s[31]));
+    s[0] = _mm_extract_epi32(a, 3); s[8] = _mm_extract_epi32(a, 2); s[16] = _mm_extract_epi32(a, 1); s[24] = _mm_extract_epi32(a, 0);
+    s[1] = _mm_extract_epi32(b, 3); s[9] = _mm_extract_epi32(b, 2); s[17] = _mm_extract_epi32(b, 1); s[25] = _mm_extract_epi32(b, 0);
+    s[2] = _mm_extract_epi32(c, 3); s[10] = _mm_extract_epi32(c, 2); s[18] = _mm_extract_epi32(c, 1); s[26] = _mm_extract_epi32(c, 0);
+    s[3] = _mm_extract_epi32(d, 3); s[11] = _mm_extract_epi32(d, 2); s[19] = _mm_extract_epi32(d, 1); s[27] = _mm_extract_epi32(d, 0);
+    s[4] = _mm_extract_epi32(e, 3); s[12] = _mm_extract_epi32(e, 2); s[20] = _mm_extract_epi32(e, 1); s[28] = _mm_extract_epi32(e, 0);
+    s[5] = _mm_extract_epi32(f, 3); s[13] = _mm_extract_epi32(f, 2); s[21] = _mm_extract_epi32(f, 1); s[29] = _mm_extract_epi32(f, 0);
+    s[6] = _mm_extract_epi32(g, 3); s[14] = _mm_extract_epi32(g, 2); s[22] = _mm_extract_epi32(g, 1); s[30] = _mm_extract_epi32(g, 0);
+    s[7] = _mm_extract_epi32(h, 3); s[15] = _mm_extract_epi32(h, 2); s[23] = _mm_extract_epi32(h, 1); s[31] = _mm_extract_epi32(h, 0);
+}
+
 }
 
 #endif
@@ -233,6 +233,21 @@ bool CDBWrapper::IsEmpty()
     return !(it->Valid());
 }
 
+std::shared_ptr<const leveldb::Snapshot> CDBWrapper::GetSnapshot() const
+{
+    leveldb::DB* db = pdb;
+    return std::shared_ptr<const leveldb::Snapshot>(pdb->GetSnapshot(), [db](const leveldb::Snapshot* snapshot) {
+        db->ReleaseSnapshot(snapshot);
+    });
+}
+
+CDBIterator* CDBWrapper::NewIterator(std::shared_ptr<const leveldb::Snapshot> snapshot) const
+{
+    leveldb::ReadOptions options = iteroptions;
+    options.snapshot = snapshot.get();
+    return new CDBIterator(*this, pdb->NewIterator(options), std::move(snapshot));
+}
+
 CDBIterator::~CDBIterator() { delete piter; }
 bool CDBIterator::Valid() const { return piter->Valid(); }
 void CDBIterator::SeekToFirst() { piter->SeekToFirst(); }
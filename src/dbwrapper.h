@@ -12,6 +12,7 @@
 #include <util/system.h>
 #include <util/strencodings.h>
 
+#include <memory>
 #include <typeindex>
 
 #include <leveldb/db.h>
@@ -127,15 +128,18 @@ class CDBIterator
 private:
     const CDBWrapper &parent;
     leveldb::Iterator *piter;
+    //! the snapshot the iterator reads from, kept alive until the iterator is gone
+    std::shared_ptr<const leveldb::Snapshot> snapshot;
 
 public:
 
     /**
      * @param[in] _parent          Parent CDBWrapper instance.
      * @param[in] _piter           The original leveldb iterator.
+     * @param[in] _snapshot        The snapshot _piter was created on, if any.
      */
-    CDBIterator(const CDBWrapper &_parent, leveldb::Iterator *_piter) :
-        parent(_parent), piter(_piter) { };
+    CDBIterator(const CDBWrapper &_parent, leveldb::Iterator *_piter, std::shared_ptr<const leveldb::Snapshot> _snapshot = nullptr) :
+        parent(_parent), piter(_piter), snapshot(std::move(_snapshot)) { };
     ~CDBIterator();
 
     bool Valid() const;
@@ -349,6 +353,15 @@ public:
         return new CDBIterator(*this, pdb->NewIterator(iteroptions));
     }
 
+    /**
+     * Take a consistent, read-only snapshot of the database. Writes done after
+     * this call are not visible to iterators created on the snapshot.
+     */
+    std::shared_ptr<const leveldb::Snapshot> GetSnapshot() const;
+
+    //! Iterate over the database as it was when the snapshot was taken
+    CDBIterator *NewIterator(std::shared_ptr<const leveldb::Snapshot> snapshot) const;
+
     /**
      * Return true if the database managed by this class contains no entries.
      */
@@ -50,6 +50,7 @@ void DummyWalletInit::AddWalletOptions() const
         "-walletbackupsdir=<dir>",
         "-walletbroadcast",
         "-walletdir=<dir>",
+        "-walletformat=<format>",
         "-walletnotify=<cmd>",
         "-zapwallettxes=<mode>",
         "-discardfee=<amt>",
@@ -176,21 +176,30 @@ bool CalcCbTxMerkleRootQuorums(const CBlock& block, const CBlockIndex* pindexPre
     int64_t nTime2 = GetTimeMicros(); nTimeMinedAndActive += nTime2 - nTime1;
     LogPrint(BCLog::BENCHMARK, "            - GetMinedAndActiveCommitmentsUntilBlock: %.2fms [%.2fs]\n", 0.001 * (nTime2 - nTime1), nTimeMinedAndActive * 0.000001);
 
+    std::vector<std::pair<Consensus::LLMQType, llmq::CFinalCommitmentPtr>> minedQcs;
+    CBatchHashWriter hw(SER_GETHASH, PROTOCOL_VERSION);
     for (const auto& p : quorums) {
-        auto& v = qcHashes[p.first];
-        v.reserve(p.second.size());
+        qcHashes[p.first].reserve(p.second.size());
         for (const auto& p2 : p.second) {
             uint256 minedBlockHash;
             llmq::CFinalCommitmentPtr qc = llmq::quorumBlockProcessor->GetMinedCommitment(p.first, p2->GetBlockHash(), minedBlockHash);
             if (qc == nullptr) return state.DoS(100, false, REJECT_INVALID, "commitment-not-found");
-            if (llmq::CLLMQUtils::IsQuorumRotationEnabled(qc->llmqType, pindexPrev)) {
-                auto& qi = qcIndexedHashes[p.first];
-                qi.insert(std::make_pair(qc->quorumIndex, ::SerializeHash(*qc)));
-                continue;
-            }
-            v.emplace_back(::SerializeHash(*qc));
-            hashCount++;
+            hw.Add(*qc);
+            minedQcs.emplace_back(p.first, std::move(qc));
+        }
+    }
+
+    // hash all mined commitments at once and distribute the hashes in the original order
+    const std::vector<uint256> minedQcHashes = hw.GetHashes();
+    for (size_t i = 0; i < minedQcs.size(); i++) {
+        const auto& [llmqType, qc] = minedQcs[i];
+        if (llmq::CLLMQUtils::IsQuorumRotationEnabled(qc->llmqType, pindexPrev)) {
+            auto& qi = qcIndexedHashes[llmqType];
+            qi.insert(std::make_pair(qc->quorumIndex, minedQcHashes[i]));
+            continue;
         }
+        qcHashes[llmqType].emplace_back(minedQcHashes[i]);
+        hashCount++;
     }
 
 
@@ -441,6 +441,7 @@ void CDeterministicMNList::AddMN(const CDeterministicMNCPtr& dmn, bool fBumpTota
 
     mnMap = mnMap.set(dmn->proTxHash, dmn);
     mnInternalIdMap = mnInternalIdMap.set(dmn->GetInternalId(), dmn->proTxHash);
+    UpdateSideIndexes(*dmn);
     if (fBumpTotalCount) {
         // nTotalRegisteredCount acts more like a checkpoint, not as a limit,
         nTotalRegisteredCount = std::max(dmn->GetInternalId() + 1, (uint64_t)nTotalRegisteredCount);
@@ -474,6 +475,7 @@ void CDeterministicMNList::UpdateMN(const CDeterministicMN& oldDmn, const std::s
     }
 
     mnMap = mnMap.set(oldDmn.proTxHash, dmn);
+    UpdateSideIndexes(*dmn);
 }
 
 void CDeterministicMNList::UpdateMN(const uint256& proTxHash, const std::shared_ptr<const CDeterministicMNState>& pdmnState)
@@ -527,6 +529,36 @@ void CDeterministicMNList::RemoveMN(const uint256& proTxHash)
 
     mnMap = mnMap.erase(proTxHash);
     mnInternalIdMap = mnInternalIdMap.erase(dmn->GetInternalId());
+    EraseSideIndexes(proTxHash);
+}
+
+void CDeterministicMNList::UpdateSideIndexes(const CDeterministicMN& dmn)
+{
+    const auto& state = *dmn.pdmnState;
+
+    auto p = mnUnconfirmedMap.find(dmn.proTxHash);
+    if (!state.confirmedHash.IsNull()) {
+        if (p) mnUnconfirmedMap = mnUnconfirmedMap.erase(dmn.proTxHash);
+    } else if (!p || *p != state.nRegisteredHeight) {
+        mnUnconfirmedMap = mnUnconfirmedMap.set(dmn.proTxHash, state.nRegisteredHeight);
+    }
+
+    p = mnPoSePenaltyMap.find(dmn.proTxHash);
+    if (state.nPoSePenalty <= 0 || state.IsBanned()) {
+        if (p) mnPoSePenaltyMap = mnPoSePenaltyMap.erase(dmn.proTxHash);
+    } else if (!p || *p != state.nPoSePenalty) {
+        mnPoSePenaltyMap = mnPoSePenaltyMap.set(dmn.proTxHash, state.nPoSePenalty);
+    }
+}
+
+void CDeterministicMNList::EraseSideIndexes(const uint256& proTxHash)
+{
+    if (mnUnconfirmedMap.count(proTxHash)) {
+        mnUnconfirmedMap = mnUnconfirmedMap.erase(proTxHash);
+    }
+    if (mnPoSePenaltyMap.count(proTxHash)) {
+        mnPoSePenaltyMap = mnPoSePenaltyMap.erase(proTxHash);
+    }
 }
 
 bool CDeterministicMNManager::ProcessBlock(const CBlock& block, const CBlockIndex* pindex, CValidationState& _state, const CCoinsViewCache& view, bool fJustCheck)
@@ -658,11 +690,7 @@ bool CDeterministicMNManager::BuildNewListFromBlock(const CBlock& block, const C
     // we iterate the oldList here and update the newList
     // this is only valid as long these have not diverged at this point, which is the case as long as we don't add
     // code above this loop that modifies newList
-    oldList.ForEachMN(false, [&](auto& dmn) {
-        if (!dmn.pdmnState->confirmedHash.IsNull()) {
-            // already confirmed
-            return;
-        }
+    oldList.ForEachUnconfirmedMN([&](auto& dmn) {
         // this works on the previous block, so confirmation will happen one block after nMasternodeMinimumConfirmations
         // has been reached, but the block hash will then point to the block at nMasternodeMinimumConfirmations
         int nConfirmations = pindexPrev->nHeight - dmn.pdmnState->nRegisteredHeight;
@@ -907,14 +935,11 @@ void CDeterministicMNManager::HandleQuorumCommitment(const llmq::CFinalCommitmen
 void CDeterministicMNManager::DecreasePoSePenalties(CDeterministicMNList& mnList)
 {
     std::vector<uint256> toDecrease;
-    toDecrease.reserve(mnList.GetAllMNsCount() / 10);
     // only iterate and decrease for valid ones (not PoSe banned yet)
     // if a MN ever reaches the maximum, it stays in PoSe banned state until revived
-    mnList.ForEachMN(true /* onlyValid */, [&](auto& dmn) {
-        // There is no reason to check if this MN is banned here since onlyValid=true will only run on non-banned MNs
-        if (dmn.pdmnState->nPoSePenalty > 0) {
-            toDecrease.emplace_back(dmn.proTxHash);
-        }
+    // the list keeps track of these, they are collected first as the list can't be modified while iterating it
+    mnList.ForEachPoSePenalizedMN([&](auto& dmn) {
+        toDecrease.emplace_back(dmn.proTxHash);
     });
 
     for (const auto& proTxHash : toDecrease) {
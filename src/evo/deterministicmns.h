@@ -143,6 +143,7 @@ public:
     using MnMap = immer::map<uint256, CDeterministicMNCPtr, ImmerHasher>;
     using MnInternalIdMap = immer::map<uint64_t, uint256>;
     using MnUniquePropertyMap = immer::map<uint256, std::pair<uint256, uint32_t>, ImmerHasher>;
+    using MnHeightMap = immer::map<uint256, int, ImmerHasher>;
 
 private:
     uint256 blockHash;
@@ -155,6 +156,12 @@ private:
     // we keep track of this as checking for duplicates would otherwise be painfully slow
     MnUniquePropertyMap mnUniquePropertyMap;
 
+    // side indexes for per-block list maintenance, so it doesn't need to iterate the whole list
+    // MNs without a confirmed hash yet, mapped to their registered height
+    MnHeightMap mnUnconfirmedMap;
+    // non-banned MNs with a PoSe penalty above zero, mapped to their penalty
+    MnHeightMap mnPoSePenaltyMap;
+
 public:
     CDeterministicMNList() = default;
     explicit CDeterministicMNList(const uint256& _blockHash, int _height, uint32_t _totalRegisteredCount) :
@@ -188,6 +195,8 @@ public:
         mnMap = MnMap();
         mnUniquePropertyMap = MnUniquePropertyMap();
         mnInternalIdMap = MnInternalIdMap();
+        mnUnconfirmedMap = MnHeightMap();
+        mnPoSePenaltyMap = MnHeightMap();
 
         SerializationOpBase(s, CSerActionUnserialize());
 
@@ -240,6 +249,32 @@ public:
         }
     }
 
+    /**
+     * Execute a callback on all masternodes which don't have a confirmed hash yet. Only visits
+     * these, so it is cheap even on large lists.
+     * @param cb callback to execute
+     */
+    template <typename Callback>
+    void ForEachUnconfirmedMN(Callback&& cb) const
+    {
+        for (const auto& p : mnUnconfirmedMap) {
+            cb(**mnMap.find(p.first));
+        }
+    }
+
+    /**
+     * Execute a callback on all valid (not banned) masternodes with a PoSe penalty above zero. Only
+     * visits these, so it is cheap even on large lists.
+     * @param cb callback to execute
+     */
+    template <typename Callback>
+    void ForEachPoSePenalizedMN(Callback&& cb) const
+    {
+        for (const auto& p : mnPoSePenaltyMap) {
+            cb(**mnMap.find(p.first));
+        }
+    }
+
     const uint256& GetBlockHash() const
     {
         return blockHash;
@@ -363,6 +398,9 @@ public:
     }
 
 private:
+    void UpdateSideIndexes(const CDeterministicMN& dmn);
+    void EraseSideIndexes(const uint256& proTxHash);
+
     template <typename T>
     [[nodiscard]] bool AddUniqueProperty(const CDeterministicMN& dmn, const T& v)
     {
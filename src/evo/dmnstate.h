@@ -7,6 +7,7 @@
 
 #include <crypto/common.h>
 #include <bls/bls.h>
+#include <bls/bls_pubkeystore.h>
 #include <pubkey.h>
 #include <netaddress.h>
 #include <script/script.h>
@@ -46,7 +47,7 @@ public:
     uint256 confirmedHashWithProRegTxHash;
 
     CKeyID keyIDOwner;
-    CBLSLazyPublicKey pubKeyOperator;
+    CBLSInternedPublicKey pubKeyOperator;
     CKeyID keyIDVoting;
     CService addr;
     CScript scriptPayout;
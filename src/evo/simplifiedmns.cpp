@@ -85,12 +85,12 @@ CSimplifiedMNList::CSimplifiedMNList(const CDeterministicMNList& dmnList)
 
 uint256 CSimplifiedMNList::CalcMerkleRoot(bool* pmutated) const
 {
-    std::vector<uint256> leaves;
-    leaves.reserve(mnList.size());
+    // same as CSimplifiedMNListEntry::CalcHash, but all entries are hashed at once
+    CBatchHashWriter hw(SER_GETHASH, CLIENT_VERSION);
     for (const auto& e : mnList) {
-        leaves.emplace_back(e->CalcHash());
+        hw.Add(*e);
     }
-    return ComputeMerkleRoot(leaves, pmutated);
+    return ComputeMerkleRoot(hw.GetHashes(), pmutated);
 }
 
 CSimplifiedMNListDiff::CSimplifiedMNListDiff() = default;
@@ -6,6 +6,7 @@
 #define BITCOIN_EVO_SIMPLIFIEDMNS_H
 
 #include <bls/bls.h>
+#include <bls/bls_pubkeystore.h>
 #include <merkleblock.h>
 #include <netaddress.h>
 #include <pubkey.h>
@@ -26,7 +27,7 @@ public:
     uint256 proRegTxHash;
     uint256 confirmedHash;
     CService service;
-    CBLSLazyPublicKey pubKeyOperator;
+    CBLSInternedPublicKey pubKeyOperator;
     CKeyID keyIDVoting;
     bool isValid;
 
@@ -75,6 +75,19 @@ void BIP32Hash(const ChainCode &chainCode, unsigned int nChild, unsigned char he
     CHMAC_SHA512(chainCode.begin(), chainCode.size()).Write(&header, 1).Write(data, 32).Write(num, 4).Finalize(output);
 }
 
+std::vector<uint256> CBatchHashWriter::GetHashes() const
+{
+    std::vector<const unsigned char*> inputs(offsets.size());
+    std::vector<size_t> lengths(offsets.size());
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        inputs[i] = data.data() + offsets[i];
+        lengths[i] = (i + 1 < offsets.size() ? offsets[i + 1] : data.size()) - offsets[i];
+    }
+    std::vector<uint256> hashes(offsets.size());
+    SHA256DMulti(hashes.empty() ? nullptr : hashes[0].begin(), inputs.data(), lengths.data(), offsets.size());
+    return hashes;
+}
+
 uint256 SHA256Uint256(const uint256& input)
 {
     uint256 result;
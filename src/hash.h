@@ -264,6 +264,47 @@ public:
     }
 };
 
+/** Collects the serializations of many objects and computes all of their
+ *  256-bit hashes at once, see SHA256DMulti. */
+class CBatchHashWriter
+{
+private:
+    std::vector<unsigned char> data;
+    std::vector<size_t> offsets;
+
+    const int nType;
+    const int nVersion;
+public:
+
+    CBatchHashWriter(int nTypeIn, int nVersionIn) : nType(nTypeIn), nVersion(nVersionIn) {}
+
+    int GetType() const { return nType; }
+    int GetVersion() const { return nVersion; }
+
+    void write(const char *pch, size_t size) {
+        data.insert(data.end(), (const unsigned char*)pch, (const unsigned char*)pch + size);
+    }
+
+    /** Serialize obj as the next message to be hashed */
+    template<typename T>
+    void Add(const T& obj) {
+        offsets.push_back(data.size());
+        ::Serialize(*this, obj);
+    }
+
+    /** Append obj to the message started by the last Add */
+    template<typename T>
+    CBatchHashWriter& operator<<(const T& obj) {
+        ::Serialize(*this, obj);
+        return (*this);
+    }
+
+    size_t size() const { return offsets.size(); }
+
+    /** Compute the double-SHA256 hashes of all added objects, in the order they were added */
+    std::vector<uint256> GetHashes() const;
+};
+
 /** Compute the 256-bit hash of an object's serialization. */
 template<typename T>
 uint256 SerializeHash(const T& obj, int nType=SER_GETHASH, int nVersion=PROTOCOL_VERSION)
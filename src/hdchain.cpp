@@ -160,6 +160,14 @@ uint256 CHDChain::GetSeedHash()
 }
 
 void CHDChain::DeriveChildExtKey(uint32_t nAccountIndex, bool fInternal, uint32_t nChildIndex, CExtKey& extKeyRet, CKeyMetadata& metadata)
+{
+    CExtKey changeKey;
+    CKeyID masterId;
+    DeriveChangeExtKey(nAccountIndex, fInternal, changeKey, masterId);
+    DeriveChildExtKey(changeKey, masterId, nAccountIndex, fInternal, nChildIndex, extKeyRet, metadata);
+}
+
+void CHDChain::DeriveChangeExtKey(uint32_t nAccountIndex, bool fInternal, CExtKey& changeKeyRet, CKeyID& masterIdRet)
 {
     LOCK(cs);
     // Use BIP44 keypath scheme i.e. m / purpose' / coin_type' / account' / change / address_index
@@ -167,8 +175,6 @@ void CHDChain::DeriveChildExtKey(uint32_t nAccountIndex, bool fInternal, uint32_
     CExtKey purposeKey;             //key at m/purpose'
     CExtKey cointypeKey;            //key at m/purpose'/coin_type'
     CExtKey accountKey;             //key at m/purpose'/coin_type'/account'
-    CExtKey changeKey;              //key at m/purpose'/coin_type'/account'/change
-    CExtKey childKey;               //key at m/purpose'/coin_type'/account'/change/address_index
 
     masterKey.SetSeed(vchSeed.data(), vchSeed.size());
 
@@ -182,7 +188,13 @@ void CHDChain::DeriveChildExtKey(uint32_t nAccountIndex, bool fInternal, uint32_
     // derive m/purpose'/coin_type'/account'
     cointypeKey.Derive(accountKey, nAccountIndex | 0x80000000);
     // derive m/purpose'/coin_type'/account'/change
-    accountKey.Derive(changeKey, fInternal ? 1 : 0);
+    accountKey.Derive(changeKeyRet, fInternal ? 1 : 0);
+
+    masterIdRet = masterKey.key.GetPubKey().GetID();
+}
+
+void CHDChain::DeriveChildExtKey(const CExtKey& changeKey, const CKeyID& masterId, uint32_t nAccountIndex, bool fInternal, uint32_t nChildIndex, CExtKey& extKeyRet, CKeyMetadata& metadata)
+{
     // derive m/purpose'/coin_type'/account'/change/address_index
     changeKey.Derive(extKeyRet, nChildIndex);
 
@@ -196,8 +208,7 @@ void CHDChain::DeriveChildExtKey(uint32_t nAccountIndex, bool fInternal, uint32_
     metadata.key_origin.path.push_back(fInternal ? 1 : 0);
     metadata.key_origin.path.push_back(nChildIndex);
 
-    CKeyID master_id = masterKey.key.GetPubKey().GetID();
-    std::copy(master_id.begin(), master_id.begin() + 4, metadata.key_origin.fingerprint);
+    std::copy(masterId.begin(), masterId.begin() + 4, metadata.key_origin.fingerprint);
     metadata.has_key_origin = true;
 #endif
 }
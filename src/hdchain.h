@@ -111,6 +111,10 @@ public:
 
     uint256 GetSeedHash();
     void DeriveChildExtKey(uint32_t nAccountIndex, bool fInternal, uint32_t nChildIndex, CExtKey& extKeyRet, CKeyMetadata& metadata);
+    /** Derive m/purpose'/coin_type'/account'/change, the parent of all keys of one chain of an account, and the ID of the master key */
+    void DeriveChangeExtKey(uint32_t nAccountIndex, bool fInternal, CExtKey& changeKeyRet, CKeyID& masterIdRet);
+    /** Derive the key at nChildIndex from the parent returned by DeriveChangeExtKey, doesn't need the seed */
+    static void DeriveChildExtKey(const CExtKey& changeKey, const CKeyID& masterId, uint32_t nAccountIndex, bool fInternal, uint32_t nChildIndex, CExtKey& extKeyRet, CKeyMetadata& metadata);
 
     void AddAccount();
     bool GetAccount(uint32_t nAccountIndex, CHDAccount& hdAccountRet);
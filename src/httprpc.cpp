@@ -7,6 +7,7 @@
 #include <chainparams.h>
 #include <crypto/hmac_sha256.h>
 #include <httpserver.h>
+#include <rpc/jsonstream.h>
 #include <rpc/protocol.h>
 #include <rpc/server.h>
 #include <ui_interface.h>
@@ -80,6 +81,8 @@ static void JSONErrorReply(HTTPRequest* req, const UniValue& objError, const Uni
 
     std::string strReply = JSONRPCReply(NullUniValue, objError, id);
 
+    // Drop the part of the result which might already have been streamed
+    req->ClearReplyBody();
     req->WriteHeader("Content-Type", "application/json");
     req->WriteReply(nStatus, strReply);
 }
@@ -189,10 +192,21 @@ static bool HTTPReq_JSONRPC(HTTPRequest* req, const std::string &)
         if (valRequest.isObject()) {
             jreq.parse(valRequest);
 
+            // Write the reply in the same format as JSONRPCReply. Methods which support it stream their result
+            // into the reply directly, see StreamRPCResult.
+            JSONStreamWriter writer([req](const char* data, size_t size) { req->WriteReplyBody(data, size); });
+            writer.BeginObject();
+            writer.Key("result");
+            jreq.streamWriter = &writer;
             UniValue result = tableRPC.execute(jreq);
-
-            // Send reply
-            strReply = JSONRPCReply(result, NullUniValue, jreq.id);
+            if (writer.IsValuePending()) {
+                writer.Value(result);
+            }
+            writer.KV("error", NullUniValue);
+            writer.KV("id", jreq.id);
+            writer.EndObject();
+            writer.Flush();
+            strReply = "\n";
 
         // array of requests
         } else if (valRequest.isArray())
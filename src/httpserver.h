@@ -104,6 +104,17 @@ public:
      */
     void WriteHeader(const std::string& hdr, const std::string& value);
 
+    /**
+     * Append to the body of the reply, ahead of the strReply passed to WriteReply. Allows writing large
+     * replies in pieces instead of building them in a single string.
+     */
+    void WriteReplyBody(const char* data, size_t size);
+
+    /**
+     * Drop everything written with WriteReplyBody.
+     */
+    void ClearReplyBody();
+
     /**
      * Write HTTP reply.
      * nStatus is the HTTP status code to send.
@@ -2,6 +2,8 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include <cstdio>
+#include <iterator>
 #include <map>
 
 #include <dbwrapper.h>
@@ -128,6 +130,18 @@ bool BlockFilterIndex::Init()
         m_next_filter_pos.nFile = 0;
         m_next_filter_pos.nPos = 0;
     }
+
+    {
+        // Load the checkpoint headers. Entries above the best block of the index might be left over
+        // from a reorg, which is fine as all lookups compare the block hash.
+        LOCK(m_cs_recent);
+        m_checkpoints.clear();
+        std::pair<uint256, DBVal> value;
+        for (int height = CFCHECKPT_INTERVAL; m_db->Read(DBHeightKey(height), value); height += CFCHECKPT_INTERVAL) {
+            m_checkpoints.emplace_back(value.first, value.second.header);
+        }
+    }
+
     return BaseIndex::Init();
 }
 
@@ -168,6 +182,39 @@ bool BlockFilterIndex::ReadFilterFromDisk(const FlatFilePos& pos, BlockFilter& f
     return true;
 }
 
+bool BlockFilterIndex::ReadEncodedFiltersFromDisk(const std::vector<FlatFilePos>& positions,
+                                                  std::vector<EncodedBlockFilter>& filters_out) const
+{
+    filters_out.resize(positions.size());
+
+    std::unique_ptr<CAutoFile> filein;
+    int current_file{-1};
+    for (size_t i = 0; i < positions.size(); ++i) {
+        const FlatFilePos& pos = positions[i];
+        if (pos.nFile != current_file || !filein) {
+            filein = MakeUnique<CAutoFile>(m_filter_fileseq->Open(pos, true), SER_DISK, CLIENT_VERSION);
+            if (filein->IsNull()) {
+                return false;
+            }
+            current_file = pos.nFile;
+        } else if (std::ftell(filein->Get()) != (long)pos.nPos) {
+            // Filters of consecutive heights are usually stored back to back, only seek if they aren't
+            if (std::fseek(filein->Get(), pos.nPos, SEEK_SET)) {
+                return error("%s: fseek to %s failed", __func__, pos.ToString());
+            }
+        }
+
+        try {
+            *filein >> filters_out[i].block_hash >> filters_out[i].encoded_filter;
+        }
+        catch (const std::exception& e) {
+            return error("%s: Failed to deserialize block filter from disk: %s", __func__, e.what());
+        }
+    }
+
+    return true;
+}
+
 size_t BlockFilterIndex::WriteFilterToDisk(FlatFilePos& pos, const BlockFilter& filter)
 {
     assert(filter.GetFilterType() == GetFilterType());
@@ -254,9 +301,68 @@ bool BlockFilterIndex::WriteBlock(const CBlock& block, const CBlockIndex* pindex
     }
 
     m_next_filter_pos.nPos += bytes_written;
+
+    AddRecentFilter(pindex, filter, value.second.header);
     return true;
 }
 
+void BlockFilterIndex::AddRecentFilter(const CBlockIndex* pindex, const BlockFilter& filter, const uint256& header)
+{
+    LOCK(m_cs_recent);
+
+    // Blocks are indexed in chain order, anything else means we are syncing a different chain
+    // than the one cached and have to start over.
+    const bool extends_recent = !m_recent_filters.empty() &&
+        m_recent_start_height + (int)m_recent_filters.size() == pindex->nHeight &&
+        m_recent_filters.back().block_hash == pindex->pprev->GetBlockHash();
+    if (!extends_recent) {
+        m_recent_filters.clear();
+        m_recent_start_height = pindex->nHeight;
+    }
+    m_recent_filters.push_back({pindex->GetBlockHash(), filter.GetHash(), header, filter.GetEncodedFilter()});
+    while (m_recent_filters.size() > (size_t)RECENT_FILTERS_CACHE_SIZE) {
+        m_recent_filters.pop_front();
+        m_recent_start_height++;
+    }
+
+    if (pindex->nHeight > 0 && pindex->nHeight % CFCHECKPT_INTERVAL == 0) {
+        size_t i = pindex->nHeight / CFCHECKPT_INTERVAL - 1;
+        if (i < m_checkpoints.size()) {
+            m_checkpoints[i] = std::make_pair(pindex->GetBlockHash(), header);
+        } else if (i == m_checkpoints.size()) {
+            m_checkpoints.emplace_back(pindex->GetBlockHash(), header);
+        }
+    }
+}
+
+int BlockFilterIndex::GetFirstRecentHeight(int start_height, const CBlockIndex* stop_index) const
+{
+    AssertLockHeld(m_cs_recent);
+
+    // The cache is a single chain, so if it contains stop_index it also contains all of its
+    // ancestors down to m_recent_start_height.
+    const RecentFilter* stop_entry = GetRecentFilter(stop_index);
+    if (stop_entry == nullptr) {
+        return stop_index->nHeight + 1;
+    }
+    return std::max(start_height, m_recent_start_height);
+}
+
+const BlockFilterIndex::RecentFilter* BlockFilterIndex::GetRecentFilter(const CBlockIndex* block_index) const
+{
+    AssertLockHeld(m_cs_recent);
+
+    if (block_index->nHeight < m_recent_start_height ||
+        block_index->nHeight >= m_recent_start_height + (int)m_recent_filters.size()) {
+        return nullptr;
+    }
+    const RecentFilter& entry = m_recent_filters[block_index->nHeight - m_recent_start_height];
+    if (entry.block_hash != block_index->GetBlockHash()) {
+        return nullptr;
+    }
+    return &entry;
+}
+
 static bool CopyHeightIndexToHashIndex(CDBIterator& db_it, CDBBatch& batch,
                                        const std::string& index_name,
                                        int start_height, int stop_height)
@@ -303,6 +409,15 @@ bool BlockFilterIndex::Rewind(const CBlockIndex* current_tip, const CBlockIndex*
     batch.Write(DB_FILTER_POS, m_next_filter_pos);
     if (!m_db->WriteBatch(batch)) return false;
 
+    {
+        LOCK(m_cs_recent);
+        while (!m_recent_filters.empty() &&
+               m_recent_start_height + (int)m_recent_filters.size() - 1 > new_tip->nHeight) {
+            m_recent_filters.pop_back();
+        }
+        m_checkpoints.resize(std::min(m_checkpoints.size(), (size_t)(new_tip->nHeight / CFCHECKPT_INTERVAL)));
+    }
+
     return BaseIndex::Rewind(current_tip, new_tip);
 }
 
@@ -381,6 +496,15 @@ static bool LookupRange(CDBWrapper& db, const std::string& index_name, int start
 
 bool BlockFilterIndex::LookupFilter(const CBlockIndex* block_index, BlockFilter& filter_out) const
 {
+    {
+        LOCK(m_cs_recent);
+        const RecentFilter* recent = GetRecentFilter(block_index);
+        if (recent != nullptr) {
+            filter_out = BlockFilter(GetFilterType(), recent->block_hash, recent->encoded_filter);
+            return true;
+        }
+    }
+
     DBVal entry;
     if (!LookupOne(*m_db, block_index, entry)) {
         return false;
@@ -391,6 +515,15 @@ bool BlockFilterIndex::LookupFilter(const CBlockIndex* block_index, BlockFilter&
 
 bool BlockFilterIndex::LookupFilterHeader(const CBlockIndex* block_index, uint256& header_out)
 {
+    {
+        LOCK(m_cs_recent);
+        const RecentFilter* recent = GetRecentFilter(block_index);
+        if (recent != nullptr) {
+            header_out = recent->header;
+            return true;
+        }
+    }
+
     LOCK(m_cs_headers_cache);
 
     bool is_checkpoint{block_index->nHeight % CFCHECKPT_INTERVAL == 0};
@@ -422,20 +555,59 @@ bool BlockFilterIndex::LookupFilterHeader(const CBlockIndex* block_index, uint25
 bool BlockFilterIndex::LookupFilterRange(int start_height, const CBlockIndex* stop_index,
                                          std::vector<BlockFilter>& filters_out) const
 {
-    std::vector<DBVal> entries;
-    if (!LookupRange(*m_db, m_name, start_height, stop_index, entries)) {
+    std::vector<EncodedBlockFilter> encoded_filters;
+    if (!LookupEncodedFilterRange(start_height, stop_index, encoded_filters)) {
         return false;
     }
 
-    filters_out.resize(entries.size());
-    auto filter_pos_it = filters_out.begin();
-    for (const auto& entry : entries) {
-        if (!ReadFilterFromDisk(entry.pos, *filter_pos_it)) {
+    filters_out.clear();
+    filters_out.reserve(encoded_filters.size());
+    for (auto& encoded : encoded_filters) {
+        filters_out.emplace_back(GetFilterType(), encoded.block_hash, std::move(encoded.encoded_filter));
+    }
+
+    return true;
+}
+
+bool BlockFilterIndex::LookupEncodedFilterRange(int start_height, const CBlockIndex* stop_index,
+                                                std::vector<EncodedBlockFilter>& filters_out) const
+{
+    if (start_height < 0 || start_height > stop_index->nHeight) {
+        return error("%s: invalid range %d-%d", __func__, start_height, stop_index->nHeight);
+    }
+
+    filters_out.clear();
+    filters_out.reserve(stop_index->nHeight - start_height + 1);
+
+    // Serve the tail of the range from memory and only read the rest from disk
+    std::vector<EncodedBlockFilter> recent_filters;
+    int first_recent_height;
+    {
+        LOCK(m_cs_recent);
+        first_recent_height = GetFirstRecentHeight(start_height, stop_index);
+        for (int height = first_recent_height; height <= stop_index->nHeight; ++height) {
+            const RecentFilter& recent = m_recent_filters[height - m_recent_start_height];
+            recent_filters.push_back({recent.block_hash, recent.encoded_filter});
+        }
+    }
+
+    if (first_recent_height > start_height) {
+        std::vector<DBVal> entries;
+        if (!LookupRange(*m_db, m_name, start_height, stop_index->GetAncestor(first_recent_height - 1), entries)) {
+            return false;
+        }
+
+        std::vector<FlatFilePos> positions;
+        positions.reserve(entries.size());
+        for (const auto& entry : entries) {
+            positions.push_back(entry.pos);
+        }
+        if (!ReadEncodedFiltersFromDisk(positions, filters_out)) {
             return false;
         }
-        ++filter_pos_it;
     }
 
+    std::move(recent_filters.begin(), recent_filters.end(), std::back_inserter(filters_out));
     return true;
 }
 
@@ -443,15 +615,61 @@ bool BlockFilterIndex::LookupFilterHashRange(int start_height, const CBlockIndex
                                              std::vector<uint256>& hashes_out) const
 
 {
-    std::vector<DBVal> entries;
-    if (!LookupRange(*m_db, m_name, start_height, stop_index, entries)) {
-        return false;
+    if (start_height < 0 || start_height > stop_index->nHeight) {
+        return error("%s: invalid range %d-%d", __func__, start_height, stop_index->nHeight);
+    }
+
+    std::vector<uint256> recent_hashes;
+    int first_recent_height;
+    {
+        LOCK(m_cs_recent);
+        first_recent_height = GetFirstRecentHeight(start_height, stop_index);
+        for (int height = first_recent_height; height <= stop_index->nHeight; ++height) {
+            recent_hashes.push_back(m_recent_filters[height - m_recent_start_height].filter_hash);
+        }
     }
 
     hashes_out.clear();
-    hashes_out.reserve(entries.size());
-    for (const auto& entry : entries) {
-        hashes_out.push_back(entry.hash);
+    hashes_out.reserve(stop_index->nHeight - start_height + 1);
+
+    if (first_recent_height > start_height) {
+        std::vector<DBVal> entries;
+        if (!LookupRange(*m_db, m_name, start_height, stop_index->GetAncestor(first_recent_height - 1), entries)) {
+            return false;
+        }
+        for (const auto& entry : entries) {
+            hashes_out.push_back(entry.hash);
+        }
+    }
+
+    hashes_out.insert(hashes_out.end(), recent_hashes.begin(), recent_hashes.end());
+    return true;
+}
+
+bool BlockFilterIndex::LookupCheckpointHeaders(const CBlockIndex* stop_index, std::vector<uint256>& headers_out)
+{
+    headers_out.resize(stop_index->nHeight / CFCHECKPT_INTERVAL);
+
+    std::vector<size_t> missing;
+    {
+        LOCK(m_cs_recent);
+        for (size_t i = 0; i < headers_out.size(); ++i) {
+            const int height = (i + 1) * CFCHECKPT_INTERVAL;
+            if (i < m_checkpoints.size() &&
+                m_checkpoints[i].first == stop_index->GetAncestor(height)->GetBlockHash()) {
+                headers_out[i] = m_checkpoints[i].second;
+            } else {
+                missing.push_back(i);
+            }
+        }
+    }
+
+    // Checkpoints of stale chains are looked up one by one
+    for (size_t i : missing) {
+        const CBlockIndex* block_index = stop_index->GetAncestor((i + 1) * CFCHECKPT_INTERVAL);
+        if (!LookupFilterHeader(block_index, headers_out[i])) {
+            return false;
+        }
     }
     return true;
 }
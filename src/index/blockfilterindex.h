@@ -10,9 +10,21 @@
 #include <flatfile.h>
 #include <index/base.h>
 
+#include <deque>
+
 /** Interval between compact filter checkpoints. See BIP 157. */
 static constexpr int CFCHECKPT_INTERVAL = 1000;
 
+/** Number of blocks near the tip of the index whose filters are kept in memory. */
+static constexpr int RECENT_FILTERS_CACHE_SIZE = 2000;
+
+/** A block filter as stored in the filter files, without decoding the GCS filter. */
+struct EncodedBlockFilter
+{
+    uint256 block_hash;
+    std::vector<unsigned char> encoded_filter;
+};
+
 struct FilterHeaderHasher
 {
     size_t operator()(const uint256& hash) const { return ReadLE64(hash.begin()); }
@@ -36,12 +48,38 @@ private:
     std::unique_ptr<FlatFileSeq> m_filter_fileseq;
 
     bool ReadFilterFromDisk(const FlatFilePos& pos, BlockFilter& filter) const;
+    /** Read the filters at the given positions, opening each filter file only once. */
+    bool ReadEncodedFiltersFromDisk(const std::vector<FlatFilePos>& positions, std::vector<EncodedBlockFilter>& filters_out) const;
     size_t WriteFilterToDisk(FlatFilePos& pos, const BlockFilter& filter);
 
     Mutex m_cs_headers_cache;
     /** cache of block hash to filter header, to avoid disk access when responding to getcfcheckpt. */
     std::unordered_map<uint256, uint256, FilterHeaderHasher> m_headers_cache GUARDED_BY(m_cs_headers_cache);
 
+    /** Everything stored for a block, kept in memory for the blocks near the tip of the index. */
+    struct RecentFilter
+    {
+        uint256 block_hash;
+        uint256 filter_hash;
+        uint256 header;
+        std::vector<unsigned char> encoded_filter;
+    };
+
+    mutable Mutex m_cs_recent;
+    /** Filters of the last indexed blocks, m_recent_filters[i] belongs to height m_recent_start_height + i. */
+    std::deque<RecentFilter> m_recent_filters GUARDED_BY(m_cs_recent);
+    int m_recent_start_height GUARDED_BY(m_cs_recent){0};
+    /** Block hash and filter header at every checkpoint height of the indexed chain, m_checkpoints[i]
+     *  belongs to height (i + 1) * CFCHECKPT_INTERVAL. Extended incrementally as blocks are indexed. */
+    std::vector<std::pair<uint256, uint256>> m_checkpoints GUARDED_BY(m_cs_recent);
+
+    void AddRecentFilter(const CBlockIndex* pindex, const BlockFilter& filter, const uint256& header);
+
+    /** Returns the lowest height >= start_height from which on the chain ending in stop_index can be
+     *  served from m_recent_filters, or stop_index->nHeight + 1 if it can't. */
+    int GetFirstRecentHeight(int start_height, const CBlockIndex* stop_index) const EXCLUSIVE_LOCKS_REQUIRED(m_cs_recent);
+    const RecentFilter* GetRecentFilter(const CBlockIndex* block_index) const EXCLUSIVE_LOCKS_REQUIRED(m_cs_recent);
+
 protected:
     bool Init() override;
 
@@ -72,6 +110,13 @@ public:
     bool LookupFilterRange(int start_height, const CBlockIndex* stop_index,
                            std::vector<BlockFilter>& filters_out) const;
 
+    /** Get a range of filters between two heights on a chain without decoding them. */
+    bool LookupEncodedFilterRange(int start_height, const CBlockIndex* stop_index,
+                                  std::vector<EncodedBlockFilter>& filters_out) const;
+
+    /** Get the filter headers at all checkpoint heights up to stop_index. See BIP 157. */
+    bool LookupCheckpointHeaders(const CBlockIndex* stop_index, std::vector<uint256>& headers_out);
+
     /** Get a range of filter hashes between two heights on a chain. */
     bool LookupFilterHashRange(int start_height, const CBlockIndex* stop_index,
                                std::vector<uint256>& hashes_out) const;
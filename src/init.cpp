@@ -17,6 +17,7 @@
 #include <blockfilter.h>
 #include <chain.h>
 #include <chainparams.h>
+#include <node/blockcache.h>
 #include <node/coinstats.h>
 #include <compat/sanity.h>
 #include <consensus/validation.h>
@@ -64,6 +65,7 @@
 #include <masternode/node.h>
 #include <coinjoin/server.h>
 #include <dsnotificationinterface.h>
+#include <dbwrapper.h>
 #include <flat-database.h>
 #include <governance/governance.h>
 #include <masternode/meta.h>
@@ -186,6 +188,9 @@ static fs::path GetPidFile()
 
 static std::unique_ptr<ECCVerifyHandle> globalVerifyHandle;
 
+/** Persistent store of the spork, masternode meta info and fulfilled request caches */
+static std::unique_ptr<CDBWrapper> pnodecachedb;
+
 static boost::thread_group threadGroup;
 static CScheduler scheduler;
 
@@ -240,6 +245,7 @@ void PrepareShutdown(InitInterfaces& interfaces)
     // Because these depend on each-other, we make sure that neither can be
     // using the other before destroying them.
     if (peerLogic) UnregisterValidationInterface(peerLogic.get());
+    if (peerLogic) peerLogic->StopFilterMatcher();
     if (g_connman) g_connman->Stop();
     if (g_txindex) g_txindex->Stop();
     ForEachBlockFilterIndex([](BlockFilterIndex& index) { index.Stop(); });
@@ -252,19 +258,25 @@ void PrepareShutdown(InitInterfaces& interfaces)
     threadGroup.interrupt_all();
     threadGroup.join_all();
     StopScriptCheckWorkerThreads();
+    StopHeaderCheckWorkerThreads();
+    StopTxInputsCheckWorkerThreads();
 
     // After there are no more peers/RPC left to give us new data which may generate
     // CValidationInterface callbacks, flush them...
     GetMainSignals().FlushBackgroundCallbacks();
 
+    // The scheduler is gone, send out what was aggregated since the last flush
+    statsClient.flush();
+    statsClient.setAggregate(false);
+
+    // The node caches are written as they change, only write out what is still pending
+    mmetaman.DisconnectCacheDB();
+    netfulfilledman.DisconnectCacheDB();
+    sporkManager.DisconnectCacheDB();
+    pnodecachedb.reset();
+
     if (!fRPCInWarmup) {
         // STORE DATA CACHES INTO SERIALIZED DAT FILES
-        CFlatDB<CMasternodeMetaMan> flatdb1("mncache.dat", "magicMasternodeCache");
-        flatdb1.Dump(mmetaman);
-        CFlatDB<CNetFulfilledRequestManager> flatdb4("netfulfilled.dat", "magicFulfilledCache");
-        flatdb4.Dump(netfulfilledman);
-        CFlatDB<CSporkManager> flatdb6("sporks.dat", "magicSporkCache");
-        flatdb6.Dump(sporkManager);
         if (!fDisableGovernance) {
             CFlatDB<CGovernanceManager> flatdb3("governance.dat", "magicGovernanceCache");
             flatdb3.Dump(governance);
@@ -390,6 +402,7 @@ void Shutdown(InitInterfaces& interfaces)
     globalVerifyHandle.reset();
     ECC_Stop();
     LogPrintf("%s: done\n", __func__);
+    LogInstance().StopAsyncLogging();
 }
 
 /**
@@ -492,7 +505,7 @@ void SetupServerArgs()
     gArgs.AddArg("-maxrecsigsage=<n>", strprintf("Number of seconds to keep LLMQ recovery sigs (default: %u)", llmq::DEFAULT_MAX_RECOVERED_SIGS_AGE), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     gArgs.AddArg("-mempoolexpiry=<n>", strprintf("Do not keep transactions in the mempool longer than <n> hours (default: %u)", DEFAULT_MEMPOOL_EXPIRY), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     gArgs.AddArg("-minimumchainwork=<hex>", strprintf("Minimum work assumed to exist on a valid chain in hex (default: %s, testnet: %s)", defaultChainParams->GetConsensus().nMinimumChainWork.GetHex(), testnetChainParams->GetConsensus().nMinimumChainWork.GetHex()), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::OPTIONS);
-    gArgs.AddArg("-par=<n>", strprintf("Set the number of script verification threads (%u to %d, 0 = auto, <0 = leave that many cores free, default: %d)",
+    gArgs.AddArg("-par=<n>", strprintf("Set the number of script and header verification threads (%u to %d, 0 = auto, <0 = leave that many cores free, default: %d)",
         -GetNumCores(), MAX_SCRIPTCHECK_THREADS, DEFAULT_SCRIPTCHECK_THREADS), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     gArgs.AddArg("-persistmempool", strprintf("Whether to save the mempool on shutdown and load on restart (default: %u)", DEFAULT_PERSIST_MEMPOOL), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
 #ifndef WIN32
@@ -688,10 +701,12 @@ void SetupServerArgs()
     gArgs.AddArg("-debugexclude=<category>", strprintf("Exclude debugging information for a category. Can be used in conjunction with -debug=1 to output debug logs for all categories except one or more specified categories."), ArgsManager::ALLOW_ANY, OptionsCategory::DEBUG_TEST);
     gArgs.AddArg("-disablegovernance", strprintf("Disable governance validation (0-1, default: %u)", 0), ArgsManager::ALLOW_ANY, OptionsCategory::DEBUG_TEST);
     gArgs.AddArg("-help-debug", "Print help message with debugging options and exit", ArgsManager::ALLOW_ANY, OptionsCategory::DEBUG_TEST);
+    gArgs.AddArg("-logasync", strprintf("Write debug output from a dedicated thread instead of the logging threads, messages are dropped if a thread logs faster than they can be written (default: %u)", DEFAULT_LOGASYNC), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     gArgs.AddArg("-logips", strprintf("Include IP addresses in debug output (default: %u)", DEFAULT_LOGIPS), ArgsManager::ALLOW_ANY, OptionsCategory::DEBUG_TEST);
     gArgs.AddArg("-logtimemicros", strprintf("Add microsecond precision to debug timestamps (default: %u)", DEFAULT_LOGTIMEMICROS), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     gArgs.AddArg("-logtimestamps", strprintf("Prepend debug output with timestamp (default: %u)", DEFAULT_LOGTIMESTAMPS), ArgsManager::ALLOW_ANY, OptionsCategory::DEBUG_TEST);
     gArgs.AddArg("-logthreadnames", strprintf("Prepend debug output with name of the originating thread (only available on platforms supporting thread_local) (default: %u)", DEFAULT_LOGTHREADNAMES), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
+    gArgs.AddArg("-maxblssigcachesize=<n>", strprintf("Limit size of the BLS signature verification cache to <n> MiB (default: %u)", DEFAULT_MAX_BLS_SIG_CACHE_SIZE), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     gArgs.AddArg("-maxsigcachesize=<n>", strprintf("Limit sum of signature cache and script execution cache sizes to <n> MiB (default: %u)", DEFAULT_MAX_SIG_CACHE_SIZE), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     gArgs.AddArg("-maxtipage=<n>", strprintf("Maximum tip age in seconds to consider node in initial block download (default: %u)", DEFAULT_MAX_TIP_AGE), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     gArgs.AddArg("-mocktime=<n>", "Replace actual time with <n> seconds since epoch (default: 0)", ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
@@ -744,6 +759,7 @@ void SetupServerArgs()
     gArgs.AddArg("-statshostname=<ip>", strprintf("Specify statsd host name (default: %s)", DEFAULT_STATSD_HOSTNAME), ArgsManager::ALLOW_ANY, OptionsCategory::STATSD);
     gArgs.AddArg("-statsport=<port>", strprintf("Specify statsd port (default: %u)", DEFAULT_STATSD_PORT), ArgsManager::ALLOW_ANY, OptionsCategory::STATSD);
     gArgs.AddArg("-statsns=<ns>", strprintf("Specify additional namespace prefix (default: %s)", DEFAULT_STATSD_NAMESPACE), ArgsManager::ALLOW_ANY, OptionsCategory::STATSD);
+    gArgs.AddArg("-statsflushinterval=<ms>", strprintf("Aggregate stats and send them every <ms> milliseconds, 0 sends every measurement right away (default: %d)", DEFAULT_STATSD_FLUSH_INTERVAL), ArgsManager::ALLOW_ANY, OptionsCategory::STATSD);
     gArgs.AddArg("-statsperiod=<seconds>", strprintf("Specify the number of seconds between periodic measurements (default: %d)", DEFAULT_STATSD_PERIOD), ArgsManager::ALLOW_ANY, OptionsCategory::STATSD);
 #ifdef ENABLE_WALLET
     gArgs.AddArg("-staking=<n>", strprintf("Enable staking functionality (0-1, default: %u)", 1), ArgsManager::ALLOW_ANY, OptionsCategory::POS);
@@ -803,6 +819,35 @@ static bool fHaveGenesis = false;
 static Mutex g_genesis_wait_mutex;
 static std::condition_variable g_genesis_wait_cv;
 
+/**
+ * Connect a cache to the node cache database. The flat file used by older versions is
+ * loaded first when fLoad is set, its content is moved to the database and the file is
+ * removed. Without fLoad, the cache is cleared instead.
+ */
+template <typename T>
+static bool ConnectNodeCache(T& cache, const std::string& strFilename, const std::string& strMagicMessage, bool fLoad)
+{
+    const fs::path path = GetDataDir() / strFilename;
+    if (fLoad && fs::exists(path)) {
+        CFlatDB<T> flatdb(strFilename, strMagicMessage);
+        if (!flatdb.Load(cache)) {
+            return false;
+        }
+    }
+    cache.ConnectCacheDB(*pnodecachedb);
+    if (!fLoad) {
+        cache.Clear();
+    }
+    try {
+        if (fs::remove(path)) {
+            LogPrintf("Removed %s, the cache is kept in the node cache database now\n", strFilename);
+        }
+    } catch (const fs::filesystem_error& e) {
+        LogPrintf("Failed to remove %s: %s\n", strFilename, fsbridge::get_filesystem_error_message(e));
+    }
+    return true;
+}
+
 static void BlockNotifyGenesisWait(bool, const CBlockIndex *pBlockIndex)
 {
     if (pBlockIndex != nullptr) {
@@ -989,17 +1034,19 @@ static void ThreadImport(std::vector<fs::path> vImportFiles)
 void PeriodicStats()
 {
     assert(gArgs.GetBoolArg("-statsenabled", DEFAULT_STATSD_ENABLE));
-    CCoinsStats stats;
-    ::ChainstateActive().ForceFlushStateToDisk();
-    if (WITH_LOCK(cs_main, return GetUTXOStats(&::ChainstateActive().CoinsDB(), stats))) {
-        statsClient.gauge("utxoset.tx", stats.nTransactions, 1.0f);
-        statsClient.gauge("utxoset.txOutputs", stats.nTransactionOutputs, 1.0f);
-        statsClient.gauge("utxoset.dbSizeBytes", stats.nDiskSize, 1.0f);
-        statsClient.gauge("utxoset.blockHeight", stats.nHeight, 1.0f);
-        statsClient.gauge("utxoset.totalAmount", (double)stats.nTotalAmount / (double)COIN, 1.0f);
-    } else {
-        // something went wrong
-        LogPrintf("%s: GetUTXOStats failed\n", __func__);
+    {
+        LOCK(cs_main);
+        const CUTXOStats& stats = ::ChainstateActive().m_utxo_stats;
+        const CBlockIndex* tip = ::ChainActive().Tip();
+        if (tip && stats.hashBlock == tip->GetBlockHash()) {
+            statsClient.gauge("utxoset.txOutputs", stats.nTransactionOutputs, 1.0f);
+            statsClient.gauge("utxoset.dbSizeBytes", ::ChainstateActive().CoinsDB().EstimateSize(), 1.0f);
+            statsClient.gauge("utxoset.blockHeight", tip->nHeight, 1.0f);
+            statsClient.gauge("utxoset.totalAmount", (double)stats.nTotalAmount / (double)COIN, 1.0f);
+        } else {
+            // something went wrong
+            LogPrintf("%s: UTXO set statistics are not available\n", __func__);
+        }
     }
 
     // short version of GetNetworkHashPS(120, -1);
@@ -1036,6 +1083,12 @@ void PeriodicStats()
     statsClient.gauge("transactions.mempool.totalTxBytes", (int64_t) mempool.GetTotalTxSize(), 1.0f);
     statsClient.gauge("transactions.mempool.memoryUsageBytes", (int64_t) mempool.DynamicMemoryUsage(), 1.0f);
     statsClient.gauge("transactions.mempool.minFeePerKb", mempool.GetMinFee(gArgs.GetArg("-maxmempool", DEFAULT_MAX_MEMPOOL_SIZE) * 1000000).GetFeePerK(), 1.0f);
+
+    const CBlockCache::Stats blockCacheStats = g_block_cache.GetStats();
+    statsClient.gauge("blockcache.blockHits", blockCacheStats.nBlockHits, 1.0f);
+    statsClient.gauge("blockcache.blockMisses", blockCacheStats.nBlockMisses, 1.0f);
+    statsClient.gauge("blockcache.undoHits", blockCacheStats.nUndoHits, 1.0f);
+    statsClient.gauge("blockcache.undoMisses", blockCacheStats.nUndoMisses, 1.0f);
 }
 
 /** Sanity checks
@@ -1643,6 +1696,9 @@ bool AppInitMain(InitInterfaces& interfaces)
         return InitError(strprintf(Untranslated("Could not open debug log file %s"),
             LogInstance().m_file_path.string()));
     }
+    if (gArgs.GetBoolArg("-logasync", DEFAULT_LOGASYNC) && !LogInstance().IsAsyncLogging()) {
+        LogInstance().StartAsyncLogging();
+    }
 
     if (!LogInstance().m_log_timestamps)
         LogPrintf("Startup time: %s\n", FormatISO8601DateTime(GetTime()));
@@ -1674,6 +1730,13 @@ bool AppInitMain(InitInterfaces& interfaces)
 
     InitSignatureCache();
     InitScriptExecutionCache();
+    {
+        // -maxblssigcachesize=0 still creates the minimum possible cache (2 elements)
+        size_t nMaxBLSCacheSize = std::min(std::max((int64_t)0, gArgs.GetArg("-maxblssigcachesize", DEFAULT_MAX_BLS_SIG_CACHE_SIZE)), MAX_MAX_SIG_CACHE_SIZE) * ((size_t) 1 << 20);
+        size_t nElems = InitBLSSignatureCache(nMaxBLSCacheSize);
+        LogPrintf("Using %zu MiB out of %zu requested for BLS signature cache, able to store %zu elements\n",
+                (nElems * sizeof(uint256)) >> 20, nMaxBLSCacheSize >> 20, nElems);
+    }
 
     int script_threads = gArgs.GetArg("-par", DEFAULT_SCRIPTCHECK_THREADS);
     if (script_threads <= 0) {
@@ -1692,6 +1755,8 @@ bool AppInitMain(InitInterfaces& interfaces)
     if (script_threads >= 1) {
         g_parallel_script_checks = true;
         StartScriptCheckWorkerThreads(script_threads);
+        StartHeaderCheckWorkerThreads(script_threads);
+        StartTxInputsCheckWorkerThreads(script_threads);
     }
 
     std::vector<std::string> vSporkAddresses;
@@ -1929,8 +1994,12 @@ bool AppInitMain(InitInterfaces& interfaces)
     // ********************************************************* Step 7a: Load sporks
 
     uiInterface.InitMessage(_("Loading sporks cache...").translated);
-    CFlatDB<CSporkManager> flatdb6("sporks.dat", "magicSporkCache");
-    if (!flatdb6.Load(sporkManager)) {
+    try {
+        pnodecachedb = std::make_unique<CDBWrapper>(GetDataDir() / "nodecache", 1 << 20);
+    } catch (const dbwrapper_error& e) {
+        return InitError(strprintf(_("Failed to open node cache database %s: %s"), (GetDataDir() / "nodecache").string(), e.what()));
+    }
+    if (!ConnectNodeCache(sporkManager, "sporks.dat", "magicSporkCache", true)) {
         return InitError(strprintf(_("Failed to load sporks cache from %s"), (GetDataDir() / "sporks.dat").string()));
     }
 
@@ -2120,6 +2189,11 @@ bool AppInitMain(InitInterfaces& interfaces)
                     assert(::ChainActive().Tip() != NULL);
                 }
 
+                if (!::ChainstateActive().LoadUTXOStats()) {
+                    strLoadError = _("Error loading UTXO set statistics");
+                    break;
+                }
+
                 if (is_coinsview_empty && !evoDb->IsEmpty()) {
                     // EvoDB processed some blocks earlier but we have no blocks anymore, something is wrong
                     strLoadError = _("Error initializing block database");
@@ -2306,16 +2380,8 @@ bool AppInitMain(InitInterfaces& interfaces)
 
     strDBName = "mncache.dat";
     uiInterface.InitMessage(_("Loading masternode cache...").translated);
-    CFlatDB<CMasternodeMetaMan> flatdb1(strDBName, "magicMasternodeCache");
-    if (fLoadCacheFiles) {
-        if(!flatdb1.Load(mmetaman)) {
-            return InitError(strprintf(_("Failed to load masternode cache from %s"), (pathDB / strDBName).string()));
-        }
-    } else {
-        CMasternodeMetaMan mmetamanTmp;
-        if(!flatdb1.Dump(mmetamanTmp)) {
-            return InitError(strprintf(_("Failed to clear masternode cache at %s"), (pathDB / strDBName).string()));
-        }
+    if (!ConnectNodeCache(mmetaman, strDBName, "magicMasternodeCache", fLoadCacheFiles)) {
+        return InitError(strprintf(_("Failed to load masternode cache from %s"), (pathDB / strDBName).string()));
     }
 
     strDBName = "governance.dat";
@@ -2335,21 +2401,14 @@ bool AppInitMain(InitInterfaces& interfaces)
 
     strDBName = "netfulfilled.dat";
     uiInterface.InitMessage(_("Loading fulfilled requests cache...").translated);
-    CFlatDB<CNetFulfilledRequestManager> flatdb4(strDBName, "magicFulfilledCache");
-    if (fLoadCacheFiles) {
-        if(!flatdb4.Load(netfulfilledman)) {
-            return InitError(strprintf(_("Failed to load fulfilled requests cache from %s"),(pathDB / strDBName).string()));
-        }
-    } else {
-        CNetFulfilledRequestManager netfulfilledmanTmp;
-        if(!flatdb4.Dump(netfulfilledmanTmp)) {
-            return InitError(strprintf(_("Failed to clear fulfilled requests cache at %s"),(pathDB / strDBName).string()));
-        }
+    if (!ConnectNodeCache(netfulfilledman, strDBName, "magicFulfilledCache", fLoadCacheFiles)) {
+        return InitError(strprintf(_("Failed to load fulfilled requests cache from %s"),(pathDB / strDBName).string()));
     }
 
     // ********************************************************* Step 10c: schedule PirateCash-specific tasks
 
     scheduler.scheduleEvery(std::bind(&CNetFulfilledRequestManager::DoMaintenance, std::ref(netfulfilledman)), 60 * 1000);
+    scheduler.scheduleEvery(std::bind(&CMasternodeMetaMan::DoMaintenance, std::ref(mmetaman)), 60 * 1000);
     scheduler.scheduleEvery(std::bind(&CMasternodeSync::DoMaintenance, std::ref(masternodeSync), std::ref(*g_connman)), 1 * 1000);
     scheduler.scheduleEvery(std::bind(&CMasternodeUtils::DoMaintenance, std::ref(*g_connman)), 1 * 1000);
     scheduler.scheduleEvery(std::bind(&CDeterministicMNManager::DoMaintenance, std::ref(*deterministicMNManager)), 10 * 1000);
@@ -2366,6 +2425,11 @@ bool AppInitMain(InitInterfaces& interfaces)
     if (gArgs.GetBoolArg("-statsenabled", DEFAULT_STATSD_ENABLE)) {
         int nStatsPeriod = std::min(std::max((int)gArgs.GetArg("-statsperiod", DEFAULT_STATSD_PERIOD), MIN_STATSD_PERIOD), MAX_STATSD_PERIOD);
         scheduler.scheduleEvery(PeriodicStats, nStatsPeriod * 1000);
+        const int64_t nStatsFlushInterval = gArgs.GetArg("-statsflushinterval", DEFAULT_STATSD_FLUSH_INTERVAL);
+        if (nStatsFlushInterval > 0) {
+            statsClient.setAggregate(true);
+            scheduler.scheduleEvery([] { statsClient.flush(); }, nStatsFlushInterval);
+        }
     }
 
     llmq::StartLLMQSystem();
@@ -4,7 +4,9 @@
 
 #include <llmq/blockprocessor.h>
 #include <llmq/commitment.h>
+#include <llmq/utils.h>
 
+#include <bls/bls_worker.h>
 #include <evo/evodb.h>
 #include <evo/specialtx.h>
 
@@ -33,8 +35,9 @@ static const std::string DB_MINED_COMMITMENT_BY_INVERSED_HEIGHT_Q_INDEXED = "q_m
 
 static const std::string DB_BEST_BLOCK_UPGRADE = "q_bbu2";
 
-CQuorumBlockProcessor::CQuorumBlockProcessor(CEvoDB &_evoDb) :
-    evoDb(_evoDb)
+CQuorumBlockProcessor::CQuorumBlockProcessor(CEvoDB &_evoDb, CBLSWorker& _blsWorker) :
+    evoDb(_evoDb),
+    blsWorker(_blsWorker)
 {
     CLLMQUtils::InitQuorumsCache(mapHasMinedCommitmentCache);
 }
@@ -116,6 +119,8 @@ void CQuorumBlockProcessor::ProcessMessage(CNode* pfrom, const std::string& strC
             return;
         }
 
+        SetCommitmentSigVerified(::SerializeHash(qc));
+
         LogPrint(BCLog::LLMQ, "CQuorumBlockProcessor::%s -- received commitment for quorum %s:%d, validMembers=%d, signers=%d, peer=%d\n", __func__,
                  qc.quorumHash.ToString(), uint8_t(qc.llmqType), qc.CountValidMembers(), qc.CountSigners(), pfrom->GetId());
 
@@ -167,9 +172,16 @@ bool CQuorumBlockProcessor::ProcessBlock(const CBlock& block, const CBlockIndex*
         }
     }
 
+    // Signatures which were verified before or in parallel here are not verified again by ProcessCommitment
+    std::set<uint256> sigsVerified;
+    if (fBLSChecks) {
+        sigsVerified = VerifyCommitmentSigs(qcs);
+    }
+
     for (const auto& p : qcs) {
         const auto& qc = p.second;
-        if (!ProcessCommitment(pindex->nHeight, blockHash, qc, state, fJustCheck, fBLSChecks)) {
+        const bool fSigsVerified = !qc.IsNull() && sigsVerified.count(::SerializeHash(qc)) != 0;
+        if (!ProcessCommitment(pindex->nHeight, blockHash, qc, state, fJustCheck, fBLSChecks && !fSigsVerified)) {
             LogPrintf("[ProcessBlock] failed h[%d] llmqType[%d] version[%d] quorumIndex[%d] quorumHash[%s]\n", pindex->nHeight, static_cast<int>(qc.llmqType), qc.nVersion, qc.quorumIndex, qc.quorumHash.ToString());
             return false;
         }
@@ -248,6 +260,10 @@ bool CQuorumBlockProcessor::ProcessCommitment(int nHeight, const uint256& blockH
         return state.DoS(100, false, REJECT_INVALID, "bad-qc-invalid");
     }
 
+    if (fBLSChecks) {
+        SetCommitmentSigVerified(::SerializeHash(qc));
+    }
+
     if (fJustCheck) {
         return true;
     }
@@ -282,6 +298,76 @@ bool CQuorumBlockProcessor::ProcessCommitment(int nHeight, const uint256& blockH
     return true;
 }
 
+std::set<uint256> CQuorumBlockProcessor::VerifyCommitmentSigs(const std::multimap<Consensus::LLMQType, CFinalCommitment>& qcs)
+{
+    AssertLockHeld(cs_main);
+
+    std::set<uint256> ret;
+    if (!blsWorker.IsStarted()) {
+        return ret;
+    }
+
+    struct SigChecks {
+        uint256 hash;
+        std::future<bool> membersSigValid;
+        std::future<bool> quorumSigValid;
+    };
+    std::vector<SigChecks> checks;
+
+    for (const auto& p : qcs) {
+        const auto& qc = p.second;
+        if (qc.IsNull()) {
+            continue;
+        }
+        uint256 hash = ::SerializeHash(qc);
+        if (IsCommitmentSigVerified(hash)) {
+            ret.emplace(hash);
+            continue;
+        }
+        // anything malformed is left to the serial checks in ProcessCommitment, which reject it properly
+        const CBlockIndex* pQuorumBaseBlockIndex = LookupBlockIndex(qc.quorumHash);
+        if (pQuorumBaseBlockIndex == nullptr || !Params().HasLLMQ(qc.llmqType) || !qc.VerifySizes(GetLLMQParams(qc.llmqType))) {
+            continue;
+        }
+        auto members = CLLMQUtils::GetAllQuorumMembers(qc.llmqType, pQuorumBaseBlockIndex);
+        uint256 commitmentHash = CLLMQUtils::BuildCommitmentHash(qc.llmqType, qc.quorumHash, qc.validMembers, qc.quorumPublicKey, qc.quorumVvecHash);
+        checks.emplace_back(SigChecks{
+            hash,
+            blsWorker.AsyncVerifySecureAggregatedSig(qc.membersSig, qc.GetSignerPubKeys(members), commitmentHash),
+            // not batched, the result is cached and lets ProcessCommitment skip the signature checks
+            blsWorker.AsyncVerifySigUnbatched(qc.quorumSig, qc.quorumPublicKey, commitmentHash)});
+    }
+
+    const size_t nVerifiedBefore = ret.size();
+    for (auto& c : checks) {
+        // always wait for both results, the second future must not be left pending
+        bool membersSigValid = c.membersSigValid.get();
+        bool quorumSigValid = c.quorumSigValid.get();
+        if (membersSigValid && quorumSigValid) {
+            SetCommitmentSigVerified(c.hash);
+            ret.emplace(c.hash);
+        }
+    }
+
+    LogPrint(BCLog::LLMQ, "CQuorumBlockProcessor::%s -- verified %d of %d commitments in parallel, %d were verified before\n", __func__,
+             ret.size() - nVerifiedBefore, checks.size(), nVerifiedBefore);
+
+    return ret;
+}
+
+bool CQuorumBlockProcessor::IsCommitmentSigVerified(const uint256& commitmentHash) const
+{
+    LOCK(verifiedCommitmentsCs);
+    bool ret;
+    return verifiedCommitmentsCache.get(commitmentHash, ret);
+}
+
+void CQuorumBlockProcessor::SetCommitmentSigVerified(const uint256& commitmentHash)
+{
+    LOCK(verifiedCommitmentsCs);
+    verifiedCommitmentsCache.insert(commitmentHash, true);
+}
+
 bool CQuorumBlockProcessor::UndoBlock(const CBlock& block, const CBlockIndex* pindex)
 {
     AssertLockHeld(cs_main);
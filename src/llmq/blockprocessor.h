@@ -15,9 +15,12 @@
 #include <sync.h>
 #include <optional>
 
+#include <map>
+#include <set>
 #include <unordered_map>
 
 class CNode;
+class CBLSWorker;
 class CConnman;
 class CValidationState;
 class CEvoDB;
@@ -34,6 +37,7 @@ class CQuorumBlockProcessor
 {
 private:
     CEvoDB& evoDb;
+    CBLSWorker& blsWorker;
 
     // TODO cleanup
     mutable CCriticalSection minableCommitmentsCs;
@@ -42,8 +46,13 @@ private:
 
     mutable std::map<Consensus::LLMQType, unordered_lru_cache<uint256, bool, StaticSaltedHasher>> mapHasMinedCommitmentCache GUARDED_BY(minableCommitmentsCs);
 
+    // Hashes of commitments with already verified signatures, e.g. from when they were received as qfcommit. The
+    // signatures only depend on the commitment itself, as the quorum members are derived from its quorumHash
+    mutable CCriticalSection verifiedCommitmentsCs;
+    mutable unordered_lru_cache<uint256, bool, StaticSaltedHasher, 1024> verifiedCommitmentsCache GUARDED_BY(verifiedCommitmentsCs);
+
 public:
-    explicit CQuorumBlockProcessor(CEvoDB& _evoDb);
+    CQuorumBlockProcessor(CEvoDB& _evoDb, CBLSWorker& _blsWorker);
 
     bool UpgradeDB();
 
@@ -69,6 +78,9 @@ public:
 private:
     static bool GetCommitmentsFromBlock(const CBlock& block, const CBlockIndex* pindex, std::multimap<Consensus::LLMQType, CFinalCommitment>& ret, CValidationState& state) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
     bool ProcessCommitment(int nHeight, const uint256& blockHash, const CFinalCommitment& qc, CValidationState& state, bool fJustCheck, bool fBLSChecks) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+    std::set<uint256> VerifyCommitmentSigs(const std::multimap<Consensus::LLMQType, CFinalCommitment>& qcs) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+    bool IsCommitmentSigVerified(const uint256& commitmentHash) const;
+    void SetCommitmentSigVerified(const uint256& commitmentHash);
     bool IsMiningPhase(const Consensus::LLMQParams& llmqParams, int nHeight) const EXCLUSIVE_LOCKS_REQUIRED(cs_main);
     size_t GetNumCommitmentsRequired(const Consensus::LLMQParams& llmqParams, int nHeight) const EXCLUSIVE_LOCKS_REQUIRED(cs_main);
     static uint256 GetQuorumBlockHash(const Consensus::LLMQParams& llmqParams, int nHeight, int quorumIndex) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
@@ -417,20 +417,20 @@ CChainLocksHandler::BlockTxs::mapped_type CChainLocksHandler::GetBlockTxs(const
         {
             LOCK(cs_main);
             auto pindex = LookupBlockIndex(blockHash);
-            CBlock block;
-            if (!ReadBlockFromDisk(block, pindex, Params().GetConsensus())) {
+            auto pblock = ReadSharedBlockFromDisk(pindex, Params().GetConsensus());
+            if (!pblock) {
                 return nullptr;
             }
 
             ret = std::make_shared<std::unordered_set<uint256, StaticSaltedHasher>>();
-            for (auto& tx : block.vtx) {
+            for (auto& tx : pblock->vtx) {
                 if (tx->IsCoinBase() || tx->vin.empty()) {
                     continue;
                 }
                 ret->emplace(tx->GetHash());
             }
 
-            blockTime = block.nTime;
+            blockTime = pblock->nTime;
         }
 
         LOCK(cs);
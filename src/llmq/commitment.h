@@ -55,6 +55,9 @@ public:
     bool VerifyNull() const;
     bool VerifySizes(const Consensus::LLMQParams& params) const;
 
+    // Operator keys of the members which contributed to membersSig
+    std::vector<CBLSPublicKey> GetSignerPubKeys(const std::vector<CDeterministicMNCPtr>& members) const;
+
 public:
     SERIALIZE_METHODS(CFinalCommitment, obj)
     {
@@ -42,6 +42,12 @@ UniValue CDKGDebugSessionStatus::ToJson(int quorumIndex, int detailLevel) const
     ret.pushKV("sentPrematureCommitment", sentPrematureCommitment);
     ret.pushKV("aborted", aborted);
 
+    UniValue phaseLatenciesJson(UniValue::VOBJ);
+    for (const auto& [strPhase, nLatency] : phaseLatencies) {
+        phaseLatenciesJson.pushKV(strPhase, nLatency);
+    }
+    ret.pushKV("phaseLatencies", phaseLatenciesJson);
+
     struct ArrOrCount {
         int count{0};
         UniValue arr{UniValue::VARR};
@@ -10,6 +10,7 @@
 #include <univalue.h>
 
 #include <functional>
+#include <map>
 #include <set>
 
 class CDataStream;
@@ -69,6 +70,10 @@ public:
 
     std::vector<CDKGDebugMemberStatus> members;
 
+    // by phase name, milliseconds from the start of a phase until our work for it was done and the last message for
+    // it was processed
+    std::map<std::string, int64_t> phaseLatencies;
+
 public:
     CDKGDebugSessionStatus() : statusBitset(0) {}
 
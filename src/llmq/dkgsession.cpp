@@ -27,6 +27,7 @@ namespace llmq
 // Supported error types:
 // - contribution-omit
 // - contribution-lie
+// - contribution-dup
 // - complain-lie
 // - justify-lie
 // - justify-omit
@@ -203,6 +204,21 @@ void CDKGSession::SendContributions(CDKGPendingMessages& pendingMessages)
     });
 
     pendingMessages.PushPendingMessage(-1, qc);
+
+    if (ShouldSimulateError("contribution-dup")) {
+        // encrypting the same shares again results in a second, distinct contribution with a valid signature
+        logger.Batch("sending a second contribution");
+        CDKGContribution qc2 = qc;
+        qc2.contributions = std::make_shared<CBLSIESMultiRecipientObjects<CBLSSecretKey>>();
+        qc2.contributions->InitEncrypt(members.size());
+        for (size_t i = 0; i < members.size(); i++) {
+            if (!qc2.contributions->Encrypt(i, members[i]->dmn->pdmnState->pubKeyOperator.Get(), skContributions[i], PROTOCOL_VERSION)) {
+                return;
+            }
+        }
+        qc2.sig = WITH_LOCK(activeMasternodeInfoCs, return activeMasternodeInfo.blsKeyOperator->Sign(qc2.GetSignHash()));
+        pendingMessages.PushPendingMessage(-1, qc2);
+    }
 }
 
 // only performs cheap verifications, but not the signature of the message. this is checked with batched verification
@@ -252,6 +268,32 @@ bool CDKGSession::PreVerifyMessage(const CDKGContribution& qc, bool& retBan) con
     return true;
 }
 
+// Starts decrypting our shares of the given (signature verified) contributions on the BLS worker, so that
+// decryption of a whole batch runs in parallel while ReceiveMessage processes the contributions one by one
+void CDKGSession::DecryptContributions(const std::vector<std::shared_ptr<CDKGContribution>>& qcs)
+{
+    if (!AreWeMember() || !blsWorker.IsStarted()) {
+        return;
+    }
+
+    const CBLSSecretKey sk = WITH_LOCK(activeMasternodeInfoCs, return *activeMasternodeInfo.blsKeyOperator);
+
+    LOCK(cs_pending);
+    // ReceiveMessage processes at most 2 contributions per member, don't decrypt more than that
+    std::map<size_t, size_t> mapStarted;
+    for (const auto& qc : qcs) {
+        auto member = GetMember(qc->proTxHash);
+        if (!member || member->contributions.size() >= 2 || mapStarted[member->idx] >= 2) {
+            continue;
+        }
+        const uint256 hash = ::SerializeHash(*qc);
+        if (pendingContributionDecryptions.count(hash) == 0) {
+            pendingContributionDecryptions.emplace(hash, blsWorker.AsyncDecryptSecretKey(qc->contributions, *myIdx, sk, PROTOCOL_VERSION));
+            mapStarted[member->idx]++;
+        }
+    }
+}
+
 void CDKGSession::ReceiveMessage(const CDKGContribution& qc, bool& retBan)
 {
     LOCK(cs_pending);
@@ -265,6 +307,15 @@ void CDKGSession::ReceiveMessage(const CDKGContribution& qc, bool& retBan)
     cxxtimer::Timer t1(true);
     logger.Batch("received contribution from %s", qc.proTxHash.ToString());
 
+    const uint256 hash = ::SerializeHash(qc);
+
+    // take over a decryption started by DecryptContributions, if any. it's discarded when we bail out early
+    std::optional<std::future<CBLSSecretKey>> decryption;
+    if (auto it = pendingContributionDecryptions.find(hash); it != pendingContributionDecryptions.end()) {
+        decryption = std::move(it->second);
+        pendingContributionDecryptions.erase(it);
+    }
+
     // relay, no matter if further verification fails
     // This ensures the whole quorum sees the bad behavior
 
@@ -273,7 +324,6 @@ void CDKGSession::ReceiveMessage(const CDKGContribution& qc, bool& retBan)
         return;
     }
 
-    const uint256 hash = ::SerializeHash(qc);
     WITH_LOCK(invCs, contributions.emplace(hash, qc));
     member->contributions.emplace(hash);
 
@@ -310,7 +360,14 @@ void CDKGSession::ReceiveMessage(const CDKGContribution& qc, bool& retBan)
 
     bool complain = false;
     CBLSSecretKey skContribution;
-    if (!qc.contributions->Decrypt(*myIdx, WITH_LOCK(activeMasternodeInfoCs, return *activeMasternodeInfo.blsKeyOperator), skContribution, PROTOCOL_VERSION)) {
+    bool decrypted;
+    if (decryption) {
+        skContribution = decryption->get();
+        decrypted = skContribution.IsValid();
+    } else {
+        decrypted = qc.contributions->Decrypt(*myIdx, WITH_LOCK(activeMasternodeInfoCs, return *activeMasternodeInfo.blsKeyOperator), skContribution, PROTOCOL_VERSION);
+    }
+    if (!decrypted) {
         logger.Batch("contribution from %s could not be decrypted", member->dmn->proTxHash.ToString());
         complain = true;
     } else if (member->idx != myIdx && ShouldSimulateError("complain-lie")) {
@@ -269,6 +269,8 @@ private:
 
     mutable CCriticalSection cs_pending;
     std::vector<size_t> pendingContributionVerifications GUARDED_BY(cs_pending);
+    // our shares of received contributions, decrypted on the BLS worker. indexed by msg hash
+    std::map<uint256, std::future<CBLSSecretKey>> pendingContributionDecryptions GUARDED_BY(cs_pending);
 
     // filled by ReceivePrematureCommitment and used by FinalizeCommitments
     std::set<uint256> validCommitments GUARDED_BY(invCs);
@@ -298,6 +300,7 @@ public:
     void Contribute(CDKGPendingMessages& pendingMessages);
     void SendContributions(CDKGPendingMessages& pendingMessages);
     bool PreVerifyMessage(const CDKGContribution& qc, bool& retBan) const;
+    void DecryptContributions(const std::vector<std::shared_ptr<CDKGContribution>>& qcs);
     void ReceiveMessage(const CDKGContribution& qc, bool& retBan);
     void VerifyPendingContributions() EXCLUSIVE_LOCKS_REQUIRED(cs_pending);
 
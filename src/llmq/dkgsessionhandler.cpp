@@ -295,6 +295,20 @@ void CDKGSessionHandler::SleepBeforePhase(QuorumPhase curPhase,
     LogPrint(BCLog::LLMQ_DKG, "CDKGSessionManager::%s -- %s qi[%d] - done, curPhase=%d\n", __func__, params.name, quorumIndex, int(curPhase));
 }
 
+static std::string GetPhaseName(QuorumPhase phase)
+{
+    switch (phase) {
+    case QuorumPhase::Initialized: return "initialized";
+    case QuorumPhase::Contribute: return "contribute";
+    case QuorumPhase::Complain: return "complain";
+    case QuorumPhase::Justify: return "justify";
+    case QuorumPhase::Commit: return "commit";
+    case QuorumPhase::Finalize: return "finalize";
+    case QuorumPhase::Idle: return "idle";
+    }
+    return strprintf("%d", int(phase));
+}
+
 void CDKGSessionHandler::HandlePhase(QuorumPhase curPhase,
                                      QuorumPhase nextPhase,
                                      const uint256& expectedQuorumHash,
@@ -304,11 +318,28 @@ void CDKGSessionHandler::HandlePhase(QuorumPhase curPhase,
 {
     LogPrint(BCLog::LLMQ_DKG, "CDKGSessionManager::%s -- %s qi[%d] - starting, curPhase=%d, nextPhase=%d\n", __func__, params.name, quorumIndex, int(curPhase), int(nextPhase));
 
-    SleepBeforePhase(curPhase, expectedQuorumHash, randomSleepFactor, runWhileWaiting);
+    // the phase is complete once our own work is done and the last message for it was processed
+    const int64_t nPhaseStart = GetTimeMillis();
+    int64_t nPhaseCompleted = nPhaseStart;
+    const WhileWaitFunc runAndMeasure = [&]() {
+        if (!runWhileWaiting()) {
+            return false;
+        }
+        nPhaseCompleted = GetTimeMillis();
+        return true;
+    };
+
+    SleepBeforePhase(curPhase, expectedQuorumHash, randomSleepFactor, runAndMeasure);
     startPhaseFunc();
-    WaitForNextPhase(curPhase, nextPhase, expectedQuorumHash, runWhileWaiting);
+    nPhaseCompleted = GetTimeMillis();
+    WaitForNextPhase(curPhase, nextPhase, expectedQuorumHash, runAndMeasure);
 
-    LogPrint(BCLog::LLMQ_DKG, "CDKGSessionManager::%s -- %s qi[%d] - done, curPhase=%d, nextPhase=%d\n", __func__, params.name, quorumIndex, int(curPhase), int(nextPhase));
+    quorumDKGDebugManager->UpdateLocalSessionStatus(params.type, quorumIndex, [&](CDKGDebugSessionStatus& status) {
+        status.phaseLatencies[GetPhaseName(curPhase)] = nPhaseCompleted - nPhaseStart;
+        return true;
+    });
+
+    LogPrint(BCLog::LLMQ_DKG, "CDKGSessionManager::%s -- %s qi[%d] - done, curPhase=%d, nextPhase=%d, completed after %dms\n", __func__, params.name, quorumIndex, int(curPhase), int(nextPhase), nPhaseCompleted - nPhaseStart);
 }
 
 // returns a set of NodeIds which sent invalid messages
@@ -443,6 +474,16 @@ bool ProcessPendingMessageBatch(CDKGSession& session, CDKGPendingMessages& pendi
         }
     }
 
+    if constexpr (std::is_same_v<Message, CDKGContribution>) {
+        std::vector<std::shared_ptr<CDKGContribution>> contributions;
+        for (const auto& p : preverifiedMessages) {
+            if (!badNodes.count(p.first)) {
+                contributions.emplace_back(p.second);
+            }
+        }
+        session.DecryptContributions(contributions);
+    }
+
     for (const auto& p : preverifiedMessages) {
         const NodeId &nodeId = p.first;
         if (badNodes.count(nodeId)) {
@@ -502,7 +543,8 @@ void CDKGSessionHandler::HandleDKGRound()
         curSession->Contribute(pendingContributions);
     };
     auto fContributeWait = [this] {
-        return ProcessPendingMessageBatch<CDKGContribution, MSG_QUORUM_CONTRIB>(*curSession, pendingContributions, 8);
+        // contributions are decrypted in parallel, so larger batches keep more workers busy
+        return ProcessPendingMessageBatch<CDKGContribution, MSG_QUORUM_CONTRIB>(*curSession, pendingContributions, 32);
     };
     HandlePhase(QuorumPhase::Contribute, QuorumPhase::Complain, curQuorumHash, 0.05, fContributeStart, fContributeWait);
 
@@ -8,6 +8,10 @@
 #include <util/threadnames.h>
 #include <util/time.h>
 
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
 const char * const DEFAULT_DEBUGLOGFILE = "debug.log";
 
 BCLog::Logger& LogInstance()
@@ -79,6 +83,7 @@ bool BCLog::Logger::StartLogging()
 
 void BCLog::Logger::DisconnectTestLogger()
 {
+    StopAsyncLogging();
     StdLockGuard scoped_lock(m_cs);
     m_buffering = true;
     if (m_fileout != nullptr) fclose(m_fileout);
@@ -296,9 +301,8 @@ namespace BCLog {
     }
 }
 
-void BCLog::Logger::LogPrintStr(const std::string& str)
+std::string BCLog::Logger::PrefixLogStr(const std::string& str)
 {
-    StdLockGuard scoped_lock(m_cs);
     std::string str_prefixed = LogEscapeMessage(str);
 
     if (m_log_threadnames && m_started_new_line) {
@@ -310,20 +314,46 @@ void BCLog::Logger::LogPrintStr(const std::string& str)
 
     m_started_new_line = !str.empty() && str[str.size()-1] == '\n';
 
+    return str_prefixed;
+}
+
+void BCLog::Logger::LogPrintStr(const std::string& str)
+{
+    if (m_async) {
+        // StopAsyncLogging waits until no thread is between these two lines
+        ++m_async_producers;
+        if (m_async) {
+            if (!PushAsync(PrefixLogStr(str))) {
+                ++m_async_dropped;
+            }
+            --m_async_producers;
+            return;
+        }
+        --m_async_producers;
+    }
+
+    StdLockGuard scoped_lock(m_cs);
+    std::string str_prefixed = PrefixLogStr(str);
+
     if (m_buffering) {
         // buffer if we haven't started logging yet
         m_msgs_before_open.push_back(str_prefixed);
         return;
     }
 
+    for (const auto& cb : m_print_callbacks) {
+        cb(str_prefixed);
+    }
+    WriteToOutputs(str_prefixed);
+}
+
+void BCLog::Logger::WriteToOutputs(const std::string& str)
+{
     if (m_print_to_console) {
         // print to console
-        fwrite(str_prefixed.data(), 1, str_prefixed.size(), stdout);
+        fwrite(str.data(), 1, str.size(), stdout);
         fflush(stdout);
     }
-    for (const auto& cb : m_print_callbacks) {
-        cb(str_prefixed);
-    }
     if (m_print_to_file) {
         assert(m_fileout != nullptr);
 
@@ -337,7 +367,169 @@ void BCLog::Logger::LogPrintStr(const std::string& str)
                 m_fileout = new_fileout;
             }
         }
-        FileWriteStr(str_prefixed, m_fileout);
+        FileWriteStr(str, m_fileout);
+    }
+}
+
+/** Single producer, single consumer ring buffer of log messages */
+class BCLog::Logger::AsyncQueue
+{
+private:
+    std::vector<std::pair<uint64_t, std::string>> m_slots;
+    std::atomic<size_t> m_head{0}; //!< only written by the producer
+    std::atomic<size_t> m_tail{0}; //!< only written by the consumer
+
+public:
+    explicit AsyncQueue(size_t size) : m_slots(size) {}
+
+    bool Push(uint64_t seq, std::string&& str)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) == m_slots.size()) {
+            return false;
+        }
+        auto& slot = m_slots[head % m_slots.size()];
+        slot.first = seq;
+        slot.second = std::move(str);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    void Pop(std::vector<std::pair<uint64_t, std::string>>& out)
+    {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        const size_t head = m_head.load(std::memory_order_acquire);
+        for (; tail != head; ++tail) {
+            out.emplace_back(std::move(m_slots[tail % m_slots.size()]));
+        }
+        m_tail.store(tail, std::memory_order_release);
+    }
+
+    bool Empty() const
+    {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_relaxed);
+    }
+};
+
+/** Messages a single thread can have queued before further ones are dropped */
+static constexpr size_t ASYNC_LOG_QUEUE_SIZE = 4096;
+/** How long the writer thread sleeps when there is nothing to write */
+static constexpr auto ASYNC_LOG_IDLE_SLEEP = std::chrono::milliseconds{10};
+/** How long FlushAsyncLogging waits for the writer thread to get out of the way */
+static constexpr int ASYNC_LOG_FLUSH_ATTEMPTS = 100;
+
+static std::atomic<uint64_t> g_async_logger_id{0};
+
+bool BCLog::Logger::PushAsync(std::string&& str)
+{
+    static thread_local std::pair<uint64_t, std::shared_ptr<AsyncQueue>> t_queue;
+    if (t_queue.first != m_async_id) {
+        // first message of this thread in this run, only now a lock is needed
+        auto queue = std::make_shared<AsyncQueue>(ASYNC_LOG_QUEUE_SIZE);
+        {
+            StdLockGuard scoped_lock(m_async_queues_cs);
+            m_async_queues.emplace_back(queue);
+        }
+        t_queue = std::make_pair(m_async_id, std::move(queue));
+    }
+    return t_queue.second->Push(m_async_seq++, std::move(str));
+}
+
+size_t BCLog::Logger::DrainAsync()
+{
+    std::vector<std::shared_ptr<AsyncQueue>> queues;
+    {
+        StdLockGuard scoped_lock(m_async_queues_cs);
+        // forget queues of threads which are gone
+        m_async_queues.erase(std::remove_if(m_async_queues.begin(), m_async_queues.end(), [](const std::shared_ptr<AsyncQueue>& queue) {
+            return queue.use_count() == 1 && queue->Empty();
+        }), m_async_queues.end());
+        queues = m_async_queues;
+    }
+
+    std::vector<std::pair<uint64_t, std::string>> msgs;
+    for (const auto& queue : queues) {
+        queue->Pop(msgs);
+    }
+    const uint64_t dropped = m_async_dropped;
+    if (dropped != m_async_dropped_reported) {
+        msgs.emplace_back(std::numeric_limits<uint64_t>::max(), PrefixLogStr(strprintf("Logging queue full, %d messages dropped\n", dropped - m_async_dropped_reported)));
+        m_async_dropped_reported = dropped;
+    }
+    if (msgs.empty()) {
+        return 0;
+    }
+
+    std::sort(msgs.begin(), msgs.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    std::string batch;
+    for (const auto& msg : msgs) {
+        batch += msg.second;
+    }
+
+    StdLockGuard scoped_lock(m_cs);
+    for (const auto& msg : msgs) {
+        for (const auto& cb : m_print_callbacks) {
+            cb(msg.second);
+        }
+    }
+    WriteToOutputs(batch);
+    return msgs.size();
+}
+
+void BCLog::Logger::AsyncWriterThread()
+{
+    util::ThreadRename("logger");
+    while (!m_async_stop) {
+        size_t written;
+        {
+            StdLockGuard scoped_lock(m_async_drain_cs);
+            written = DrainAsync();
+        }
+        if (written == 0) {
+            std::this_thread::sleep_for(ASYNC_LOG_IDLE_SLEEP);
+        }
+    }
+    StdLockGuard scoped_lock(m_async_drain_cs);
+    while (DrainAsync() != 0) {}
+}
+
+void BCLog::Logger::StartAsyncLogging()
+{
+    assert(!m_async && !m_async_writer.joinable());
+    {
+        StdLockGuard scoped_lock(m_cs);
+        assert(!m_buffering);
+    }
+    m_async_id = ++g_async_logger_id;
+    m_async_stop = false;
+    m_async_writer = std::thread(&BCLog::Logger::AsyncWriterThread, this);
+    m_async = true;
+}
+
+void BCLog::Logger::StopAsyncLogging()
+{
+    if (!m_async_writer.joinable()) return;
+
+    // new messages are written synchronously from now on, wait for the ones being queued
+    m_async = false;
+    while (m_async_producers != 0) {
+        std::this_thread::yield();
+    }
+    m_async_stop = true;
+    m_async_writer.join();
+}
+
+void BCLog::Logger::FlushAsyncLogging()
+{
+    if (!m_async) return;
+
+    for (int i = 0; i < ASYNC_LOG_FLUSH_ATTEMPTS; i++) {
+        if (m_async_drain_cs.try_lock()) {
+            DrainAsync();
+            m_async_drain_cs.unlock();
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
     }
 }
 
@@ -13,14 +13,17 @@
 #include <atomic>
 #include <cstdint>
 #include <list>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 static const bool DEFAULT_LOGTIMEMICROS  = false;
 static const bool DEFAULT_LOGIPS         = false;
 static const bool DEFAULT_LOGTIMESTAMPS  = true;
 static const bool DEFAULT_LOGTHREADNAMES = false;
+static const bool DEFAULT_LOGASYNC       = false;
 extern const char * const DEFAULT_DEBUGLOGFILE;
 
 extern bool fLogThreadNames;
@@ -108,6 +111,37 @@ namespace BCLog {
         /** Slots that connect to the print signal */
         std::list<std::function<void(const std::string&)>> m_print_callbacks /* GUARDED_BY(m_cs) */ {};
 
+        /** Escape the message and prepend thread name and timestamp as configured */
+        std::string PrefixLogStr(const std::string& str);
+        /** Write to the console and the log file, reopening the file if requested */
+        void WriteToOutputs(const std::string& str) EXCLUSIVE_LOCKS_REQUIRED(m_cs);
+
+        /**
+         * Asynchronous mode: every logging thread owns a lock-free single producer
+         * ring buffer, the writer thread drains them all and writes in batches.
+         */
+        class AsyncQueue;
+        std::atomic<bool> m_async{false};
+        /** Identifies the current asynchronous run, threads register a new queue when it changes */
+        uint64_t m_async_id{0};
+        /** Orders messages of different threads */
+        std::atomic<uint64_t> m_async_seq{0};
+        /** Number of threads currently pushing into their queue, see StopAsyncLogging */
+        std::atomic<int> m_async_producers{0};
+        std::atomic<bool> m_async_stop{false};
+        std::atomic<uint64_t> m_async_dropped{0};
+        uint64_t m_async_dropped_reported{0};
+        StdMutex m_async_queues_cs;
+        std::vector<std::shared_ptr<AsyncQueue>> m_async_queues GUARDED_BY(m_async_queues_cs);
+        /** Held by whoever drains the queues, there must only be one consumer at a time */
+        StdMutex m_async_drain_cs;
+        std::thread m_async_writer;
+
+        bool PushAsync(std::string&& str);
+        /** Write out everything that is queued, returns the number of messages written */
+        size_t DrainAsync();
+        void AsyncWriterThread();
+
     public:
         bool m_print_to_console = false;
         bool m_print_to_file = false;
@@ -122,6 +156,20 @@ namespace BCLog {
         /** Send a string to the log output */
         void LogPrintStr(const std::string& str);
 
+        /**
+         * Hand messages to a writer thread instead of writing them on the calling
+         * thread. Messages which don't fit into the calling thread's queue are
+         * dropped and counted. Must be called after StartLogging.
+         */
+        void StartAsyncLogging();
+        /** Write out all queued messages and go back to synchronous logging */
+        void StopAsyncLogging();
+        /** Write out all queued messages from the calling thread, for crash handlers. Gives up if the queues can't be locked in time. */
+        void FlushAsyncLogging();
+        bool IsAsyncLogging() const { return m_async; }
+        /** Number of messages dropped because a queue was full */
+        uint64_t GetAsyncDropped() const { return m_async_dropped; }
+
         /** Returns whether logs will be written to any output */
         bool Enabled() const
         {
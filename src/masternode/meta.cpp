@@ -4,10 +4,15 @@
 
 #include <masternode/meta.h>
 
+#include <dbwrapper.h>
+#include <shutdown.h>
 #include <timedata.h>
 
 CMasternodeMetaMan mmetaman;
 
+static const std::string DB_META_INFO = "mm_I";
+static const std::string DB_DSQ_COUNT = "mm_dsq";
+
 const std::string CMasternodeMetaMan::SERIALIZATION_VERSION_STRING = "CMasternodeMetaMan-Version-3";
 
 UniValue CMasternodeMetaInfo::ToJson() const
@@ -34,13 +39,16 @@ void CMasternodeMetaInfo::AddGovernanceVote(const uint256& nGovernanceObjectHash
     // ensures the value is in the map.
     const auto& pair = mapGovernanceObjectsVotedOn.emplace(nGovernanceObjectHash, 0);
     pair.first->second++;
+    fDirty = true;
 }
 
 void CMasternodeMetaInfo::RemoveGovernanceObject(const uint256& nGovernanceObjectHash)
 {
     LOCK(cs);
     // Whether or not the govobj hash exists in the map first is irrelevant.
-    mapGovernanceObjectsVotedOn.erase(nGovernanceObjectHash);
+    if (mapGovernanceObjectsVotedOn.erase(nGovernanceObjectHash)) {
+        fDirty = true;
+    }
 }
 
 CMasternodeMetaInfoPtr CMasternodeMetaMan::GetMetaInfo(const uint256& proTxHash, bool fCreate)
@@ -50,6 +58,11 @@ CMasternodeMetaInfoPtr CMasternodeMetaMan::GetMetaInfo(const uint256& proTxHash,
     if (it != metaInfos.end()) {
         return it->second;
     }
+    if (CMasternodeMetaInfo info; m_db != nullptr && m_db->Read(std::make_pair(DB_META_INFO, proTxHash), info)) {
+        it = metaInfos.emplace(proTxHash, std::make_shared<CMasternodeMetaInfo>(info)).first;
+        it->second->fDirty = false;
+        return it->second;
+    }
     if (!fCreate) {
         return nullptr;
     }
@@ -77,12 +90,14 @@ void CMasternodeMetaMan::AllowMixing(const uint256& proTxHash)
     nDsqCount++;
     mm->nLastDsq = nDsqCount.load();
     mm->nMixingTxCount = 0;
+    mm->fDirty = true;
 }
 
 void CMasternodeMetaMan::DisallowMixing(const uint256& proTxHash)
 {
     auto mm = GetMetaInfo(proTxHash);
     mm->nMixingTxCount++;
+    mm->fDirty = true;
 }
 
 bool CMasternodeMetaMan::AddGovernanceVote(const uint256& proTxHash, const uint256& nGovernanceObjectHash)
@@ -98,6 +113,9 @@ void CMasternodeMetaMan::RemoveGovernanceObject(const uint256& nGovernanceObject
     for(const auto& p : metaInfos) {
         p.second->RemoveGovernanceObject(nGovernanceObjectHash);
     }
+    if (m_db != nullptr) {
+        setRemovedGovernanceObjects.emplace(nGovernanceObjectHash);
+    }
 }
 
 std::vector<uint256> CMasternodeMetaMan::GetAndClearDirtyGovernanceObjectHashes()
@@ -113,6 +131,89 @@ void CMasternodeMetaMan::Clear()
     LOCK(cs);
     metaInfos.clear();
     vecDirtyGovernanceObjectHashes.clear();
+    setRemovedGovernanceObjects.clear();
+    if (m_db == nullptr) {
+        return;
+    }
+
+    CDBBatch batch(*m_db);
+    std::unique_ptr<CDBIterator> it(m_db->NewIterator());
+    std::pair<std::string, uint256> key;
+    for (it->Seek(DB_META_INFO); it->Valid() && it->GetKey(key) && key.first == DB_META_INFO; it->Next()) {
+        batch.Erase(key);
+    }
+    batch.Erase(DB_DSQ_COUNT);
+    m_db->WriteBatch(batch);
+}
+
+void CMasternodeMetaMan::ConnectCacheDB(CDBWrapper& db)
+{
+    {
+        LOCK(cs);
+        m_db = &db;
+        int64_t nStoredDsqCount{0};
+        if (db.Read(DB_DSQ_COUNT, nStoredDsqCount) && nStoredDsqCount > nDsqCount) {
+            nDsqCount = nStoredDsqCount;
+        }
+    }
+    // Keep the meta infos imported from the flat file of older versions
+    FlushCacheDB();
+}
+
+void CMasternodeMetaMan::FlushCacheDB()
+{
+    LOCK(cs);
+    if (m_db == nullptr) {
+        return;
+    }
+
+    CDBBatch batch(*m_db);
+    size_t nWritten{0};
+    for (const auto& [proTxHash, mm] : metaInfos) {
+        if (mm->fDirty.exchange(false)) {
+            batch.Write(std::make_pair(DB_META_INFO, proTxHash), *mm);
+            nWritten++;
+        }
+    }
+
+    // Meta infos which are not in memory still refer to removed governance objects
+    if (!setRemovedGovernanceObjects.empty()) {
+        std::unique_ptr<CDBIterator> it(m_db->NewIterator());
+        std::pair<std::string, uint256> key;
+        for (it->Seek(DB_META_INFO); it->Valid() && it->GetKey(key) && key.first == DB_META_INFO; it->Next()) {
+            CMasternodeMetaInfo info;
+            if (metaInfos.count(key.second) || !it->GetValue(info)) {
+                continue;
+            }
+            info.fDirty = false;
+            for (const auto& hash : setRemovedGovernanceObjects) {
+                info.RemoveGovernanceObject(hash);
+            }
+            if (info.fDirty) {
+                batch.Write(key, info);
+                nWritten++;
+            }
+        }
+        setRemovedGovernanceObjects.clear();
+    }
+
+    batch.Write(DB_DSQ_COUNT, nDsqCount.load());
+    m_db->WriteBatch(batch);
+    LogPrint(BCLog::MNSYNC, "CMasternodeMetaMan::%s -- wrote %d meta infos\n", __func__, nWritten);
+}
+
+void CMasternodeMetaMan::DisconnectCacheDB()
+{
+    FlushCacheDB();
+    LOCK(cs);
+    m_db = nullptr;
+}
+
+void CMasternodeMetaMan::DoMaintenance()
+{
+    if (ShutdownRequested()) return;
+
+    FlushCacheDB();
 }
 
 std::string CMasternodeMetaMan::ToString() const
@@ -10,10 +10,12 @@
 #include <univalue.h>
 
 #include <atomic>
+#include <set>
 #include <uint256.h>
 #include <sync.h>
 
 class CConnman;
+class CDBWrapper;
 
 static constexpr int MASTERNODE_MAX_MIXING_TXES{5};
 static constexpr int MASTERNODE_MAX_FAILED_OUTBOUND_ATTEMPTS{5};
@@ -40,6 +42,9 @@ private:
     std::atomic<int64_t> lastOutboundAttempt{0};
     std::atomic<int64_t> lastOutboundSuccess{0};
 
+    // changed since it was last written to the cache database
+    std::atomic<bool> fDirty{true};
+
 public:
     CMasternodeMetaInfo() = default;
     explicit CMasternodeMetaInfo(const uint256& _proTxHash) : proTxHash(_proTxHash) {}
@@ -48,6 +53,7 @@ public:
         nLastDsq(ref.nLastDsq.load()),
         nMixingTxCount(ref.nMixingTxCount.load()),
         mapGovernanceObjectsVotedOn(ref.mapGovernanceObjectsVotedOn),
+        outboundAttemptCount(ref.outboundAttemptCount.load()),
         lastOutboundAttempt(ref.lastOutboundAttempt.load()),
         lastOutboundSuccess(ref.lastOutboundSuccess.load())
     {
@@ -82,9 +88,9 @@ public:
     void RemoveGovernanceObject(const uint256& nGovernanceObjectHash);
 
     bool OutboundFailedTooManyTimes() const { return outboundAttemptCount > MASTERNODE_MAX_FAILED_OUTBOUND_ATTEMPTS; }
-    void SetLastOutboundAttempt(int64_t t) { lastOutboundAttempt = t; ++outboundAttemptCount; }
+    void SetLastOutboundAttempt(int64_t t) { lastOutboundAttempt = t; ++outboundAttemptCount; fDirty = true; }
     int64_t GetLastOutboundAttempt() const { return lastOutboundAttempt; }
-    void SetLastOutboundSuccess(int64_t t) { lastOutboundSuccess = t; outboundAttemptCount = 0; }
+    void SetLastOutboundSuccess(int64_t t) { lastOutboundSuccess = t; outboundAttemptCount = 0; fDirty = true; }
     int64_t GetLastOutboundSuccess() const { return lastOutboundSuccess; }
 };
 using CMasternodeMetaInfoPtr = std::shared_ptr<CMasternodeMetaInfo>;
@@ -102,6 +108,11 @@ private:
     // keep track of dsq count to prevent masternodes from gaming coinjoin queue
     std::atomic<int64_t> nDsqCount{0};
 
+    // meta infos are loaded from here on first use and written back by FlushCacheDB
+    CDBWrapper* m_db GUARDED_BY(cs){nullptr};
+    // removed governance objects which still have to be removed from the stored meta infos
+    std::set<uint256> setRemovedGovernanceObjects GUARDED_BY(cs);
+
 public:
     template<typename Stream>
     void Serialize(Stream &s) const
@@ -146,10 +157,23 @@ public:
 
     std::vector<uint256> GetAndClearDirtyGovernanceObjectHashes();
 
+    /** Clear all meta infos, including the ones stored in the cache database */
     void Clear();
     // Needed to avoid errors in flat-database.h
     void CheckAndRemove() const {};
 
+    /**
+     * Store the meta infos in db from now on. The meta infos in memory, e.g. imported
+     * from an old mncache.dat, are written to it, the others are only loaded on first use.
+     */
+    void ConnectCacheDB(CDBWrapper& db);
+    /** Write the meta infos changed since the last flush to the cache database */
+    void FlushCacheDB();
+    /** Flush and stop using the database set by ConnectCacheDB */
+    void DisconnectCacheDB();
+
+    void DoMaintenance();
+
     std::string ToString() const;
 };
 
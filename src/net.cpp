@@ -593,6 +593,10 @@ void CNode::copyStats(CNodeStats &stats, const std::vector<bool> &m_asmap)
         X(mapRecvBytesPerMsgCmd);
         X(nRecvBytes);
     }
+    {
+        LOCK(cs_msgCost);
+        X(mapCostPerMsgCmd);
+    }
     X(m_legacyWhitelisted);
     X(m_permissionFlags);
 
@@ -663,6 +667,12 @@ bool CNode::ReceiveMsgBytes(const char *pch, unsigned int nBytes, bool& complete
     return true;
 }
 
+void CNode::RecordMsgCost(const std::string& command, const CNetMsgCost& cost)
+{
+    LOCK(cs_msgCost);
+    mapCostPerMsgCmd[command] += cost;
+}
+
 void CNode::SetSendVersion(int nVersionIn)
 {
     // Send version may only be changed in the version message, and
@@ -3609,6 +3619,18 @@ uint64_t CConnman::GetTotalBytesSent()
     return nTotalBytesSent;
 }
 
+void CConnman::RecordMsgCost(const std::string& command, const CNetMsgCost& cost)
+{
+    LOCK(cs_msgCost);
+    mapMsgCost[command] += cost;
+}
+
+mapMsgCmdCost CConnman::GetMsgCostStats() const
+{
+    LOCK(cs_msgCost);
+    return mapMsgCost;
+}
+
 ServiceFlags CConnman::GetLocalServices() const
 {
     return nLocalServices;
@@ -27,6 +27,7 @@
 #include <util/system.h>
 #include <consensus/params.h>
 
+#include <algorithm>
 #include <atomic>
 #include <deque>
 #include <stdint.h>
@@ -131,6 +132,27 @@ struct CSerializedNetMsg
 };
 
 
+/** Time spent processing messages of one command, all times in microseconds */
+struct CNetMsgCost
+{
+    uint64_t nCount{0};
+    int64_t nProcessTime{0};     //!< wall clock time spent in ProcessMessage
+    int64_t nCPUTime{0};         //!< CPU time of the message handler thread spent in ProcessMessage
+    int64_t nQueueTime{0};       //!< time between receiving a message and starting to process it
+    int64_t nMaxProcessTime{0};  //!< longest time a single message took to process
+
+    CNetMsgCost& operator+=(const CNetMsgCost& other)
+    {
+        nCount += other.nCount;
+        nProcessTime += other.nProcessTime;
+        nCPUTime += other.nCPUTime;
+        nQueueTime += other.nQueueTime;
+        nMaxProcessTime = std::max(nMaxProcessTime, other.nMaxProcessTime);
+        return *this;
+    }
+};
+typedef std::map<std::string, CNetMsgCost> mapMsgCmdCost; //command, processing cost
+
 class NetEventsInterface;
 class CConnman
 {
@@ -458,6 +480,11 @@ public:
     uint64_t GetTotalBytesRecv();
     uint64_t GetTotalBytesSent();
 
+    //! account the processing cost of a message, see CNode::RecordMsgCost
+    void RecordMsgCost(const std::string& command, const CNetMsgCost& cost);
+    //! processing cost per command of all messages received since startup
+    mapMsgCmdCost GetMsgCostStats() const;
+
     void SetBestHeight(int height);
     int GetBestHeight() const;
 
@@ -553,6 +580,10 @@ private:
     uint64_t nTotalBytesRecv GUARDED_BY(cs_totalBytesRecv) {0};
     uint64_t nTotalBytesSent GUARDED_BY(cs_totalBytesSent) {0};
 
+    // Message processing cost of all peers, including disconnected ones
+    mutable CCriticalSection cs_msgCost;
+    mapMsgCmdCost mapMsgCost GUARDED_BY(cs_msgCost);
+
     // outbound limit & stats
     uint64_t nMaxOutboundTotalBytesSentInCycle GUARDED_BY(cs_totalBytesSent);
     uint64_t nMaxOutboundCycleStartTime GUARDED_BY(cs_totalBytesSent);
@@ -775,6 +806,7 @@ public:
     mapMsgCmdSize mapSendBytesPerMsgCmd;
     uint64_t nRecvBytes;
     mapMsgCmdSize mapRecvBytesPerMsgCmd;
+    mapMsgCmdCost mapCostPerMsgCmd;
     NetPermissionFlags m_permissionFlags;
     bool m_legacyWhitelisted;
     int64_t m_ping_usec;
@@ -1002,6 +1034,8 @@ public:
 protected:
     mapMsgCmdSize mapSendBytesPerMsgCmd;
     mapMsgCmdSize mapRecvBytesPerMsgCmd GUARDED_BY(cs_vRecv);
+    mutable CCriticalSection cs_msgCost;
+    mapMsgCmdCost mapCostPerMsgCmd GUARDED_BY(cs_msgCost);
 
 public:
     uint256 hashContinue;
@@ -1033,6 +1067,16 @@ public:
     std::vector<uint256> vBlockHashesToAnnounce GUARDED_BY(cs_inventory);
     // Used for BIP35 mempool sending, also protected by cs_inventory
     bool fSendMempool GUARDED_BY(cs_inventory){false};
+    // Set while the peer has a bloom filter loaded. Tx inventory is then
+    // queued in vInventoryTxToMatch and only moved to setInventoryTxToSend
+    // by CFilterMatcher once it matched the filter.
+    bool fRelayFilterLoaded GUARDED_BY(cs_inventory){false};
+    std::vector<uint256> vInventoryTxToMatch GUARDED_BY(cs_inventory);
+    // BIP35 mempool request waiting to be matched against the filter
+    bool fMatchMempool GUARDED_BY(cs_inventory){false};
+    // Result of a matched BIP35 mempool request, sent like fSendMempool
+    bool fSendMempoolMatched GUARDED_BY(cs_inventory){false};
+    std::vector<uint256> vInventoryMempoolMatched GUARDED_BY(cs_inventory);
 
     /** UNIX epoch time of the last block received from this peer that we had
      * not yet seen (e.g. not already received from another peer), that passed
@@ -1138,6 +1182,9 @@ public:
 
     bool ReceiveMsgBytes(const char *pch, unsigned int nBytes, bool& complete);
 
+    //! add the processing cost of a received message to the per-command totals of this peer
+    void RecordMsgCost(const std::string& command, const CNetMsgCost& cost);
+
     void SetRecvVersion(int nVersionIn)
     {
         nRecvVersion = nVersionIn;
@@ -1215,7 +1262,11 @@ public:
         if (inv.type == MSG_TX || inv.type == MSG_DSTX) {
             if (!filterInventoryKnown.contains(inv.hash)) {
                 LogPrint(BCLog::NET, "%s -- adding new inv: %s peer=%d\n", __func__, inv.ToString(), id);
-                setInventoryTxToSend.insert(inv.hash);
+                if (fRelayFilterLoaded) {
+                    vInventoryTxToMatch.push_back(inv.hash);
+                } else {
+                    setInventoryTxToSend.insert(inv.hash);
+                }
             } else {
                 LogPrint(BCLog::NET, "%s -- skipping known inv: %s peer=%d\n", __func__, inv.ToString(), id);
             }
@@ -0,0 +1,132 @@
+// Copyright (c) 2026 The PirateCash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <net_filtermatcher.h>
+
+#include <bloom.h>
+#include <logging.h>
+#include <net.h>
+#include <txmempool.h>
+#include <util/system.h>
+#include <util/time.h>
+
+#include <utility>
+
+CFilterMatcher::CFilterMatcher(CConnman& _connman, CTxMemPool& _mempool) :
+    connman(_connman),
+    mempool(_mempool)
+{
+}
+
+CFilterMatcher::~CFilterMatcher()
+{
+    Stop();
+}
+
+void CFilterMatcher::Start()
+{
+    int workerCount = std::thread::hardware_concurrency() / 2;
+    workerCount = std::max(1, std::min(workerCount, 4));
+    workerPool.resize(workerCount);
+    RenameThreadPool(workerPool, "filter-match");
+}
+
+void CFilterMatcher::Stop()
+{
+    WITH_LOCK(cs, fStopped = true);
+    // queued tasks still run, they hold references to their peers
+    workerPool.stop(true);
+}
+
+void CFilterMatcher::ProcessPending()
+{
+    LOCK(cs);
+    if (fStopped) {
+        return;
+    }
+
+    size_t nQueued{0};
+    connman.ForEachNode([&](CNode* pnode) {
+        {
+            LOCK(pnode->cs_inventory);
+            if (pnode->vInventoryTxToMatch.empty() && !pnode->fMatchMempool) {
+                return;
+            }
+        }
+        // whatever was queued meanwhile is picked up by the next run after the running task
+        if (!setPeersInProgress.emplace(pnode->GetId()).second) {
+            return;
+        }
+        pnode->AddRef();
+        workerPool.push([this, pnode](int threadId) {
+            MatchPeer(*pnode);
+            WITH_LOCK(cs, setPeersInProgress.erase(pnode->GetId()));
+            pnode->Release();
+        });
+        nQueued++;
+    });
+
+    if (nQueued > 0) {
+        LogPrint(BCLog::NET, "CFilterMatcher::%s -- queued inventory of %d peers\n", __func__, nQueued);
+    }
+}
+
+void CFilterMatcher::MatchPeer(CNode& node)
+{
+    int64_t nStart = GetTimeMicros();
+
+    std::vector<uint256> vToMatch;
+    bool fMempool;
+    {
+        LOCK(node.cs_inventory);
+        vToMatch.swap(node.vInventoryTxToMatch);
+        // a mempool request arriving while we match is matched by the next run
+        fMempool = std::exchange(node.fMatchMempool, false);
+    }
+
+    // Transactions which left the mempool in the meantime are not announced anymore
+    std::vector<CTransactionRef> vtx;
+    vtx.reserve(vToMatch.size());
+    for (const uint256& hash : vToMatch) {
+        auto tx = mempool.get(hash);
+        if (tx) {
+            vtx.emplace_back(std::move(tx));
+        }
+    }
+    std::vector<TxMempoolInfo> vMempoolInfo;
+    if (fMempool) {
+        vMempoolInfo = mempool.infoAll();
+    }
+
+    std::vector<uint256> vMatched;
+    std::vector<uint256> vMempoolMatched;
+    {
+        LOCK(node.cs_filter);
+        // The filter might have been cleared since the transactions were queued,
+        // in which case everything matches
+        for (const auto& tx : vtx) {
+            if (!node.pfilter || node.pfilter->IsRelevantAndUpdate(*tx)) {
+                vMatched.emplace_back(tx->GetHash());
+            }
+        }
+        for (const auto& txinfo : vMempoolInfo) {
+            if (!node.pfilter || node.pfilter->IsRelevantAndUpdate(*txinfo.tx)) {
+                vMempoolMatched.emplace_back(txinfo.tx->GetHash());
+            }
+        }
+    }
+
+    LOCK(node.cs_inventory);
+    for (const uint256& hash : vMatched) {
+        if (!node.filterInventoryKnown.contains(hash)) {
+            node.setInventoryTxToSend.insert(hash);
+        }
+    }
+    if (fMempool) {
+        node.vInventoryMempoolMatched = std::move(vMempoolMatched);
+        node.fSendMempoolMatched = true;
+    }
+
+    LogPrint(BCLog::NET, "CFilterMatcher::%s -- matched %d transactions for peer=%d in %dus\n", __func__, vtx.size() + vMempoolInfo.size(), node.GetId(), GetTimeMicros() - nStart);
+}
@@ -0,0 +1,54 @@
+// Copyright (c) 2026 The PirateCash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_NET_FILTERMATCHER_H
+#define BITCOIN_NET_FILTERMATCHER_H
+
+#include <ctpl_stl.h>
+#include <net.h>
+#include <sync.h>
+
+#include <set>
+
+class CTxMemPool;
+
+/** Interval at which queued transactions are matched against peer filters */
+static const int64_t FILTER_MATCH_INTERVAL_MS = 100;
+
+/**
+ * Matches queued transactions and BIP35 mempool requests against the bloom
+ * filters loaded by SPV peers (BIP37) on a worker pool. SendMessages then only
+ * has to drain the already matched inventory and never runs a filter itself.
+ *
+ * A peer is only ever handled by one task at a time, so transactions still
+ * update a filter in the order in which they were queued for that peer.
+ */
+class CFilterMatcher
+{
+private:
+    CConnman& connman;
+    CTxMemPool& mempool;
+    ctpl::thread_pool workerPool;
+
+    Mutex cs;
+    bool fStopped GUARDED_BY(cs){false};
+    //! peers with a matching task queued or running
+    std::set<NodeId> setPeersInProgress GUARDED_BY(cs);
+
+public:
+    CFilterMatcher(CConnman& _connman, CTxMemPool& _mempool);
+    ~CFilterMatcher();
+
+    void Start();
+    /** Finish all queued tasks, must be called before the peers are deleted */
+    void Stop();
+
+    /** Queue matching tasks for all peers with pending inventory, doesn't wait for them */
+    void ProcessPending();
+
+    /** Match everything queued for a peer against its filter on the calling thread */
+    void MatchPeer(CNode& node);
+};
+
+#endif // BITCOIN_NET_FILTERMATCHER_H
@@ -37,6 +37,7 @@
 #include <util/validation.h>
 
 #include <memory>
+#include <unordered_map>
 
 #include <spork.h>
 #include <governance/governance.h>
@@ -318,6 +319,8 @@ struct CNodeState {
 
     //! Headers from the last message
     std::deque<CBlockHeader> vPostponedHeaders;
+    //! Results of PrecheckBlockHeaders for vPostponedHeaders
+    std::deque<CBlockHeaderPrecheck> vPostponedPrechecks;
 
     /** State used to enforce CHAIN_SYNC_TIMEOUT
       * Only in effect for outbound, non-manual connections, with
@@ -1234,6 +1237,19 @@ PeerLogicValidation::PeerLogicValidation(CConnman* connmanIn, BanMan* banman, CS
     // timer.
     static_assert(EXTRA_PEER_CHECK_INTERVAL < STALE_CHECK_INTERVAL, "peer eviction timer should be less than stale tip check timer");
     scheduler.scheduleEvery(std::bind(&PeerLogicValidation::CheckForStaleTipAndEvictPeers, this, consensusParams), EXTRA_PEER_CHECK_INTERVAL * 1000);
+
+    if (connman) {
+        m_filter_matcher = std::make_unique<CFilterMatcher>(*connman, mempool);
+        m_filter_matcher->Start();
+        scheduler.scheduleEvery(std::bind(&CFilterMatcher::ProcessPending, m_filter_matcher.get()), FILTER_MATCH_INTERVAL_MS);
+    }
+}
+
+void PeerLogicValidation::StopFilterMatcher()
+{
+    if (m_filter_matcher) {
+        m_filter_matcher->Stop();
+    }
 }
 
 /**
@@ -1629,10 +1645,9 @@ void static ProcessGetBlockData(CNode* pfrom, const CChainParams& chainparams, c
             pblock = a_recent_block;
         } else {
             // Send block from disk
-            std::shared_ptr<CBlock> pblockRead = std::make_shared<CBlock>();
-            if (!ReadBlockFromDisk(*pblockRead, pindex, consensusParams))
+            pblock = ReadSharedBlockFromDisk(pindex, consensusParams);
+            if (!pblock)
                 assert(!"cannot load block from disk");
-            pblock = pblockRead;
         }
         if (pblock) {
             if (inv.type == MSG_BLOCK)
@@ -1917,6 +1932,9 @@ bool static ProcessHeadersMessage(CNode *pfrom, CConnman *connman, std::deque<CB
     const CBlockIndex *pindexLast = nullptr;
     const CBlockIndex *pindexPrev = NULL;
     bool get_more_headers = headers.size() == MAX_HEADERS_RESULTS;
+    // Postponed headers come with their prechecks, new ones get them once they are known to connect
+    std::deque<CBlockHeaderPrecheck> prechecks;
+    size_t nFirstUnknown;
     {
         LOCK(cs_main);
         CNodeState *nodestate = State(pfrom->GetId());
@@ -1926,11 +1944,15 @@ bool static ProcessHeadersMessage(CNode *pfrom, CConnman *connman, std::deque<CB
                 LogPrint(BCLog::NET, "New headers while having postponed headers from %d\n", pfrom->GetId());
             }
             nodestate->vPostponedHeaders.swap(headers);
+            nodestate->vPostponedPrechecks.swap(prechecks);
             get_more_headers = true; // force any way
         } else if (headers.size() == 0) {
             // Nothing interesting. Stop asking this peers for more headers.
             return true;
         }
+        if (prechecks.size() != headers.size()) {
+            prechecks.assign(headers.size(), CBlockHeaderPrecheck());
+        }
 
         auto prev_iter = ::BlockIndex().find(headers[0].hashPrevBlock);
         pindexPrev = (prev_iter == ::BlockIndex().end()) ? nullptr : prev_iter->second;
@@ -1968,12 +1990,25 @@ bool static ProcessHeadersMessage(CNode *pfrom, CConnman *connman, std::deque<CB
         }
 
         uint256 hashLastBlock;
-        for (const CBlockHeader& header : headers) {
-            if (!hashLastBlock.IsNull() && header.hashPrevBlock != hashLastBlock) {
+        for (size_t i = 0; i < headers.size(); i++) {
+            if (!hashLastBlock.IsNull() && headers[i].hashPrevBlock != hashLastBlock) {
                 Misbehaving(pfrom->GetId(), 20, "non-continuous headers sequence");
                 return false;
             }
-            hashLastBlock = header.GetHash();
+            if (prechecks[i].hash.IsNull()) {
+                prechecks[i].hash = headers[i].GetHash();
+            }
+            hashLastBlock = prechecks[i].hash;
+        }
+
+        // Headers we already have are only looked up by hash. A batch which doesn't connect fails on its first
+        // header, so there is nothing worth prechecking in it.
+        nFirstUnknown = 0;
+        if (pindexPrev == nullptr) {
+            nFirstUnknown = headers.size();
+        }
+        while (nFirstUnknown < headers.size() && LookupBlockIndex(prechecks[nFirstUnknown].hash)) {
+            nFirstUnknown++;
         }
 
         // If we don't have the last header, then they'll have given us
@@ -1983,9 +2018,13 @@ bool static ProcessHeadersMessage(CNode *pfrom, CConnman *connman, std::deque<CB
         }
     }
 
+    // Recover the PoS block signers and compute the scrypt hashes of the new headers in parallel before taking
+    // cs_main again, but only for those which are going to be processed now. The rest is postponed.
+    PrecheckBlockHeaders(headers, prechecks, nFirstUnknown, std::max<size_t>(nFirstUnknown, std::min<size_t>(headers.size(), MAX_NEW_HEADER_BURST)));
+
     CValidationState state;
     CBlockHeader first_invalid_header;
-    if (!ProcessNewBlockHeaders(headers, state, chainparams, &pindexLast, &first_invalid_header, MAX_NEW_HEADER_BURST)) {
+    if (!ProcessNewBlockHeaders(headers, prechecks, state, chainparams, &pindexLast, &first_invalid_header, MAX_NEW_HEADER_BURST)) {
         int nDoS;
         if (state.IsInvalid(nDoS)) {
             LOCK(cs_main);
@@ -2072,6 +2111,7 @@ bool static ProcessHeadersMessage(CNode *pfrom, CConnman *connman, std::deque<CB
             LogPrint(BCLog::NET, "peer %d sent us more headers while we were processing current postponed \n", pfrom->GetId());
         } else if (!headers.empty()) {
             nodestate->vPostponedHeaders.swap(headers);
+            nodestate->vPostponedPrechecks.swap(prechecks);
             LogPrint(BCLog::NET, "saving postponed headers for peer %d \n", pfrom->GetId());
         } else if (get_more_headers) {
             // If nCount=0 - then we are in postponed headers situation, try to get more.
@@ -2321,8 +2361,9 @@ static void ProcessGetCFilters(CNode& peer, CDataStream& vRecv, const CChainPara
         return;
     }
 
-    std::vector<BlockFilter> filters;
-    if (!filter_index->LookupFilterRange(start_height, stop_index, filters)) {
+    // The filters are relayed as stored, there is no need to decode them
+    std::vector<EncodedBlockFilter> filters;
+    if (!filter_index->LookupEncodedFilterRange(start_height, stop_index, filters)) {
         LogPrint(BCLog::NET, "Failed to find block filter in index: filter_type=%s, start_height=%d, stop_hash=%s\n",
                      BlockFilterTypeName(filter_type), start_height, stop_hash.ToString());
         return;
@@ -2330,7 +2371,7 @@ static void ProcessGetCFilters(CNode& peer, CDataStream& vRecv, const CChainPara
 
     for (const auto& filter : filters) {
         CSerializedNetMsg msg = CNetMsgMaker(peer.GetSendVersion())
-            .Make(NetMsgType::CFILTER, filter);
+            .Make(NetMsgType::CFILTER, filter_type_ser, filter.block_hash, filter.encoded_filter);
         connman.PushMessage(&peer, std::move(msg));
     }
 }
@@ -2418,19 +2459,11 @@ static void ProcessGetCFCheckPt(CNode& peer, CDataStream& vRecv, const CChainPar
         return;
     }
 
-    std::vector<uint256> headers(stop_index->nHeight / CFCHECKPT_INTERVAL);
-
-    // Populate headers.
-    const CBlockIndex* block_index = stop_index;
-    for (int i = headers.size() - 1; i >= 0; i--) {
-        int height = (i + 1) * CFCHECKPT_INTERVAL;
-        block_index = block_index->GetAncestor(height);
-
-        if (!filter_index->LookupFilterHeader(block_index, headers[i])) {
-            LogPrint(BCLog::NET, "Failed to find block filter header in index: filter_type=%s, block_hash=%s\n",
-                         BlockFilterTypeName(filter_type), block_index->GetBlockHash().ToString());
-            return;
-        }
+    std::vector<uint256> headers;
+    if (!filter_index->LookupCheckpointHeaders(stop_index, headers)) {
+        LogPrint(BCLog::NET, "Failed to find block filter checkpoint headers in index: filter_type=%s, stop_hash=%s\n",
+                     BlockFilterTypeName(filter_type), stop_hash.ToString());
+        return;
     }
 
     CSerializedNetMsg msg = CNetMsgMaker(peer.GetSendVersion())
@@ -2508,6 +2541,76 @@ std::pair<bool /*ret*/, bool /*do_return*/> static ValidateDSTX(CCoinJoinBroadca
     return {true, false};
 }
 
+/** Handler of a message which is processed outside of net_processing */
+typedef void (*NetMsgHandler)(CNode* pfrom, const std::string& strCommand, CDataStream& vRecv, CConnman& connman, bool enable_bip61);
+
+static void ProcessCoinJoinMessage(CNode* pfrom, const std::string& strCommand, CDataStream& vRecv, CConnman& connman, bool enable_bip61)
+{
+#ifdef ENABLE_WALLET
+    coinJoinClientQueueManager.ProcessMessage(pfrom, strCommand, vRecv, connman, enable_bip61);
+    for (auto& pair : coinJoinClientManagers) {
+        pair.second->ProcessMessage(pfrom, strCommand, vRecv, connman, enable_bip61);
+    }
+#endif // ENABLE_WALLET
+    coinJoinServer.ProcessMessage(pfrom, strCommand, vRecv, connman, enable_bip61);
+}
+
+/**
+ * Maps every known command to the subsystem which handles it. Commands handled by
+ * ProcessMessage itself map to nullptr, unknown commands are not in the table.
+ */
+static const std::unordered_map<std::string, NetMsgHandler>& GetNetMsgHandlers()
+{
+    static const std::unordered_map<std::string, NetMsgHandler> mapHandlers = [] {
+        std::unordered_map<std::string, NetMsgHandler> ret;
+        for (const std::string& msg : getAllNetMessageTypes()) {
+            ret.emplace(msg, nullptr);
+        }
+        auto add = [&ret](std::initializer_list<const char*> commands, NetMsgHandler handler) {
+            for (const char* command : commands) {
+                ret[command] = handler;
+            }
+        };
+        add({NetMsgType::DSACCEPT, NetMsgType::DSQUEUE, NetMsgType::DSVIN, NetMsgType::DSSIGNFINALTX,
+             NetMsgType::DSSTATUSUPDATE, NetMsgType::DSFINALTX, NetMsgType::DSCOMPLETE}, ProcessCoinJoinMessage);
+        add({NetMsgType::SPORK, NetMsgType::GETSPORKS}, [](CNode* pfrom, const std::string& strCommand, CDataStream& vRecv, CConnman& connman, bool) {
+            sporkManager.ProcessSporkMessages(pfrom, strCommand, vRecv, connman);
+        });
+        add({NetMsgType::SYNCSTATUSCOUNT}, [](CNode* pfrom, const std::string& strCommand, CDataStream& vRecv, CConnman&, bool) {
+            masternodeSync.ProcessMessage(pfrom, strCommand, vRecv);
+        });
+        add({NetMsgType::MNGOVERNANCESYNC, NetMsgType::MNGOVERNANCEOBJECT, NetMsgType::MNGOVERNANCEOBJECTVOTE}, [](CNode* pfrom, const std::string& strCommand, CDataStream& vRecv, CConnman& connman, bool enable_bip61) {
+            governance.ProcessMessage(pfrom, strCommand, vRecv, connman, enable_bip61);
+        });
+        add({NetMsgType::MNAUTH}, [](CNode* pfrom, const std::string& strCommand, CDataStream& vRecv, CConnman& connman, bool) {
+            CMNAuth::ProcessMessage(pfrom, strCommand, vRecv, connman);
+        });
+        add({NetMsgType::QFCOMMITMENT}, [](CNode* pfrom, const std::string& strCommand, CDataStream& vRecv, CConnman&, bool) {
+            llmq::quorumBlockProcessor->ProcessMessage(pfrom, strCommand, vRecv);
+        });
+        add({NetMsgType::QCONTRIB, NetMsgType::QCOMPLAINT, NetMsgType::QJUSTIFICATION, NetMsgType::QPCOMMITMENT, NetMsgType::QWATCH}, [](CNode* pfrom, const std::string& strCommand, CDataStream& vRecv, CConnman&, bool) {
+            llmq::quorumDKGSessionManager->ProcessMessage(pfrom, strCommand, vRecv);
+        });
+        add({NetMsgType::QGETDATA, NetMsgType::QDATA}, [](CNode* pfrom, const std::string& strCommand, CDataStream& vRecv, CConnman&, bool) {
+            llmq::quorumManager->ProcessMessage(pfrom, strCommand, vRecv);
+        });
+        add({NetMsgType::QSIGSHARE, NetMsgType::QSIGSESANN, NetMsgType::QSIGSHARESINV, NetMsgType::QGETSIGSHARES, NetMsgType::QBSIGSHARES}, [](CNode* pfrom, const std::string& strCommand, CDataStream& vRecv, CConnman&, bool) {
+            llmq::quorumSigSharesManager->ProcessMessage(pfrom, strCommand, vRecv);
+        });
+        add({NetMsgType::QSIGREC}, [](CNode* pfrom, const std::string& strCommand, CDataStream& vRecv, CConnman&, bool) {
+            llmq::quorumSigningManager->ProcessMessage(pfrom, strCommand, vRecv);
+        });
+        add({NetMsgType::CLSIG}, [](CNode* pfrom, const std::string& strCommand, CDataStream& vRecv, CConnman&, bool) {
+            llmq::chainLocksHandler->ProcessMessage(pfrom, strCommand, vRecv);
+        });
+        add({NetMsgType::ISLOCK, NetMsgType::ISDLOCK}, [](CNode* pfrom, const std::string& strCommand, CDataStream& vRecv, CConnman&, bool) {
+            llmq::quorumInstantSendManager->ProcessMessage(pfrom, strCommand, vRecv);
+        });
+        return ret;
+    }();
+    return mapHandlers;
+}
+
 bool static ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStream& vRecv, int64_t nTimeReceived, const CChainParams& chainparams, CConnman* connman, const std::atomic<bool>& interruptMsgProc, bool enable_bip61)
 {
     LogPrint(BCLog::NET, "received: %s (%u bytes) peer=%d\n", SanitizeString(strCommand), vRecv.size(), pfrom->GetId());
@@ -2844,6 +2947,15 @@ bool static ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStr
         }
     }
 
+    // Messages of the masternode, governance, CoinJoin and LLMQ subsystems don't
+    // need to walk the chain of core commands below
+    const auto& mapHandlers = GetNetMsgHandlers();
+    const auto handler_it = mapHandlers.find(strCommand);
+    if (handler_it != mapHandlers.end() && handler_it->second != nullptr) {
+        handler_it->second(pfrom, strCommand, vRecv, *connman, enable_bip61);
+        return true;
+    }
+
     if (strCommand == NetMsgType::ADDR || strCommand == NetMsgType::ADDRV2) {
         int stream_version = vRecv.GetVersion();
         if (strCommand == NetMsgType::ADDRV2) {
@@ -3884,7 +3996,11 @@ bool static ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStr
         }
 
         LOCK(pfrom->cs_inventory);
-        pfrom->fSendMempool = true;
+        if (pfrom->fRelayFilterLoaded) {
+            pfrom->fMatchMempool = true;
+        } else {
+            pfrom->fSendMempool = true;
+        }
         return true;
     }
 
@@ -3974,10 +4090,18 @@ bool static ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStr
         }
         else
         {
-            LOCK(pfrom->cs_filter);
+            LOCK2(pfrom->cs_inventory, pfrom->cs_filter);
             pfrom->pfilter.reset(new CBloomFilter(filter));
             pfrom->pfilter->UpdateEmptyFull();
             pfrom->fRelayTxes = true;
+            // Everything not announced yet has to go through the new filter first
+            pfrom->fRelayFilterLoaded = true;
+            pfrom->vInventoryTxToMatch.insert(pfrom->vInventoryTxToMatch.end(), pfrom->setInventoryTxToSend.begin(), pfrom->setInventoryTxToSend.end());
+            pfrom->setInventoryTxToSend.clear();
+            if (pfrom->fSendMempool) {
+                pfrom->fSendMempool = false;
+                pfrom->fMatchMempool = true;
+            }
         }
         return true;
     }
@@ -4007,9 +4131,16 @@ bool static ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStr
     }
 
     if (strCommand == NetMsgType::FILTERCLEAR) {
-        LOCK(pfrom->cs_filter);
+        LOCK2(pfrom->cs_inventory, pfrom->cs_filter);
         if (pfrom->GetLocalServices() & NODE_BLOOM) {
             pfrom->pfilter = nullptr;
+            pfrom->fRelayFilterLoaded = false;
+            pfrom->setInventoryTxToSend.insert(pfrom->vInventoryTxToMatch.begin(), pfrom->vInventoryTxToMatch.end());
+            pfrom->vInventoryTxToMatch.clear();
+            if (pfrom->fMatchMempool) {
+                pfrom->fMatchMempool = false;
+                pfrom->fSendMempool = true;
+            }
         }
         pfrom->fRelayTxes = true;
         return true;
@@ -4105,36 +4236,8 @@ bool static ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStr
         return true;
     }
 
-    bool found = false;
-    const std::vector<std::string> &allMessages = getAllNetMessageTypes();
-    for (const std::string& msg : allMessages) {
-        if(msg == strCommand) {
-            found = true;
-            break;
-        }
-    }
-
-    if (found)
-    {
-        //probably one the extensions
-#ifdef ENABLE_WALLET
-        coinJoinClientQueueManager.ProcessMessage(pfrom, strCommand, vRecv, *connman, enable_bip61);
-        for (auto& pair : coinJoinClientManagers) {
-            pair.second->ProcessMessage(pfrom, strCommand, vRecv, *connman, enable_bip61);
-        }
-#endif // ENABLE_WALLET
-        coinJoinServer.ProcessMessage(pfrom, strCommand, vRecv, *connman, enable_bip61);
-        sporkManager.ProcessSporkMessages(pfrom, strCommand, vRecv, *connman);
-        masternodeSync.ProcessMessage(pfrom, strCommand, vRecv);
-        governance.ProcessMessage(pfrom, strCommand, vRecv, *connman, enable_bip61);
-        CMNAuth::ProcessMessage(pfrom, strCommand, vRecv, *connman);
-        llmq::quorumBlockProcessor->ProcessMessage(pfrom, strCommand, vRecv);
-        llmq::quorumDKGSessionManager->ProcessMessage(pfrom, strCommand, vRecv);
-        llmq::quorumManager->ProcessMessage(pfrom, strCommand, vRecv);
-        llmq::quorumSigSharesManager->ProcessMessage(pfrom, strCommand, vRecv);
-        llmq::quorumSigningManager->ProcessMessage(pfrom, strCommand, vRecv);
-        llmq::chainLocksHandler->ProcessMessage(pfrom, strCommand, vRecv);
-        llmq::quorumInstantSendManager->ProcessMessage(pfrom, strCommand, vRecv);
+    if (handler_it != mapHandlers.end()) {
+        // known command we have nothing to do for
         return true;
     }
 
@@ -4276,6 +4379,8 @@ bool PeerLogicValidation::ProcessMessages(CNode* pfrom, std::atomic<bool>& inter
     }
 
     // Process message
+    const int64_t nProcessStart = GetTimeMicros();
+    const int64_t nCPUStart = GetThreadCPUTimeMicros();
     bool fRet = false;
     try
     {
@@ -4313,6 +4418,17 @@ bool PeerLogicValidation::ProcessMessages(CNode* pfrom, std::atomic<bool>& inter
         PrintExceptionContinue(std::current_exception(), "ProcessMessages()");
     }
 
+    CNetMsgCost cost;
+    cost.nCount = 1;
+    cost.nProcessTime = GetTimeMicros() - nProcessStart;
+    cost.nCPUTime = GetThreadCPUTimeMicros() - nCPUStart;
+    cost.nQueueTime = std::max<int64_t>(0, nProcessStart - msg.m_time);
+    cost.nMaxProcessTime = cost.nProcessTime;
+    // Unknown commands are accounted together so that peers can't grow the maps
+    const std::string& strCostCommand = GetNetMsgHandlers().count(strCommand) ? strCommand : NET_MESSAGE_COMMAND_OTHER;
+    pfrom->RecordMsgCost(strCostCommand, cost);
+    connman->RecordMsgCost(strCostCommand, cost);
+
     if (!fRet) {
         LogPrint(BCLog::NET, "%s(%s, %u bytes) FAILED peer=%d\n", __func__, SanitizeString(strCommand), nMessageSize, pfrom->GetId());
     }
@@ -4792,18 +4908,25 @@ bool PeerLogicValidation::SendMessages(CNode* pto)
                 }
             };
 
-            // Respond to BIP35 mempool requests
-            if (fSendTrickle && pto->fSendMempool) {
-                auto vtxinfo = mempool.infoAll();
+            // Respond to BIP35 mempool requests. Peers with a bloom filter
+            // loaded get the result prepared by CFilterMatcher.
+            if (fSendTrickle && (pto->fSendMempool || pto->fSendMempoolMatched)) {
+                std::vector<uint256> vMempoolTx;
+                if (pto->fSendMempoolMatched) {
+                    vMempoolTx.swap(pto->vInventoryMempoolMatched);
+                } else {
+                    auto vtxinfo = mempool.infoAll();
+                    vMempoolTx.reserve(vtxinfo.size());
+                    for (const auto& txinfo : vtxinfo) {
+                        vMempoolTx.emplace_back(txinfo.tx->GetHash());
+                    }
+                }
                 pto->fSendMempool = false;
-
-                LOCK(pto->cs_filter);
+                pto->fSendMempoolMatched = false;
 
                 // Send invs for txes and corresponding IS-locks
-                for (const auto& txinfo : vtxinfo) {
-                    const uint256& hash = txinfo.tx->GetHash();
+                for (const uint256& hash : vMempoolTx) {
                     pto->setInventoryTxToSend.erase(hash);
-                    if (pto->pfilter && !pto->pfilter->IsRelevantAndUpdate(*txinfo.tx)) continue;
 
                     int nInvType = CCoinJoin::GetDSTX(hash) ? MSG_DSTX : MSG_TX;
                     queueAndMaybePushInv(CInv(nInvType, hash));
@@ -4838,8 +4961,9 @@ bool PeerLogicValidation::SendMessages(CNode* pto)
                 std::make_heap(vInvTx.begin(), vInvTx.end(), compareInvMempoolOrder);
                 // No reason to drain out at many times the network's capacity,
                 // especially since we have many peers and some will draw much shorter delays.
+                // Peers with a bloom filter only have matching transactions
+                // in setInventoryTxToSend, see CFilterMatcher.
                 unsigned int nRelayedTransactions = 0;
-                LOCK(pto->cs_filter);
                 while (!vInvTx.empty() && nRelayedTransactions < INVENTORY_BROADCAST_MAX_PER_1MB_BLOCK * MaxBlockSize() / 1000000) {
                     // Fetch the top element from the heap
                     std::pop_heap(vInvTx.begin(), vInvTx.end(), compareInvMempoolOrder);
@@ -4857,7 +4981,6 @@ bool PeerLogicValidation::SendMessages(CNode* pto)
                     if (!txinfo.tx) {
                         continue;
                     }
-                    if (pto->pfilter && !pto->pfilter->IsRelevantAndUpdate(*txinfo.tx)) continue;
                     // Send
                     nRelayedTransactions++;
                     {
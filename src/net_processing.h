@@ -7,6 +7,7 @@
 #define BITCOIN_NET_PROCESSING_H
 
 #include <net.h>
+#include <net_filtermatcher.h>
 #include <validation.h>
 #include <validationinterface.h>
 #include <consensus/params.h>
@@ -74,10 +75,14 @@ public:
     void CheckForStaleTipAndEvictPeers(const Consensus::Params &consensusParams);
     /** If we have extra outbound peers, try to disconnect the one with the oldest block announcement */
     void EvictExtraOutboundPeers(int64_t time_in_seconds) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+    /** Let the bloom filter matching tasks finish, they hold references to peers which CConnman::Stop deletes */
+    void StopFilterMatcher();
 
 private:
     int64_t m_stale_tip_check_time; //!< Next time to check for stale tip
 
+    std::unique_ptr<CFilterMatcher> m_filter_matcher; //!< Matches tx inventory against peer bloom filters
+
     /** Enable BIP61 (sending reject messages) */
     const bool m_enable_bip61;
 };
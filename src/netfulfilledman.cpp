@@ -3,24 +3,46 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <chainparams.h>
+#include <dbwrapper.h>
 #include <netfulfilledman.h>
 #include <shutdown.h>
 #include <util/system.h>
 
 CNetFulfilledRequestManager netfulfilledman;
 
+static const std::string DB_FULFILLED_REQUESTS = "nf_R";
+
+CNetFulfilledRequestManager::fulfilledreqmap_t::iterator CNetFulfilledRequestManager::LoadRequests(const CService& addrSquashed)
+{
+    AssertLockHeld(cs_mapFulfilledRequests);
+    auto it = mapFulfilledRequests.find(addrSquashed);
+    if (it != mapFulfilledRequests.end() || m_db == nullptr) {
+        return it;
+    }
+    fulfilledreqmapentry_t entry;
+    if (!m_db->Read(std::make_pair(DB_FULFILLED_REQUESTS, addrSquashed), entry)) {
+        return it;
+    }
+    return mapFulfilledRequests.emplace(addrSquashed, std::move(entry)).first;
+}
+
 void CNetFulfilledRequestManager::AddFulfilledRequest(const CService& addr, const std::string& strRequest)
 {
     LOCK(cs_mapFulfilledRequests);
     CService addrSquashed = Params().AllowMultiplePorts() ? addr : CService(addr, 0);
-    mapFulfilledRequests[addrSquashed][strRequest] = GetTime() + Params().FulfilledRequestExpireTime();
+    LoadRequests(addrSquashed);
+    auto& entry = mapFulfilledRequests[addrSquashed];
+    entry[strRequest] = GetTime() + Params().FulfilledRequestExpireTime();
+    if (m_db != nullptr) {
+        m_db->Write(std::make_pair(DB_FULFILLED_REQUESTS, addrSquashed), entry);
+    }
 }
 
 bool CNetFulfilledRequestManager::HasFulfilledRequest(const CService& addr, const std::string& strRequest)
 {
     LOCK(cs_mapFulfilledRequests);
     CService addrSquashed = Params().AllowMultiplePorts() ? addr : CService(addr, 0);
-    fulfilledreqmap_t::iterator it = mapFulfilledRequests.find(addrSquashed);
+    fulfilledreqmap_t::iterator it = LoadRequests(addrSquashed);
 
     return  it != mapFulfilledRequests.end() &&
             it->second.find(strRequest) != it->second.end() &&
@@ -36,6 +58,9 @@ void CNetFulfilledRequestManager::RemoveAllFulfilledRequests(const CService& add
     if (it != mapFulfilledRequests.end()) {
         mapFulfilledRequests.erase(it++);
     }
+    if (m_db != nullptr) {
+        m_db->Erase(std::make_pair(DB_FULFILLED_REQUESTS, addrSquashed));
+    }
 }
 
 void CNetFulfilledRequestManager::CheckAndRemove()
@@ -43,29 +68,88 @@ void CNetFulfilledRequestManager::CheckAndRemove()
     LOCK(cs_mapFulfilledRequests);
 
     int64_t now = GetTime();
-    fulfilledreqmap_t::iterator it = mapFulfilledRequests.begin();
-
-    while(it != mapFulfilledRequests.end()) {
-        fulfilledreqmapentry_t::iterator it_entry = it->second.begin();
-        while(it_entry != it->second.end()) {
+    auto removeExpired = [now](fulfilledreqmapentry_t& entry) {
+        bool fChanged = false;
+        fulfilledreqmapentry_t::iterator it_entry = entry.begin();
+        while(it_entry != entry.end()) {
             if(now > it_entry->second) {
-                it->second.erase(it_entry++);
+                entry.erase(it_entry++);
+                fChanged = true;
             } else {
                 ++it_entry;
             }
         }
+        return fChanged;
+    };
+
+    std::unique_ptr<CDBBatch> batch = m_db ? std::make_unique<CDBBatch>(*m_db) : nullptr;
+    fulfilledreqmap_t::iterator it = mapFulfilledRequests.begin();
+
+    while(it != mapFulfilledRequests.end()) {
+        const bool fChanged = removeExpired(it->second);
         if(it->second.size() == 0) {
+            if (batch) batch->Erase(std::make_pair(DB_FULFILLED_REQUESTS, it->first));
             mapFulfilledRequests.erase(it++);
         } else {
+            if (batch && fChanged) batch->Write(std::make_pair(DB_FULFILLED_REQUESTS, it->first), it->second);
             ++it;
         }
     }
+
+    if (!batch) {
+        return;
+    }
+    // Requests of peers which were not seen since the start are only in the database
+    std::unique_ptr<CDBIterator> itDB(m_db->NewIterator());
+    std::pair<std::string, CService> key;
+    for (itDB->Seek(DB_FULFILLED_REQUESTS); itDB->Valid() && itDB->GetKey(key) && key.first == DB_FULFILLED_REQUESTS; itDB->Next()) {
+        fulfilledreqmapentry_t entry;
+        if (mapFulfilledRequests.count(key.second) || !itDB->GetValue(entry) || !removeExpired(entry)) {
+            continue;
+        }
+        if (entry.empty()) {
+            batch->Erase(key);
+        } else {
+            batch->Write(key, entry);
+        }
+    }
+    m_db->WriteBatch(*batch);
 }
 
 void CNetFulfilledRequestManager::Clear()
 {
     LOCK(cs_mapFulfilledRequests);
     mapFulfilledRequests.clear();
+    if (m_db == nullptr) {
+        return;
+    }
+
+    CDBBatch batch(*m_db);
+    std::unique_ptr<CDBIterator> it(m_db->NewIterator());
+    std::pair<std::string, CService> key;
+    for (it->Seek(DB_FULFILLED_REQUESTS); it->Valid() && it->GetKey(key) && key.first == DB_FULFILLED_REQUESTS; it->Next()) {
+        batch.Erase(key);
+    }
+    m_db->WriteBatch(batch);
+}
+
+void CNetFulfilledRequestManager::ConnectCacheDB(CDBWrapper& db)
+{
+    LOCK(cs_mapFulfilledRequests);
+    m_db = &db;
+
+    // Keep the requests imported from the flat file of older versions
+    CDBBatch batch(db);
+    for (const auto& [addr, entry] : mapFulfilledRequests) {
+        batch.Write(std::make_pair(DB_FULFILLED_REQUESTS, addr), entry);
+    }
+    db.WriteBatch(batch, true);
+}
+
+void CNetFulfilledRequestManager::DisconnectCacheDB()
+{
+    LOCK(cs_mapFulfilledRequests);
+    m_db = nullptr;
 }
 
 std::string CNetFulfilledRequestManager::ToString() const
@@ -9,6 +9,7 @@
 #include <serialize.h>
 #include <sync.h>
 
+class CDBWrapper;
 class CNetFulfilledRequestManager;
 extern CNetFulfilledRequestManager netfulfilledman;
 
@@ -24,6 +25,11 @@ private:
     fulfilledreqmap_t mapFulfilledRequests;
     mutable CCriticalSection cs_mapFulfilledRequests;
 
+    // every change is written through to here, entries are only loaded on first use
+    CDBWrapper* m_db GUARDED_BY(cs_mapFulfilledRequests){nullptr};
+
+    fulfilledreqmap_t::iterator LoadRequests(const CService& addrSquashed) EXCLUSIVE_LOCKS_REQUIRED(cs_mapFulfilledRequests);
+
 public:
     CNetFulfilledRequestManager() {}
 
@@ -39,8 +45,17 @@ public:
     void RemoveAllFulfilledRequests(const CService& addr);
 
     void CheckAndRemove();
+    /** Clear all fulfilled requests, including the ones stored in the cache database */
     void Clear();
 
+    /**
+     * Store the fulfilled requests in db from now on. The requests in memory, e.g. imported
+     * from an old netfulfilled.dat, are written to it, the others are only loaded on first use.
+     */
+    void ConnectCacheDB(CDBWrapper& db);
+    /** Stop using the database set by ConnectCacheDB */
+    void DisconnectCacheDB();
+
     std::string ToString() const;
 
     void DoMaintenance();
@@ -0,0 +1,62 @@
+// Copyright (c) 2026 The PirateCash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <node/blockcache.h>
+
+#include <primitives/block.h>
+#include <undo.h>
+
+CBlockCache g_block_cache;
+
+CBlockCache::CBlockCache(size_t nMaxBlocks) :
+    mapBlocks(nMaxBlocks),
+    mapUndos(nMaxBlocks)
+{
+}
+
+std::shared_ptr<const CBlock> CBlockCache::GetBlock(const uint256& hash)
+{
+    std::shared_ptr<const CBlock> block;
+    {
+        LOCK(cs);
+        mapBlocks.get(hash, block);
+    }
+    ++(block ? nBlockHits : nBlockMisses);
+    return block;
+}
+
+void CBlockCache::AddBlock(const uint256& hash, const std::shared_ptr<const CBlock>& block)
+{
+    LOCK(cs);
+    mapBlocks.insert(hash, block);
+}
+
+std::shared_ptr<const CBlockUndo> CBlockCache::GetUndo(const uint256& hash)
+{
+    std::shared_ptr<const CBlockUndo> undo;
+    {
+        LOCK(cs);
+        mapUndos.get(hash, undo);
+    }
+    ++(undo ? nUndoHits : nUndoMisses);
+    return undo;
+}
+
+void CBlockCache::AddUndo(const uint256& hash, const std::shared_ptr<const CBlockUndo>& undo)
+{
+    LOCK(cs);
+    mapUndos.insert(hash, undo);
+}
+
+void CBlockCache::Clear()
+{
+    LOCK(cs);
+    mapBlocks.clear();
+    mapUndos.clear();
+}
+
+CBlockCache::Stats CBlockCache::GetStats() const
+{
+    return {nBlockHits, nBlockMisses, nUndoHits, nUndoMisses};
+}
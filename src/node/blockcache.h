@@ -0,0 +1,66 @@
+// Copyright (c) 2026 The PirateCash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_NODE_BLOCKCACHE_H
+#define BITCOIN_NODE_BLOCKCACHE_H
+
+#include <saltedhasher.h>
+#include <sync.h>
+#include <uint256.h>
+#include <unordered_lru_cache.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+class CBlock;
+class CBlockUndo;
+
+/**
+ * Bounded cache of recently connected or read blocks and their undo data.
+ *
+ * Blocks are immutable once stored, so every subsystem which needs the same
+ * block (chainlocks, ZMQ, indexes, peers, RPC) shares a single deserialized
+ * copy instead of reading it from disk again.
+ */
+class CBlockCache
+{
+public:
+    static constexpr size_t DEFAULT_MAX_BLOCKS = 16;
+
+    struct Stats {
+        uint64_t nBlockHits;
+        uint64_t nBlockMisses;
+        uint64_t nUndoHits;
+        uint64_t nUndoMisses;
+    };
+
+    explicit CBlockCache(size_t nMaxBlocks = DEFAULT_MAX_BLOCKS);
+
+    /** Returns the cached block or nullptr, counting the lookup as hit or miss */
+    std::shared_ptr<const CBlock> GetBlock(const uint256& hash);
+    void AddBlock(const uint256& hash, const std::shared_ptr<const CBlock>& block);
+
+    /** Returns the cached undo data or nullptr, counting the lookup as hit or miss */
+    std::shared_ptr<const CBlockUndo> GetUndo(const uint256& hash);
+    void AddUndo(const uint256& hash, const std::shared_ptr<const CBlockUndo>& undo);
+
+    void Clear();
+    Stats GetStats() const;
+
+private:
+    Mutex cs;
+    unordered_lru_cache<uint256, std::shared_ptr<const CBlock>, StaticSaltedHasher> mapBlocks GUARDED_BY(cs);
+    unordered_lru_cache<uint256, std::shared_ptr<const CBlockUndo>, StaticSaltedHasher> mapUndos GUARDED_BY(cs);
+
+    std::atomic<uint64_t> nBlockHits{0};
+    std::atomic<uint64_t> nBlockMisses{0};
+    std::atomic<uint64_t> nUndoHits{0};
+    std::atomic<uint64_t> nUndoMisses{0};
+};
+
+/** Shared by ConnectTip, ReadBlockFromDisk and UndoReadFromDisk */
+extern CBlockCache g_block_cache;
+
+#endif // BITCOIN_NODE_BLOCKCACHE_H
@@ -7,11 +7,15 @@
 #define BITCOIN_NODE_COINSTATS_H
 
 #include <amount.h>
+#include <crypto/muhash.h>
+#include <serialize.h>
 #include <uint256.h>
 
 #include <cstdint>
 
 class CCoinsView;
+class COutPoint;
+class Coin;
 
 struct CCoinsStats
 {
@@ -27,7 +31,34 @@ struct CCoinsStats
     CCoinsStats() : nHeight(0), nTransactions(0), nTransactionOutputs(0), nBogoSize(0), nDiskSize(0), nTotalAmount(0) {}
 };
 
+/**
+ * Statistics about the unspent transaction output set which can be updated
+ * coin by coin as blocks are connected and disconnected, so that they never
+ * require a scan of the whole set. The set itself is committed to with a
+ * MuHash3072 over all (outpoint, coin) pairs.
+ */
+struct CUTXOStats
+{
+    //! The block the statistics are valid for, null if they are unknown
+    uint256 hashBlock;
+    uint64_t nTransactionOutputs{0};
+    uint64_t nBogoSize{0};
+    CAmount nTotalAmount{0};
+    MuHash3072 muhash;
+
+    void AddCoin(const COutPoint& outpoint, const Coin& coin);
+    void RemoveCoin(const COutPoint& outpoint, const Coin& coin);
+
+    SERIALIZE_METHODS(CUTXOStats, obj)
+    {
+        READWRITE(obj.hashBlock, obj.nTransactionOutputs, obj.nBogoSize, obj.nTotalAmount, obj.muhash);
+    }
+};
+
 //! Calculate statistics about the unspent transaction output set
 bool GetUTXOStats(CCoinsView* view, CCoinsStats& stats);
 
+//! Calculate the incrementally maintained statistics from scratch
+bool ComputeUTXOStats(CCoinsView* view, CUTXOStats& stats);
+
 #endif // BITCOIN_NODE_COINSTATS_H
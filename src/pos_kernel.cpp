@@ -509,7 +509,7 @@ bool CheckStakeKernelHash(
 }
 
 // Check kernel hash target and coinstake signature
-bool CheckProofOfStake(CValidationState &state, const CBlockHeader &header, uint256& hashProofOfStake, const Consensus::Params& consensus)
+bool CheckProofOfStake(CValidationState &state, const CBlockHeader &header, uint256& hashProofOfStake, const Consensus::Params& consensus, const CPubKey* signer)
 {
     if (header.vchBlockSig.empty()) {
         return state.DoS(100, false, REJECT_MALFORMED, "bad-pos-sig", false, "missing PoS signature");
@@ -630,7 +630,14 @@ bool CheckProofOfStake(CValidationState &state, const CBlockHeader &header, uint
                              false, "unsupported Stake Input script");
         }
 
-        if (!header.CheckBlockSignature(key_id)) {
+        bool fValidSig;
+        if (signer != nullptr) {
+            header.posPubKey = *signer;
+            fValidSig = signer->IsValid() && signer->GetID() == key_id;
+        } else {
+            fValidSig = header.CheckBlockSignature(key_id);
+        }
+        if (!fValidSig) {
             return state.DoS(100, false, REJECT_INVALID, "bad-blk-sig",
                              false, "invalid block signature");
         }
@@ -33,6 +33,7 @@ bool CheckStakeKernelHash(
 
 // Check kernel hash target and coinstake signature
 // Sets hashProofOfStake on success return
-bool CheckProofOfStake(CValidationState &state, const CBlockHeader &block, uint256& hashProofOfStake, const Consensus::Params& consensus);
+// If signer is set, it is the key already recovered from the block signature
+bool CheckProofOfStake(CValidationState &state, const CBlockHeader &block, uint256& hashProofOfStake, const Consensus::Params& consensus, const CPubKey* signer = nullptr);
 
 #endif // BITCOIN_KERNEL_H
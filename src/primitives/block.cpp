@@ -136,7 +136,15 @@ bool CBlock::HasStake() const {
         return false;
     }
 
-    const auto spk = GetScriptForDestination(posPubKey.GetID());
+    return HasStake(posPubKey.GetID());
+}
+
+bool CBlock::HasStake(const CKeyID& signer) const {
+    if (!IsProofOfStake() || (vtx.size() < 2)) {
+        return false;
+    }
+
+    const auto spk = GetScriptForDestination(signer);
     const auto& cb_vout = CoinBase()->vout;
     const auto& stake = Stake();
 
@@ -188,6 +188,8 @@ public:
 
     bool HasCoinBase() const;
     bool HasStake() const;
+    //! Same as HasStake() with the block signer already recovered from vchBlockSig
+    bool HasStake(const CKeyID& signer) const;
 
     bool IsProofOfStakeTX() const {
         return (vtx.size() > 1 && vtx[1]->IsCoinStake());
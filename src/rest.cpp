@@ -11,6 +11,7 @@
 #include <primitives/block.h>
 #include <primitives/transaction.h>
 #include <rpc/blockchain.h>
+#include <rpc/jsonstream.h>
 #include <rpc/protocol.h>
 #include <rpc/server.h>
 #include <streams.h>
@@ -317,11 +318,11 @@ static bool rest_mempool_contents(HTTPRequest* req, const std::string& strURIPar
 
     switch (rf) {
     case RetFormat::JSON: {
-        UniValue mempoolObject = MempoolToJSON(::mempool, true);
-
-        std::string strJSON = mempoolObject.write() + "\n";
+        JSONStreamWriter writer([req](const char* data, size_t size) { req->WriteReplyBody(data, size); });
+        MempoolToJSON(::mempool, writer, true);
+        writer.Flush();
         req->WriteHeader("Content-Type", "application/json");
-        req->WriteReply(HTTP_OK, strJSON);
+        req->WriteReply(HTTP_OK, "\n");
         return true;
     }
     default: {
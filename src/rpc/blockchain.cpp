@@ -20,9 +20,12 @@
 #include <policy/feerate.h>
 #include <policy/policy.h>
 #include <primitives/transaction.h>
+#include <rpc/jsonstream.h>
 #include <rpc/server.h>
 #include <rpc/util.h>
+#include <saltedhasher.h>
 #include <script/descriptor.h>
+#include <shutdown.h>
 #include <streams.h>
 #include <sync.h>
 #include <txmempool.h>
@@ -48,6 +51,8 @@
 
 #include <mutex>
 #include <condition_variable>
+#include <thread>
+#include <unordered_set>
 #include <merkleblock.h>
 
 struct CUpdatedBlock
@@ -540,6 +545,28 @@ UniValue MempoolToJSON(const CTxMemPool& pool, bool verbose)
     }
 }
 
+void MempoolToJSON(const CTxMemPool& pool, JSONStreamWriter& writer, bool verbose)
+{
+    if (verbose) {
+        LOCK(pool.cs);
+        writer.BeginObject();
+        for (const CTxMemPoolEntry& e : pool.mapTx) {
+            UniValue info(UniValue::VOBJ);
+            entryToJSON(pool, info, e);
+            writer.KV(e.GetTx().GetHash().ToString(), info);
+        }
+        writer.EndObject();
+    } else {
+        std::vector<uint256> vtxid;
+        pool.queryHashes(vtxid);
+
+        writer.BeginArray();
+        for (const uint256& hash : vtxid)
+            writer.Value(hash.ToString());
+        writer.EndArray();
+    }
+}
+
 static UniValue getrawmempool(const JSONRPCRequest& request)
 {
     if (request.fHelp || request.params.size() > 1)
@@ -572,7 +599,9 @@ static UniValue getrawmempool(const JSONRPCRequest& request)
     if (!request.params[0].isNull())
         fVerbose = request.params[0].get_bool();
 
-    return MempoolToJSON(::mempool, fVerbose);
+    return StreamRPCResult(request, [&](JSONStreamWriter& writer) {
+        MempoolToJSON(::mempool, writer, fVerbose);
+    });
 }
 
 static UniValue getmempoolancestors(const JSONRPCRequest& request)
@@ -1229,32 +1258,69 @@ static UniValue pruneblockchain(const JSONRPCRequest& request)
 
 static UniValue gettxoutsetinfo(const JSONRPCRequest& request)
 {
-    if (request.fHelp || request.params.size() != 0)
+    if (request.fHelp || request.params.size() > 1)
         throw std::runtime_error(
             RPCHelpMan{"gettxoutsetinfo",
                 "\nReturns statistics about the unspent transaction output set.\n"
-                "Note this call may take some time.\n",
-                {},
+                "Note this call may take some time when hash_type is hash_serialized_2.\n",
+                {
+                    {"hash_type", RPCArg::Type::STR, /* default */ "hash_serialized_2", "Which UTXO set hash should be calculated. Options: 'hash_serialized_2' (scans the whole set), 'muhash', 'none' (both are maintained incrementally and returned instantly)."},
+                },
                 RPCResult{
                     RPCResult::Type::OBJ, "", "",
                     {
                         {RPCResult::Type::NUM, "height", "The current block height (index)"},
                         {RPCResult::Type::STR_HEX, "bestblock", "The hash of the block at the tip of the chain"},
-                        {RPCResult::Type::NUM, "transactions", "The number of transactions with unspent outputs"},
+                        {RPCResult::Type::NUM, "transactions", /* optional */ true, "The number of transactions with unspent outputs (only for hash_serialized_2)"},
                         {RPCResult::Type::NUM, "txouts", "The number of unspent transaction outputs"},
                         {RPCResult::Type::NUM, "bogosize", "A meaningless metric for UTXO set size"},
-                        {RPCResult::Type::STR_HEX, "hash_serialized_2", "The serialized hash"},
+                        {RPCResult::Type::STR_HEX, "hash_serialized_2", /* optional */ true, "The serialized hash (only for hash_serialized_2)"},
+                        {RPCResult::Type::STR_HEX, "muhash", /* optional */ true, "The MuHash3072 of all unspent outputs (only for muhash)"},
                         {RPCResult::Type::NUM, "disk_size", "The estimated size of the chainstate on disk"},
                         {RPCResult::Type::STR_AMOUNT, "total_amount", "The total amount"},
                     }},
                 RPCExamples{
                     HelpExampleCli("gettxoutsetinfo", "")
+            + HelpExampleCli("gettxoutsetinfo", "\"muhash\"")
             + HelpExampleRpc("gettxoutsetinfo", "")
                 },
             }.ToString());
 
+    const std::string hash_type = request.params[0].isNull() ? "hash_serialized_2" : request.params[0].get_str();
+
     UniValue ret(UniValue::VOBJ);
 
+    if (hash_type == "muhash" || hash_type == "none") {
+        CUTXOStats stats;
+        int height;
+        size_t disk_size;
+        {
+            LOCK(cs_main);
+            stats = ::ChainstateActive().m_utxo_stats;
+            const CBlockIndex* tip = ::ChainActive().Tip();
+            if (!tip || stats.hashBlock != tip->GetBlockHash()) {
+                throw JSONRPCError(RPC_INTERNAL_ERROR, "UTXO set statistics are not available");
+            }
+            height = tip->nHeight;
+            disk_size = ::ChainstateActive().CoinsDB().EstimateSize();
+        }
+        ret.pushKV("height", (int64_t)height);
+        ret.pushKV("bestblock", stats.hashBlock.GetHex());
+        ret.pushKV("txouts", (int64_t)stats.nTransactionOutputs);
+        ret.pushKV("bogosize", (int64_t)stats.nBogoSize);
+        if (hash_type == "muhash") {
+            uint256 muhash;
+            stats.muhash.Finalize(muhash);
+            ret.pushKV("muhash", muhash.GetHex());
+        }
+        ret.pushKV("disk_size", (uint64_t)disk_size);
+        ret.pushKV("total_amount", ValueFromAmount(stats.nTotalAmount));
+        return ret;
+    }
+    if (hash_type != "hash_serialized_2") {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, strprintf("%s is not a valid hash_type", hash_type));
+    }
+
     CCoinsStats stats;
     ::ChainstateActive().ForceFlushStateToDisk();
 
@@ -2400,31 +2466,79 @@ static UniValue savemempool(const JSONRPCRequest& request)
     return NullUniValue;
 }
 
-//! Search for a given set of pubkey scripts
-bool FindScriptPubKey(std::atomic<int>& scan_progress, const std::atomic<bool>& should_abort, int64_t& count, CCoinsViewCursor* cursor, const std::set<CScript>& needles, std::map<COutPoint, Coin>& out_results) {
-    scan_progress = 0;
+template<>
+struct SaltedHasherImpl<CScript>
+{
+    static std::size_t CalcHash(const CScript& v, uint64_t k0, uint64_t k1)
+    {
+        return CSipHasher(k0, k1).Write(v.data(), v.size()).Finalize();
+    }
+};
+
+typedef std::unordered_set<CScript, StaticSaltedHasher> ScriptSet;
+
+//! Maximum number of threads scanning the txout set in parallel
+static const int MAX_SCAN_THREADS = 8;
+
+//! Search for a given set of pubkey scripts in the txid range of a single cursor
+static bool FindScriptPubKey(std::atomic<int>& scan_progress, std::atomic<uint32_t>& scanned, const std::atomic<bool>& should_abort, int64_t& count, CCoinsViewCursor* cursor, uint32_t position, const ScriptSet& needles, std::map<COutPoint, Coin>& out_results) {
     count = 0;
     while (cursor->Valid()) {
         COutPoint key;
         Coin coin;
         if (!cursor->GetKey(key) || !cursor->GetValue(coin)) return false;
         if (++count % 8192 == 0) {
-            boost::this_thread::interruption_point();
-            if (should_abort) {
+            if (should_abort || ShutdownRequested()) {
                 // allow to abort the scan via the abort reference
                 return false;
             }
         }
         if (count % 256 == 0) {
-            // update progress reference every 256 item
+            // update progress reference every 256 item, in 1/65536 of the txid space
             uint32_t high = 0x100 * *key.hash.begin() + *(key.hash.begin() + 1);
-            scan_progress = (int)(high * 100.0 / 65536.0 + 0.5);
+            if (high > position) {
+                scan_progress = (int)((scanned += high - position) * 100.0 / 65536.0 + 0.5);
+                position = high;
+            }
         }
         if (needles.count(coin.out.scriptPubKey)) {
             out_results.emplace(key, coin);
         }
         cursor->Next();
     }
+    return true;
+}
+
+//! Search for a given set of pubkey scripts with one thread per cursor
+static bool FindScriptPubKey(std::atomic<int>& scan_progress, const std::atomic<bool>& should_abort, int64_t& count, const std::vector<std::unique_ptr<CCoinsViewCursor>>& cursors, const ScriptSet& needles, std::map<COutPoint, Coin>& out_results) {
+    scan_progress = 0;
+    count = 0;
+    std::atomic<uint32_t> scanned{0};
+    std::vector<std::map<COutPoint, Coin>> results(cursors.size());
+    std::vector<int64_t> counts(cursors.size(), 0);
+    std::atomic<bool> success{true};
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < cursors.size(); i++) {
+        const uint32_t position = (i * 0x100 / cursors.size()) * 0x100;
+        threads.emplace_back([&, i, position] {
+            try {
+                if (!FindScriptPubKey(scan_progress, scanned, should_abort, counts[i], cursors[i].get(), position, needles, results[i])) {
+                    success = false;
+                }
+            } catch (const std::exception& e) {
+                LogPrintf("%s: %s\n", __func__, e.what());
+                success = false;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    if (!success) return false;
+    for (size_t i = 0; i < cursors.size(); i++) {
+        count += counts[i];
+        out_results.insert(results[i].begin(), results[i].end());
+    }
     scan_progress = 100;
     return true;
 }
@@ -2551,7 +2665,7 @@ UniValue scantxoutset(const JSONRPCRequest& request)
             throw JSONRPCError(RPC_MISC_ERROR, "scanobjects argument is required for the start action");
         }
 
-        std::set<CScript> needles;
+        ScriptSet needles;
         std::map<CScript, std::string> descriptors;
         CAmount total_in = 0;
 
@@ -2603,17 +2717,35 @@ UniValue scantxoutset(const JSONRPCRequest& request)
         g_should_abort_scan = false;
         g_scan_progress = 0;
         int64_t count = 0;
-        std::unique_ptr<CCoinsViewCursor> pcursor;
-        CBlockIndex* tip;
+        std::vector<std::unique_ptr<CCoinsViewCursor>> cursors;
+        std::unordered_set<COutPoint, SaltedOutpointHasher> spent_coins;
+        std::map<COutPoint, Coin> cached_coins;
+        const CBlockIndex* tip;
         {
+            // Instead of flushing the coins cache, scan a snapshot of the coins
+            // database and apply the changes still held in the cache on top of it.
+            // Both are taken under cs_main, so they are consistent with the tip.
             LOCK(cs_main);
-            ::ChainstateActive().ForceFlushStateToDisk();
-            pcursor = std::unique_ptr<CCoinsViewCursor>(::ChainstateActive().CoinsDB().Cursor());
-            CHECK_NONFATAL(pcursor);
+            cursors = ::ChainstateActive().CoinsDB().SnapshotCursors(std::max(1, std::min(GetNumCores(), MAX_SCAN_THREADS)));
+            ::ChainstateActive().CoinsTip().ForEachDirtyCoin([&](const COutPoint& outpoint, const Coin& coin) {
+                if (coin.IsSpent()) {
+                    spent_coins.insert(outpoint);
+                } else if (needles.count(coin.out.scriptPubKey)) {
+                    cached_coins.emplace(outpoint, coin);
+                }
+            });
             tip = ::ChainActive().Tip();
             CHECK_NONFATAL(tip);
         }
-        bool res = FindScriptPubKey(g_scan_progress, g_should_abort_scan, count, pcursor.get(), needles, coins);
+        bool res = FindScriptPubKey(g_scan_progress, g_should_abort_scan, count, cursors, needles, coins);
+        for (auto it = coins.begin(); it != coins.end();) {
+            if (spent_coins.count(it->first)) {
+                it = coins.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        coins.insert(cached_coins.begin(), cached_coins.end());
         result.pushKV("success", res);
         result.pushKV("txouts", count);
         result.pushKV("height", tip->nHeight);
@@ -2747,7 +2879,7 @@ static const CRPCCommand commands[] =
     { "blockchain",         "getrawmempool",          &getrawmempool,          {"verbose"} },
     { "blockchain",         "getspecialtxes",         &getspecialtxes,         {"blockhash", "type", "count", "skip", "verbosity"} },
     { "blockchain",         "gettxout",               &gettxout,               {"txid","n","include_mempool"} },
-    { "blockchain",         "gettxoutsetinfo",        &gettxoutsetinfo,        {} },
+    { "blockchain",         "gettxoutsetinfo",        &gettxoutsetinfo,        {"hash_type"} },
     { "blockchain",         "pruneblockchain",        &pruneblockchain,        {"height"} },
     { "blockchain",         "savemempool",            &savemempool,            {} },
     { "blockchain",         "verifychain",            &verifychain,            {"checklevel","nblocks"} },
@@ -12,6 +12,7 @@
 class CBlock;
 class CBlockIndex;
 class CTxMemPool;
+class JSONStreamWriter;
 class UniValue;
 
 static constexpr int NUM_GETBLOCKSTATS_PERCENTILES = 5;
@@ -36,6 +37,7 @@ UniValue MempoolInfoToJSON(const CTxMemPool& pool);
 
 /** Mempool to JSON */
 UniValue MempoolToJSON(const CTxMemPool& pool, bool verbose = false);
+void MempoolToJSON(const CTxMemPool& pool, JSONStreamWriter& writer, bool verbose = false);
 
 /** Block header to JSON */
 UniValue blockheaderToJSON(const CBlockIndex* tip, const CBlockIndex* blockindex);
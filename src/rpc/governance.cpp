@@ -14,6 +14,7 @@
 #include <masternode/sync.h>
 #include <messagesigner.h>
 #include <net.h>
+#include <rpc/jsonstream.h>
 #include <rpc/server.h>
 #include <rpc/util.h>
 #include <util/system.h>
@@ -707,10 +708,8 @@ static UniValue gobject_vote_alias(const JSONRPCRequest& request)
 }
 #endif
 
-static UniValue ListObjects(const std::string& strCachedSignal, const std::string& strType, int nStartTime)
+static void ListObjects(JSONStreamWriter& writer, const std::string& strCachedSignal, const std::string& strType, int nStartTime)
 {
-    UniValue objResult(UniValue::VOBJ);
-
     // GET MATCHING GOVERNANCE OBJECTS
 
     if (g_txindex) {
@@ -723,6 +722,7 @@ static UniValue ListObjects(const std::string& strCachedSignal, const std::strin
     governance.UpdateLastDiffTime(GetTime());
     // CREATE RESULTS FOR USER
 
+    writer.BeginObject();
     for (const auto& govObj : objs) {
         if (strCachedSignal == "valid" && !govObj.IsSetCachedValid()) continue;
         if (strCachedSignal == "funding" && !govObj.IsSetCachedFunding()) continue;
@@ -759,10 +759,9 @@ static UniValue ListObjects(const std::string& strCachedSignal, const std::strin
         bObj.pushKV("fCachedDelete",  govObj.IsSetCachedDelete());
         bObj.pushKV("fCachedEndorsed",  govObj.IsSetCachedEndorsed());
 
-        objResult.pushKV(govObj.GetHash().ToString(), bObj);
+        writer.KV(govObj.GetHash().ToString(), bObj);
     }
-
-    return objResult;
+    writer.EndObject();
 }
 
 static void gobject_list_help(const JSONRPCRequest& request)
@@ -797,7 +796,9 @@ static UniValue gobject_list(const JSONRPCRequest& request)
     if (strType != "proposals" && strType != "triggers" && strType != "all")
         return "Invalid type, should be 'proposals', 'triggers' or 'all'";
 
-    return ListObjects(strCachedSignal, strType, 0);
+    return StreamRPCResult(request, [&](JSONStreamWriter& writer) {
+        ListObjects(writer, strCachedSignal, strType, 0);
+    });
 }
 
 static void gobject_diff_help(const JSONRPCRequest& request)
@@ -832,7 +833,9 @@ static UniValue gobject_diff(const JSONRPCRequest& request)
     if (strType != "proposals" && strType != "triggers" && strType != "all")
         return "Invalid type, should be 'proposals', 'triggers' or 'all'";
 
-    return ListObjects(strCachedSignal, strType, governance.GetLastDiffTime());
+    return StreamRPCResult(request, [&](JSONStreamWriter& writer) {
+        ListObjects(writer, strCachedSignal, strType, governance.GetLastDiffTime());
+    });
 }
 
 static void gobject_get_help(const JSONRPCRequest& request)
@@ -0,0 +1,115 @@
+// Copyright (c) 2026 The PirateCash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <rpc/jsonstream.h>
+
+#include <rpc/request.h>
+
+#include <cassert>
+#include <stdexcept>
+
+JSONStreamWriter::JSONStreamWriter(Sink sink, size_t nChunkSize) :
+    m_sink(std::move(sink)),
+    m_chunk_size(nChunkSize)
+{
+}
+
+void JSONStreamWriter::Write(const std::string& str)
+{
+    m_buffer += str;
+    if (m_buffer.size() >= m_chunk_size) {
+        Flush();
+    }
+}
+
+void JSONStreamWriter::Flush()
+{
+    if (!m_buffer.empty()) {
+        m_sink(m_buffer.data(), m_buffer.size());
+        m_buffer.clear();
+    }
+}
+
+void JSONStreamWriter::BeginValue()
+{
+    if (m_after_key) {
+        m_after_key = false;
+        return;
+    }
+    if (m_scopes.empty()) {
+        return;
+    }
+    Scope& scope = m_scopes.back();
+    assert(!scope.fObject);
+    if (!scope.fEmpty) {
+        m_buffer += ',';
+    }
+    scope.fEmpty = false;
+}
+
+void JSONStreamWriter::BeginObject()
+{
+    BeginValue();
+    m_buffer += '{';
+    m_scopes.push_back({true, true});
+}
+
+void JSONStreamWriter::EndObject()
+{
+    assert(!m_scopes.empty() && m_scopes.back().fObject && !m_after_key);
+    m_scopes.pop_back();
+    Write("}");
+}
+
+void JSONStreamWriter::BeginArray()
+{
+    BeginValue();
+    m_buffer += '[';
+    m_scopes.push_back({false, true});
+}
+
+void JSONStreamWriter::EndArray()
+{
+    assert(!m_scopes.empty() && !m_scopes.back().fObject);
+    m_scopes.pop_back();
+    Write("]");
+}
+
+void JSONStreamWriter::Key(const std::string& key)
+{
+    assert(!m_scopes.empty() && m_scopes.back().fObject && !m_after_key);
+    Scope& scope = m_scopes.back();
+    if (!scope.fEmpty) {
+        m_buffer += ',';
+    }
+    scope.fEmpty = false;
+    m_buffer += UniValue(key).write();
+    m_buffer += ':';
+    m_after_key = true;
+}
+
+void JSONStreamWriter::Value(const UniValue& value)
+{
+    BeginValue();
+    Write(value.write());
+}
+
+UniValue StreamRPCResult(const JSONRPCRequest& request, const std::function<void(JSONStreamWriter&)>& fn)
+{
+    if (request.streamWriter != nullptr && request.streamWriter->IsValuePending()) {
+        fn(*request.streamWriter);
+        assert(!request.streamWriter->IsValuePending());
+        return NullUniValue;
+    }
+
+    std::string strJSON;
+    JSONStreamWriter writer([&strJSON](const char* data, size_t size) { strJSON.append(data, size); });
+    fn(writer);
+    writer.Flush();
+    UniValue result;
+    if (!result.read(strJSON)) {
+        throw std::runtime_error("StreamRPCResult: invalid JSON written");
+    }
+    return result;
+}
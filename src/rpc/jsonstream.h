@@ -0,0 +1,80 @@
+// Copyright (c) 2026 The PirateCash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_RPC_JSONSTREAM_H
+#define BITCOIN_RPC_JSONSTREAM_H
+
+#include <univalue.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+class JSONRPCRequest;
+
+//! Number of buffered bytes at which JSONStreamWriter hands its output to the sink
+static const size_t JSON_STREAM_CHUNK_SIZE = 64 * 1024;
+
+/**
+ * Writes a JSON document incrementally instead of building it as a UniValue tree first.
+ *
+ * Output is collected in a small buffer which is handed to the sink whenever it grows beyond the chunk size, so
+ * memory use doesn't depend on the size of the document. The elements of large arrays and objects can still be
+ * built as UniValue and written one at a time with Value(). Keys are not checked for duplicates. The output is
+ * identical to UniValue::write() without indentation.
+ */
+class JSONStreamWriter
+{
+public:
+    using Sink = std::function<void(const char* data, size_t size)>;
+
+    explicit JSONStreamWriter(Sink sink, size_t nChunkSize = JSON_STREAM_CHUNK_SIZE);
+
+    void BeginObject();
+    void EndObject();
+    void BeginArray();
+    void EndArray();
+
+    /** Write the key of the next value of the current object */
+    void Key(const std::string& key);
+    /** Write a complete value, as array element, as value of the last key or as the whole document */
+    void Value(const UniValue& value);
+    void KV(const std::string& key, const UniValue& value)
+    {
+        Key(key);
+        Value(value);
+    }
+
+    /** Whether a key was written which has no value yet */
+    bool IsValuePending() const { return m_after_key; }
+
+    /** Hand all buffered output to the sink */
+    void Flush();
+
+private:
+    struct Scope {
+        bool fObject;
+        bool fEmpty;
+    };
+
+    const Sink m_sink;
+    const size_t m_chunk_size;
+    std::string m_buffer;
+    std::vector<Scope> m_scopes;
+    bool m_after_key{false};
+
+    void BeginValue();
+    void Write(const std::string& str);
+};
+
+/**
+ * Produce the result of an RPC call with a JSONStreamWriter. Single requests over HTTP stream the result straight
+ * into the reply, and the returned value is ignored. For all other callers (batch requests, the GUI console, other
+ * RPC methods) the output is collected and returned as UniValue.
+ *
+ * fn must write exactly one value and must not throw after writing the first byte unless the whole call fails.
+ */
+UniValue StreamRPCResult(const JSONRPCRequest& request, const std::function<void(JSONStreamWriter&)>& fn);
+
+#endif // BITCOIN_RPC_JSONSTREAM_H
@@ -10,6 +10,7 @@
 #include <masternode/payments.h>
 #include <net.h>
 #include <netbase.h>
+#include <rpc/jsonstream.h>
 #include <rpc/server.h>
 #include <rpc/util.h>
 #include <univalue.h>
@@ -588,8 +589,6 @@ static UniValue masternodelist(const JSONRPCRequest& request)
         masternode_list_help(request);
     }
 
-    UniValue obj(UniValue::VOBJ);
-
     auto mnList = deterministicMNManager->GetListAtChainTip();
     auto dmnToStatus = [&](auto& dmn) {
         if (mnList.IsMNValid(dmn)) {
@@ -610,110 +609,113 @@ static UniValue masternodelist(const JSONRPCRequest& request)
         return (int)pindex->nTime;
     };
 
-    mnList.ForEachMN(false, [&](auto& dmn) {
-        std::string strOutpoint = dmn.collateralOutpoint.ToStringShort();
-        Coin coin;
-        std::string collateralAddressStr = "UNKNOWN";
-        if (GetUTXOCoin(dmn.collateralOutpoint, coin)) {
-            CTxDestination collateralDest;
-            if (ExtractDestination(coin.out.scriptPubKey, collateralDest)) {
-                collateralAddressStr = EncodeDestination(collateralDest);
+    // Masternode outpoints are unique, so keys can be written without checking for duplicates
+    return StreamRPCResult(request, [&](JSONStreamWriter& writer) {
+        writer.BeginObject();
+        mnList.ForEachMN(false, [&](auto& dmn) {
+            std::string strOutpoint = dmn.collateralOutpoint.ToStringShort();
+            Coin coin;
+            std::string collateralAddressStr = "UNKNOWN";
+            if (GetUTXOCoin(dmn.collateralOutpoint, coin)) {
+                CTxDestination collateralDest;
+                if (ExtractDestination(coin.out.scriptPubKey, collateralDest)) {
+                    collateralAddressStr = EncodeDestination(collateralDest);
+                }
             }
-        }
 
-        CScript payeeScript = dmn.pdmnState->scriptPayout;
-        CTxDestination payeeDest;
-        std::string payeeStr = "UNKNOWN";
-        if (ExtractDestination(payeeScript, payeeDest)) {
-            payeeStr = EncodeDestination(payeeDest);
-        }
+            CScript payeeScript = dmn.pdmnState->scriptPayout;
+            CTxDestination payeeDest;
+            std::string payeeStr = "UNKNOWN";
+            if (ExtractDestination(payeeScript, payeeDest)) {
+                payeeStr = EncodeDestination(payeeDest);
+            }
 
-        if (strMode == "addr") {
-            std::string strAddress = dmn.pdmnState->addr.ToString(false);
-            if (strFilter !="" && strAddress.find(strFilter) == std::string::npos &&
-                strOutpoint.find(strFilter) == std::string::npos) return;
-            obj.pushKV(strOutpoint, strAddress);
-        } else if (strMode == "full") {
-            std::ostringstream streamFull;
-            streamFull << std::setw(18) <<
-                           dmnToStatus(dmn) << " " <<
-                           dmn.pdmnState->nPoSePenalty << " " <<
-                           payeeStr << " " << std::setw(10) <<
-                           dmnToLastPaidTime(dmn) << " "  << std::setw(6) <<
-                           dmn.pdmnState->nLastPaidHeight << " " <<
-                           dmn.pdmnState->addr.ToString();
-            std::string strFull = streamFull.str();
-            if (strFilter !="" && strFull.find(strFilter) == std::string::npos &&
-                strOutpoint.find(strFilter) == std::string::npos) return;
-            obj.pushKV(strOutpoint, strFull);
-        } else if (strMode == "info") {
-            std::ostringstream streamInfo;
-            streamInfo << std::setw(18) <<
-                           dmnToStatus(dmn) << " " <<
-                           dmn.pdmnState->nPoSePenalty << " " <<
-                           payeeStr << " " <<
-                           dmn.pdmnState->addr.ToString();
-            std::string strInfo = streamInfo.str();
-            if (strFilter !="" && strInfo.find(strFilter) == std::string::npos &&
-                strOutpoint.find(strFilter) == std::string::npos) return;
-            obj.pushKV(strOutpoint, strInfo);
-        } else if (strMode == "json") {
-            std::ostringstream streamInfo;
-            streamInfo <<  dmn.proTxHash.ToString() << " " <<
-                           dmn.pdmnState->addr.ToString() << " " <<
-                           payeeStr << " " <<
-                           dmnToStatus(dmn) << " " <<
-                           dmn.pdmnState->nPoSePenalty << " " <<
-                           dmnToLastPaidTime(dmn) << " " <<
-                           dmn.pdmnState->nLastPaidHeight << " " <<
-                           EncodeDestination(dmn.pdmnState->keyIDOwner) << " " <<
-                           EncodeDestination(dmn.pdmnState->keyIDVoting) << " " <<
-                           collateralAddressStr << " " <<
-                           dmn.pdmnState->pubKeyOperator.Get().ToString();
-            std::string strInfo = streamInfo.str();
-            if (strFilter !="" && strInfo.find(strFilter) == std::string::npos &&
-                strOutpoint.find(strFilter) == std::string::npos) return;
-            UniValue objMN(UniValue::VOBJ);
-            objMN.pushKV("proTxHash", dmn.proTxHash.ToString());
-            objMN.pushKV("address", dmn.pdmnState->addr.ToString());
-            objMN.pushKV("payee", payeeStr);
-            objMN.pushKV("status", dmnToStatus(dmn));
-            objMN.pushKV("pospenaltyscore", dmn.pdmnState->nPoSePenalty);
-            objMN.pushKV("lastpaidtime", dmnToLastPaidTime(dmn));
-            objMN.pushKV("lastpaidblock", dmn.pdmnState->nLastPaidHeight);
-            objMN.pushKV("owneraddress", EncodeDestination(dmn.pdmnState->keyIDOwner));
-            objMN.pushKV("votingaddress", EncodeDestination(dmn.pdmnState->keyIDVoting));
-            objMN.pushKV("collateraladdress", collateralAddressStr);
-            objMN.pushKV("pubkeyoperator", dmn.pdmnState->pubKeyOperator.Get().ToString());
-            obj.pushKV(strOutpoint, objMN);
-        } else if (strMode == "lastpaidblock") {
-            if (strFilter !="" && strOutpoint.find(strFilter) == std::string::npos) return;
-            obj.pushKV(strOutpoint, dmn.pdmnState->nLastPaidHeight);
-        } else if (strMode == "lastpaidtime") {
-            if (strFilter !="" && strOutpoint.find(strFilter) == std::string::npos) return;
-            obj.pushKV(strOutpoint, dmnToLastPaidTime(dmn));
-        } else if (strMode == "payee") {
-            if (strFilter !="" && payeeStr.find(strFilter) == std::string::npos &&
-                strOutpoint.find(strFilter) == std::string::npos) return;
-            obj.pushKV(strOutpoint, payeeStr);
-        } else if (strMode == "owneraddress") {
-            if (strFilter !="" && strOutpoint.find(strFilter) == std::string::npos) return;
-            obj.pushKV(strOutpoint, EncodeDestination(dmn.pdmnState->keyIDOwner));
-        } else if (strMode == "pubkeyoperator") {
-            if (strFilter !="" && strOutpoint.find(strFilter) == std::string::npos) return;
-            obj.pushKV(strOutpoint, dmn.pdmnState->pubKeyOperator.Get().ToString());
-        } else if (strMode == "status") {
-            std::string strStatus = dmnToStatus(dmn);
-            if (strFilter !="" && strStatus.find(strFilter) == std::string::npos &&
-                strOutpoint.find(strFilter) == std::string::npos) return;
-            obj.pushKV(strOutpoint, strStatus);
-        } else if (strMode == "votingaddress") {
-            if (strFilter !="" && strOutpoint.find(strFilter) == std::string::npos) return;
-            obj.pushKV(strOutpoint, EncodeDestination(dmn.pdmnState->keyIDVoting));
-        }
+            if (strMode == "addr") {
+                std::string strAddress = dmn.pdmnState->addr.ToString(false);
+                if (strFilter !="" && strAddress.find(strFilter) == std::string::npos &&
+                    strOutpoint.find(strFilter) == std::string::npos) return;
+                writer.KV(strOutpoint, strAddress);
+            } else if (strMode == "full") {
+                std::ostringstream streamFull;
+                streamFull << std::setw(18) <<
+                               dmnToStatus(dmn) << " " <<
+                               dmn.pdmnState->nPoSePenalty << " " <<
+                               payeeStr << " " << std::setw(10) <<
+                               dmnToLastPaidTime(dmn) << " "  << std::setw(6) <<
+                               dmn.pdmnState->nLastPaidHeight << " " <<
+                               dmn.pdmnState->addr.ToString();
+                std::string strFull = streamFull.str();
+                if (strFilter !="" && strFull.find(strFilter) == std::string::npos &&
+                    strOutpoint.find(strFilter) == std::string::npos) return;
+                writer.KV(strOutpoint, strFull);
+            } else if (strMode == "info") {
+                std::ostringstream streamInfo;
+                streamInfo << std::setw(18) <<
+                               dmnToStatus(dmn) << " " <<
+                               dmn.pdmnState->nPoSePenalty << " " <<
+                               payeeStr << " " <<
+                               dmn.pdmnState->addr.ToString();
+                std::string strInfo = streamInfo.str();
+                if (strFilter !="" && strInfo.find(strFilter) == std::string::npos &&
+                    strOutpoint.find(strFilter) == std::string::npos) return;
+                writer.KV(strOutpoint, strInfo);
+            } else if (strMode == "json") {
+                std::ostringstream streamInfo;
+                streamInfo <<  dmn.proTxHash.ToString() << " " <<
+                               dmn.pdmnState->addr.ToString() << " " <<
+                               payeeStr << " " <<
+                               dmnToStatus(dmn) << " " <<
+                               dmn.pdmnState->nPoSePenalty << " " <<
+                               dmnToLastPaidTime(dmn) << " " <<
+                               dmn.pdmnState->nLastPaidHeight << " " <<
+                               EncodeDestination(dmn.pdmnState->keyIDOwner) << " " <<
+                               EncodeDestination(dmn.pdmnState->keyIDVoting) << " " <<
+                               collateralAddressStr << " " <<
+                               dmn.pdmnState->pubKeyOperator.Get().ToString();
+                std::string strInfo = streamInfo.str();
+                if (strFilter !="" && strInfo.find(strFilter) == std::string::npos &&
+                    strOutpoint.find(strFilter) == std::string::npos) return;
+                UniValue objMN(UniValue::VOBJ);
+                objMN.pushKV("proTxHash", dmn.proTxHash.ToString());
+                objMN.pushKV("address", dmn.pdmnState->addr.ToString());
+                objMN.pushKV("payee", payeeStr);
+                objMN.pushKV("status", dmnToStatus(dmn));
+                objMN.pushKV("pospenaltyscore", dmn.pdmnState->nPoSePenalty);
+                objMN.pushKV("lastpaidtime", dmnToLastPaidTime(dmn));
+                objMN.pushKV("lastpaidblock", dmn.pdmnState->nLastPaidHeight);
+                objMN.pushKV("owneraddress", EncodeDestination(dmn.pdmnState->keyIDOwner));
+                objMN.pushKV("votingaddress", EncodeDestination(dmn.pdmnState->keyIDVoting));
+                objMN.pushKV("collateraladdress", collateralAddressStr);
+                objMN.pushKV("pubkeyoperator", dmn.pdmnState->pubKeyOperator.Get().ToString());
+                writer.KV(strOutpoint, objMN);
+            } else if (strMode == "lastpaidblock") {
+                if (strFilter !="" && strOutpoint.find(strFilter) == std::string::npos) return;
+                writer.KV(strOutpoint, dmn.pdmnState->nLastPaidHeight);
+            } else if (strMode == "lastpaidtime") {
+                if (strFilter !="" && strOutpoint.find(strFilter) == std::string::npos) return;
+                writer.KV(strOutpoint, dmnToLastPaidTime(dmn));
+            } else if (strMode == "payee") {
+                if (strFilter !="" && payeeStr.find(strFilter) == std::string::npos &&
+                    strOutpoint.find(strFilter) == std::string::npos) return;
+                writer.KV(strOutpoint, payeeStr);
+            } else if (strMode == "owneraddress") {
+                if (strFilter !="" && strOutpoint.find(strFilter) == std::string::npos) return;
+                writer.KV(strOutpoint, EncodeDestination(dmn.pdmnState->keyIDOwner));
+            } else if (strMode == "pubkeyoperator") {
+                if (strFilter !="" && strOutpoint.find(strFilter) == std::string::npos) return;
+                writer.KV(strOutpoint, dmn.pdmnState->pubKeyOperator.Get().ToString());
+            } else if (strMode == "status") {
+                std::string strStatus = dmnToStatus(dmn);
+                if (strFilter !="" && strStatus.find(strFilter) == std::string::npos &&
+                    strOutpoint.find(strFilter) == std::string::npos) return;
+                writer.KV(strOutpoint, strStatus);
+            } else if (strMode == "votingaddress") {
+                if (strFilter !="" && strOutpoint.find(strFilter) == std::string::npos) return;
+                writer.KV(strOutpoint, EncodeDestination(dmn.pdmnState->keyIDVoting));
+            }
+        });
+        writer.EndObject();
     });
-
-    return obj;
 }
 // clang-format off
 static const CRPCCommand commands[] =
@@ -11,6 +11,7 @@
 #include <key_io.h>
 #include <net.h>
 #include <rpc/blockchain.h>
+#include <rpc/jsonstream.h>
 #include <rpc/server.h>
 #include <rpc/util.h>
 #include <script/descriptor.h>
@@ -865,25 +866,25 @@ static UniValue getaddressdeltas(const JSONRPCRequest& request)
         }
     }
 
-    UniValue result(UniValue::VARR);
+    return StreamRPCResult(request, [&](JSONStreamWriter& writer) {
+        writer.BeginArray();
+        for (std::vector<std::pair<CAddressIndexKey, CAmount> >::const_iterator it=addressIndex.begin(); it!=addressIndex.end(); it++) {
+            std::string address;
+            if (!getAddressFromIndex(it->first.type, it->first.hashBytes, address)) {
+                throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Unknown address type");
+            }
 
-    for (std::vector<std::pair<CAddressIndexKey, CAmount> >::const_iterator it=addressIndex.begin(); it!=addressIndex.end(); it++) {
-        std::string address;
-        if (!getAddressFromIndex(it->first.type, it->first.hashBytes, address)) {
-            throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Unknown address type");
+            UniValue delta(UniValue::VOBJ);
+            delta.pushKV("satoshis", it->second);
+            delta.pushKV("txid", it->first.txhash.GetHex());
+            delta.pushKV("index", (int)it->first.index);
+            delta.pushKV("blockindex", (int)it->first.txindex);
+            delta.pushKV("height", it->first.blockHeight);
+            delta.pushKV("address", address);
+            writer.Value(delta);
         }
-
-        UniValue delta(UniValue::VOBJ);
-        delta.pushKV("satoshis", it->second);
-        delta.pushKV("txid", it->first.txhash.GetHex());
-        delta.pushKV("index", (int)it->first.index);
-        delta.pushKV("blockindex", (int)it->first.txindex);
-        delta.pushKV("height", it->first.blockHeight);
-        delta.pushKV("address", address);
-        result.push_back(delta);
-    }
-
-    return result;
+        writer.EndArray();
+    });
 }
 
 static UniValue getaddressbalance(const JSONRPCRequest& request)
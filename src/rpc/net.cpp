@@ -74,6 +74,21 @@ static UniValue ping(const JSONRPCRequest& request)
     return NullUniValue;
 }
 
+static UniValue MsgCostToJSON(const mapMsgCmdCost& mapCost)
+{
+    UniValue ret(UniValue::VOBJ);
+    for (const auto& i : mapCost) {
+        UniValue cost(UniValue::VOBJ);
+        cost.pushKV("count", i.second.nCount);
+        cost.pushKV("time", i.second.nProcessTime);
+        cost.pushKV("cputime", i.second.nCPUTime);
+        cost.pushKV("queuetime", i.second.nQueueTime);
+        cost.pushKV("maxtime", i.second.nMaxProcessTime);
+        ret.pushKV(i.first, cost);
+    }
+    return ret;
+}
+
 static UniValue getpeerinfo(const JSONRPCRequest& request)
 {
     if (request.fHelp || request.params.size() != 0)
@@ -135,6 +150,17 @@ static UniValue getpeerinfo(const JSONRPCRequest& request)
             "                               When a message type is not listed in this json object, the bytes received are 0.\n"
             "                               Only known message types can appear as keys in the object and all bytes received of unknown message types are listed under '"+NET_MESSAGE_COMMAND_OTHER+"'.\n"
             "       ...\n"
+            "    },\n"
+            "    \"cost_per_msg\" : {\n"
+            "       \"msg\" : {              (json object) The cost of processing the messages of this type received from the peer,\n"
+            "                               unknown message types are listed under '"+NET_MESSAGE_COMMAND_OTHER+"'. See getnetmsgstats\n"
+            "         \"count\" : n,          (numeric) The number of messages processed\n"
+            "         \"time\" : n,           (numeric) The wall clock time spent processing them in microseconds\n"
+            "         \"cputime\" : n,        (numeric) The CPU time spent processing them in microseconds\n"
+            "         \"queuetime\" : n,      (numeric) The total time they waited in the receive queue in microseconds\n"
+            "         \"maxtime\" : n,        (numeric) The longest time a single message took to process in microseconds\n"
+            "       },\n"
+            "       ...\n"
             "    }\n"
             "  }\n"
             "  ,...\n"
@@ -230,6 +256,7 @@ static UniValue getpeerinfo(const JSONRPCRequest& request)
                 recvPerMsgCmd.pushKV(i.first, i.second);
         }
         obj.pushKV("bytesrecv_per_msg", recvPerMsgCmd);
+        obj.pushKV("cost_per_msg", MsgCostToJSON(stats.mapCostPerMsgCmd));
 
         ret.push_back(obj);
     }
@@ -453,6 +480,39 @@ static UniValue getnettotals(const JSONRPCRequest& request)
     return obj;
 }
 
+static UniValue getnetmsgstats(const JSONRPCRequest& request)
+{
+    if (request.fHelp || request.params.size() > 0)
+        throw std::runtime_error(
+            RPCHelpMan{"getnetmsgstats",
+                "\nReturns the cost of processing the P2P messages received since startup, aggregated by message type\n"
+                "over all peers including the disconnected ones. Use getpeerinfo for the cost per peer.\n"
+                "Messages of unknown type are listed under '" + NET_MESSAGE_COMMAND_OTHER + "'.\n",
+                {},
+                RPCResult{
+                    RPCResult::Type::OBJ_DYN, "", "keys are the message types",
+                    {
+                        {RPCResult::Type::OBJ, "msg", "",
+                        {
+                            {RPCResult::Type::NUM, "count", "The number of messages processed"},
+                            {RPCResult::Type::NUM, "time", "The wall clock time spent processing them in microseconds"},
+                            {RPCResult::Type::NUM, "cputime", "The CPU time spent processing them in microseconds, 0 if the platform can't measure it"},
+                            {RPCResult::Type::NUM, "queuetime", "The total time they waited in the receive queue in microseconds"},
+                            {RPCResult::Type::NUM, "maxtime", "The longest time a single message took to process in microseconds"},
+                        }},
+                    }
+                },
+                RPCExamples{
+                    HelpExampleCli("getnetmsgstats", "")
+            + HelpExampleRpc("getnetmsgstats", "")
+                },
+            }.ToString());
+    if(!g_connman)
+        throw JSONRPCError(RPC_CLIENT_P2P_DISABLED, "Error: Peer-to-peer functionality missing or disabled");
+
+    return MsgCostToJSON(g_connman->GetMsgCostStats());
+}
+
 static UniValue GetNetworksInfo()
 {
     UniValue networks(UniValue::VARR);
@@ -828,6 +888,7 @@ static const CRPCCommand commands[] =
     { "network",            "disconnectnode",         &disconnectnode,         {"address", "nodeid"} },
     { "network",            "getaddednodeinfo",       &getaddednodeinfo,       {"node"} },
     { "network",            "getnettotals",           &getnettotals,           {} },
+    { "network",            "getnetmsgstats",         &getnetmsgstats,         {} },
     { "network",            "getnetworkinfo",         &getnetworkinfo,         {} },
     { "network",            "setban",                 &setban,                 {"subnet", "command", "bantime", "absolute"} },
     { "network",            "listbanned",             &listbanned,             {} },
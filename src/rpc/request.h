@@ -10,6 +10,8 @@
 
 #include <univalue.h>
 
+class JSONStreamWriter;
+
 UniValue JSONRPCRequestObj(const std::string& strMethod, const UniValue& params, const UniValue& id);
 UniValue JSONRPCReplyObj(const UniValue& result, const UniValue& error, const UniValue& id);
 std::string JSONRPCReply(const UniValue& result, const UniValue& error, const UniValue& id);
@@ -34,6 +36,8 @@ public:
     std::string URI;
     std::string authUser;
     std::string peerAddr;
+    /** Set while the result can be streamed into the HTTP reply, see StreamRPCResult */
+    JSONStreamWriter* streamWriter{nullptr};
 
     JSONRPCRequest() : id(NullUniValue), params(NullUniValue), fHelp(false) {}
     void parse(const UniValue& valRequest);
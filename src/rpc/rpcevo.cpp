@@ -17,6 +17,7 @@
 #include <masternode/meta.h>
 #include <messagesigner.h>
 #include <netbase.h>
+#include <rpc/jsonstream.h>
 #include <rpc/server.h>
 #include <rpc/util.h>
 #include <util/moneystr.h>
@@ -1012,8 +1013,6 @@ static UniValue protx_list(const JSONRPCRequest& request)
         type = request.params[1].get_str();
     }
 
-    UniValue ret(UniValue::VARR);
-
     if (g_txindex) {
         g_txindex->BlockUntilSyncedToCurrentChain();
     }
@@ -1044,14 +1043,18 @@ static UniValue protx_list(const JSONRPCRequest& request)
         }
 
         CDeterministicMNList mnList = deterministicMNManager->GetListForBlock(::ChainActive()[height]);
-        mnList.ForEachMN(false, [&](const auto& dmn) {
-            if (setOutpts.count(dmn.collateralOutpoint) ||
-                CheckWalletOwnsKey(pwallet, dmn.pdmnState->keyIDOwner) ||
-                CheckWalletOwnsKey(pwallet, dmn.pdmnState->keyIDVoting) ||
-                CheckWalletOwnsScript(pwallet, dmn.pdmnState->scriptPayout) ||
-                CheckWalletOwnsScript(pwallet, dmn.pdmnState->scriptOperatorPayout)) {
-                ret.push_back(BuildDMNListEntry(pwallet, dmn, detailed));
-            }
+        return StreamRPCResult(request, [&](JSONStreamWriter& writer) {
+            writer.BeginArray();
+            mnList.ForEachMN(false, [&](const auto& dmn) {
+                if (setOutpts.count(dmn.collateralOutpoint) ||
+                    CheckWalletOwnsKey(pwallet, dmn.pdmnState->keyIDOwner) ||
+                    CheckWalletOwnsKey(pwallet, dmn.pdmnState->keyIDVoting) ||
+                    CheckWalletOwnsScript(pwallet, dmn.pdmnState->scriptPayout) ||
+                    CheckWalletOwnsScript(pwallet, dmn.pdmnState->scriptOperatorPayout)) {
+                    writer.Value(BuildDMNListEntry(pwallet, dmn, detailed));
+                }
+            });
+            writer.EndArray();
         });
 #endif
     } else if (type == "valid" || type == "registered") {
@@ -1070,14 +1073,18 @@ static UniValue protx_list(const JSONRPCRequest& request)
 
         CDeterministicMNList mnList = deterministicMNManager->GetListForBlock(::ChainActive()[height]);
         bool onlyValid = type == "valid";
-        mnList.ForEachMN(onlyValid, [&](const auto& dmn) {
-            ret.push_back(BuildDMNListEntry(pwallet, dmn, detailed));
+        return StreamRPCResult(request, [&](JSONStreamWriter& writer) {
+            writer.BeginArray();
+            mnList.ForEachMN(onlyValid, [&](const auto& dmn) {
+                writer.Value(BuildDMNListEntry(pwallet, dmn, detailed));
+            });
+            writer.EndArray();
         });
     } else {
         throw JSONRPCError(RPC_INVALID_PARAMETER, "invalid type specified");
     }
 
-    return ret;
+    return NullUniValue;
 }
 
 static void protx_info_help(const JSONRPCRequest& request)
@@ -1307,6 +1314,42 @@ static UniValue bls_fromsecret(const JSONRPCRequest& request)
     return ret;
 }
 
+static void bls_cacheinfo_help(const JSONRPCRequest& request)
+{
+    RPCHelpMan{"bls cacheinfo",
+        "\nReturns statistics of the BLS signature verification cache.\n",
+        {},
+        RPCResult{
+    "{\n"
+    "  \"hits\" : n,              (numeric) Number of verifications answered from the cache\n"
+    "  \"misses\" : n,            (numeric) Number of verifications which required a pairing check\n"
+    "  \"hitrate\" : x.xxx,       (numeric) Ratio of hits to all lookups\n"
+    "  \"maxentries\" : n,        (numeric) Number of entries the cache is able to store\n"
+    "}\n"
+        },
+        RPCExamples{
+            HelpExampleCli("bls cacheinfo", "")
+        },
+    }.Check(request);
+}
+
+static UniValue bls_cacheinfo(const JSONRPCRequest& request)
+{
+    if (request.fHelp || request.params.size() != 1) {
+        bls_cacheinfo_help(request);
+    }
+
+    const CBLSSignatureCacheStats stats = GetBLSSignatureCacheStats();
+    const uint64_t nLookups = stats.nHits + stats.nMisses;
+
+    UniValue ret(UniValue::VOBJ);
+    ret.pushKV("hits", stats.nHits);
+    ret.pushKV("misses", stats.nMisses);
+    ret.pushKV("hitrate", nLookups == 0 ? 0.0 : (double)stats.nHits / nLookups);
+    ret.pushKV("maxentries", (uint64_t)stats.nMaxEntries);
+    return ret;
+}
+
 [[ noreturn ]] static void bls_help()
 {
     RPCHelpMan{"bls",
@@ -1314,7 +1357,8 @@ static UniValue bls_fromsecret(const JSONRPCRequest& request)
         "To get help on individual commands, use \"help bls command\".\n"
         "\nAvailable commands:\n"
         "  generate          - Create a BLS secret/public key pair\n"
-        "  fromsecret        - Parse a BLS secret key and return the secret/public key pair\n",
+        "  fromsecret        - Parse a BLS secret key and return the secret/public key pair\n"
+        "  cacheinfo         - Show statistics of the BLS signature verification cache\n",
         {
             {"command", RPCArg::Type::STR, RPCArg::Optional::NO, "The command to execute"},
         },
@@ -1338,6 +1382,8 @@ static UniValue _bls(const JSONRPCRequest& request)
         return bls_generate(request);
     } else if (command == "fromsecret") {
         return bls_fromsecret(request);
+    } else if (command == "cacheinfo") {
+        return bls_cacheinfo(request);
     } else {
         bls_help();
     }
@@ -6,6 +6,7 @@
 
 #include <chainparams.h>
 #include <consensus/params.h>
+#include <dbwrapper.h>
 #include <key_io.h>
 #include <logging.h>
 #include <messagesigner.h>
@@ -23,6 +24,9 @@
 
 CSporkManager sporkManager;
 
+static const std::string DB_SPORK_BY_HASH = "spork_H";
+static const std::string DB_SPORK_ACTIVE = "spork_A";
+
 bool CSporkManager::SporkValueIsActive(SporkId nSporkID, int64_t& nActiveValueRet) const
 {
     AssertLockHeld(cs);
@@ -67,12 +71,18 @@ void CSporkManager::CheckAndRemove()
     LOCK(cs);
     assert(!setSporkPubKeyIDs.empty());
 
+    std::unique_ptr<CDBBatch> batch = m_db ? std::make_unique<CDBBatch>(*m_db) : nullptr;
+
     for (auto itActive = mapSporksActive.begin(); itActive != mapSporksActive.end();) {
         auto itSignerPair = itActive->second.begin();
         while (itSignerPair != itActive->second.end()) {
             bool fHasValidSig = setSporkPubKeyIDs.find(itSignerPair->first) != setSporkPubKeyIDs.end() &&
                                 itSignerPair->second.CheckSignature(itSignerPair->first);
             if (!fHasValidSig) {
+                if (batch) {
+                    batch->Erase(std::make_pair(DB_SPORK_BY_HASH, itSignerPair->second.GetHash()));
+                    batch->Erase(std::make_pair(DB_SPORK_ACTIVE, std::make_pair(itActive->first, itSignerPair->first)));
+                }
                 mapSporksByHash.erase(itSignerPair->second.GetHash());
                 itActive->second.erase(itSignerPair++);
                 continue;
@@ -95,11 +105,73 @@ void CSporkManager::CheckAndRemove()
             }
         }
         if (!found) {
+            if (batch) {
+                batch->Erase(std::make_pair(DB_SPORK_BY_HASH, itByHash->first));
+            }
             mapSporksByHash.erase(itByHash++);
             continue;
         }
         ++itByHash;
     }
+
+    if (batch) {
+        m_db->WriteBatch(*batch);
+    }
+}
+
+void CSporkManager::ConnectCacheDB(CDBWrapper& db)
+{
+    {
+        LOCK(cs);
+        m_db = &db;
+
+        // Keep the messages imported from the flat file of older versions
+        for (const auto& [_, signers] : mapSporksActive) {
+            for (const auto& [keyIDSigner, spork] : signers) {
+                WriteSpork(keyIDSigner, spork);
+            }
+        }
+        CDBBatch batch(db);
+        for (const auto& [hash, spork] : mapSporksByHash) {
+            batch.Write(std::make_pair(DB_SPORK_BY_HASH, hash), spork);
+        }
+        db.WriteBatch(batch, true);
+
+        std::unique_ptr<CDBIterator> it(db.NewIterator());
+        std::pair<std::string, uint256> keyByHash;
+        for (it->Seek(DB_SPORK_BY_HASH); it->Valid() && it->GetKey(keyByHash) && keyByHash.first == DB_SPORK_BY_HASH; it->Next()) {
+            CSporkMessage spork;
+            if (it->GetValue(spork)) {
+                mapSporksByHash.emplace(keyByHash.second, spork);
+            }
+        }
+        std::pair<std::string, std::pair<SporkId, CKeyID>> keyActive;
+        for (it->Seek(DB_SPORK_ACTIVE); it->Valid() && it->GetKey(keyActive) && keyActive.first == DB_SPORK_ACTIVE; it->Next()) {
+            CSporkMessage spork;
+            if (it->GetValue(spork)) {
+                mapSporksActive[keyActive.second.first].emplace(keyActive.second.second, spork);
+            }
+        }
+        LogPrintf("CSporkManager::%s -- loaded %d spork messages\n", __func__, mapSporksByHash.size());
+    }
+    CheckAndRemove();
+}
+
+void CSporkManager::DisconnectCacheDB()
+{
+    LOCK(cs);
+    m_db = nullptr;
+}
+
+void CSporkManager::WriteSpork(const CKeyID& keyIDSigner, const CSporkMessage& spork)
+{
+    AssertLockHeld(cs);
+    if (!m_db) return;
+
+    CDBBatch batch(*m_db);
+    batch.Write(std::make_pair(DB_SPORK_BY_HASH, spork.GetHash()), spork);
+    batch.Write(std::make_pair(DB_SPORK_ACTIVE, std::make_pair(spork.nSporkID, keyIDSigner)), spork);
+    m_db->WriteBatch(batch);
 }
 
 void CSporkManager::ProcessSporkMessages(CNode* pfrom, std::string_view strCommand, CDataStream& vRecv, CConnman& connman)
@@ -166,6 +238,7 @@ void CSporkManager::ProcessSpork(const CNode* pfrom, std::string_view strCommand
         LOCK(cs); // make sure to not lock this together with cs_main
         mapSporksByHash[hash] = spork;
         mapSporksActive[spork.nSporkID][keyIDSigner] = spork;
+        WriteSpork(keyIDSigner, spork);
         // Clear cached values on new spork being processed
         WITH_LOCK(cs_mapSporksCachedActive, mapSporksCachedActive.erase(spork.nSporkID));
         WITH_LOCK(cs_mapSporksCachedValues, mapSporksCachedValues.erase(spork.nSporkID));
@@ -208,6 +281,7 @@ bool CSporkManager::UpdateSpork(SporkId nSporkID, int64_t nValue, CConnman& conn
 
         mapSporksByHash[spork.GetHash()] = spork;
         mapSporksActive[nSporkID][keyIDSigner] = spork;
+        WriteSpork(keyIDSigner, spork);
         // Clear cached values on new spork being processed
         WITH_LOCK(cs_mapSporksCachedActive, mapSporksCachedActive.erase(spork.nSporkID));
         WITH_LOCK(cs_mapSporksCachedValues, mapSporksCachedValues.erase(spork.nSporkID));
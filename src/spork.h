@@ -19,6 +19,7 @@
 #include <vector>
 
 class CConnman;
+class CDBWrapper;
 class CNode;
 class CDataStream;
 
@@ -184,12 +185,19 @@ private:
     int nMinSporkKeys GUARDED_BY(cs);
     CKey sporkPrivKey GUARDED_BY(cs);
 
+    CDBWrapper* m_db GUARDED_BY(cs){nullptr};
+
     /**
      * SporkValueIsActive is used to get the value agreed upon by the majority
      * of signed spork messages for a given Spork ID.
      */
     bool SporkValueIsActive(SporkId nSporkID, int64_t& nActiveValueRet) const EXCLUSIVE_LOCKS_REQUIRED(cs);
 
+    /**
+     * WriteSpork stores an accepted spork message in the cache database, if one is connected.
+     */
+    void WriteSpork(const CKeyID& keyIDSigner, const CSporkMessage& spork) EXCLUSIVE_LOCKS_REQUIRED(cs);
+
 public:
 
     CSporkManager() = default;
@@ -235,6 +243,19 @@ public:
      */
     void CheckAndRemove() LOCKS_EXCLUDED(cs);
 
+    /**
+     * ConnectCacheDB makes db the persistent store of the spork messages. Messages
+     * already in memory, e.g. imported from an old sporks.dat, are written to it,
+     * then all stored messages are loaded and checked by CheckAndRemove. From now
+     * on every accepted spork message is written to db as soon as it is processed.
+     */
+    void ConnectCacheDB(CDBWrapper& db) LOCKS_EXCLUDED(cs);
+
+    /**
+     * DisconnectCacheDB stops using the database set by ConnectCacheDB.
+     */
+    void DisconnectCacheDB() LOCKS_EXCLUDED(cs);
+
     /**
      * ProcessSporkMessages is used to call ProcessSpork and ProcessGetSporks. See below
      */
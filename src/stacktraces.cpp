@@ -526,6 +526,7 @@ static void PrintCrashInfo(const crash_info& ci)
 {
     auto str = GetCrashInfoStr(ci);
     LogPrintf("%s", str); /* Continued */
+    LogInstance().FlushAsyncLogging();
     tfm::format(std::cerr, "%s", str);
     fflush(stderr);
 }
@@ -35,8 +35,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <random.h>
 #include <util/system.h>
 
+#include <sync.h>
+
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstdio>
+#include <unordered_map>
+#include <vector>
 
 statsd::StatsdClient statsClient;
 
@@ -61,6 +67,23 @@ inline bool should_send(float sample_rate)
     return sample_rate > p;
 }
 
+/** Metrics aggregated by one thread since the last flush */
+struct StatsdShard {
+    struct Timings {
+        std::vector<size_t> values;
+        uint64_t total{0};
+    };
+
+    Mutex cs;
+    std::unordered_map<std::string, int64_t> counts GUARDED_BY(cs);
+    /** Gauge values by key, with a sequence number to find the latest one across shards */
+    std::unordered_map<std::string, std::pair<uint64_t, std::string>> gauges GUARDED_BY(cs);
+    std::unordered_map<std::string, Timings> timings GUARDED_BY(cs);
+};
+
+static std::atomic<uint64_t> g_statsd_client_id{0};
+static std::atomic<uint64_t> g_statsd_gauge_seq{0};
+
 struct _StatsdClientData {
     SOCKET  sock;
     struct  sockaddr_in server;
@@ -72,6 +95,23 @@ struct _StatsdClientData {
     bool    init;
 
     char    errmsg[1024];
+
+    const uint64_t id{++g_statsd_client_id};
+    std::atomic<bool> aggregate{false};
+    Mutex cs_shards;
+    std::vector<std::shared_ptr<StatsdShard>> shards GUARDED_BY(cs_shards);
+
+    /** The shard of the calling thread, it is created on first use */
+    StatsdShard& GetShard()
+    {
+        static thread_local std::pair<uint64_t, std::shared_ptr<StatsdShard>> t_shard;
+        if (t_shard.first != id) {
+            auto shard = std::make_shared<StatsdShard>();
+            WITH_LOCK(cs_shards, shards.emplace_back(shard));
+            t_shard = std::make_pair(id, std::move(shard));
+        }
+        return *t_shard.second;
+    }
 };
 
 StatsdClient::StatsdClient(const std::string& host, int port, const std::string& ns) :
@@ -152,24 +192,147 @@ int StatsdClient::inc(const std::string& key, float sample_rate)
 
 int StatsdClient::count(const std::string& key, size_t value, float sample_rate)
 {
+    if (d->aggregate) {
+        auto& shard = d->GetShard();
+        LOCK(shard.cs);
+        shard.counts[key] += (int64_t)value;
+        return 0;
+    }
     return send(key, value, "c", sample_rate);
 }
 
 int StatsdClient::gauge(const std::string& key, size_t value, float sample_rate)
 {
+    if (d->aggregate) {
+        auto& shard = d->GetShard();
+        LOCK(shard.cs);
+        shard.gauges[key] = std::make_pair(g_statsd_gauge_seq++, strprintf("%d", (ssize_t)value));
+        return 0;
+    }
     return send(key, value, "g", sample_rate);
 }
 
 int StatsdClient::gaugeDouble(const std::string& key, double value, float sample_rate)
 {
+    if (d->aggregate) {
+        auto& shard = d->GetShard();
+        LOCK(shard.cs);
+        shard.gauges[key] = std::make_pair(g_statsd_gauge_seq++, strprintf("%f", value));
+        return 0;
+    }
     return sendDouble(key, value, "g", sample_rate);
 }
 
 int StatsdClient::timing(const std::string& key, size_t ms, float sample_rate)
 {
+    if (d->aggregate) {
+        auto& shard = d->GetShard();
+        LOCK(shard.cs);
+        auto& timings = shard.timings[key];
+        if (timings.values.size() < STATSD_MAX_TIMING_SAMPLES) {
+            timings.values.emplace_back(ms);
+        }
+        timings.total++;
+        return 0;
+    }
     return send(key, ms, "ms", sample_rate);
 }
 
+void StatsdClient::setAggregate(bool aggregate)
+{
+    d->aggregate = aggregate;
+}
+
+std::vector<std::string> StatsdClient::takeDatagrams()
+{
+    std::vector<std::shared_ptr<StatsdShard>> shards;
+    {
+        LOCK(d->cs_shards);
+        // shards of threads which are gone are flushed one last time
+        shards = d->shards;
+        d->shards.erase(std::remove_if(d->shards.begin(), d->shards.end(), [](const std::shared_ptr<StatsdShard>& shard) {
+            return shard.use_count() == 2;
+        }), d->shards.end());
+    }
+
+    std::unordered_map<std::string, int64_t> counts;
+    std::unordered_map<std::string, std::pair<uint64_t, std::string>> gauges;
+    std::unordered_map<std::string, StatsdShard::Timings> timings;
+    for (const auto& shard : shards) {
+        LOCK(shard->cs);
+        for (const auto& [key, value] : shard->counts) {
+            counts[key] += value;
+        }
+        for (auto& [key, value] : shard->gauges) {
+            auto& gauge = gauges[key];
+            if (gauge.second.empty() || gauge.first < value.first) {
+                gauge = std::move(value);
+            }
+        }
+        for (auto& [key, value] : shard->timings) {
+            auto& timing = timings[key];
+            timing.values.insert(timing.values.end(), value.values.begin(), value.values.end());
+            timing.total += value.total;
+        }
+        shard->counts.clear();
+        shard->gauges.clear();
+        shard->timings.clear();
+    }
+
+    std::vector<std::string> datagrams;
+    std::string datagram;
+    const auto add = [&](std::string key, const std::string& value, const char* type, float sample_rate) {
+        // partition stats by node name if set
+        if (!d->nodename.empty())
+            key = key + "." + d->nodename;
+
+        cleanup(key);
+
+        std::string line = d->ns + key + ":" + value + "|" + type;
+        if (!fequal(sample_rate, 1.0)) {
+            line += strprintf("|@%f", sample_rate);
+        }
+        // a line which is too long on its own still gets a datagram of its own
+        if (!datagram.empty() && datagram.size() + 1 + line.size() > STATSD_MAX_DATAGRAM_SIZE) {
+            datagrams.emplace_back(std::move(datagram));
+            datagram.clear();
+        }
+        if (!datagram.empty()) {
+            datagram += '\n';
+        }
+        datagram += line;
+    };
+
+    for (const auto& [key, value] : counts) {
+        add(key, strprintf("%d", value), "c", 1.0);
+    }
+    for (const auto& [key, value] : gauges) {
+        add(key, value.second, "g", 1.0);
+    }
+    for (const auto& [key, value] : timings) {
+        // when samples were left out, tell the server what fraction was sent
+        const float sample_rate = value.values.size() < value.total ? (float)value.values.size() / value.total : 1.0;
+        for (size_t ms : value.values) {
+            add(key, strprintf("%d", ms), "ms", sample_rate);
+        }
+    }
+    if (!datagram.empty()) {
+        datagrams.emplace_back(std::move(datagram));
+    }
+    return datagrams;
+}
+
+void StatsdClient::flush()
+{
+    const std::vector<std::string> datagrams = takeDatagrams();
+    if (init() != 0) {
+        return;
+    }
+    for (const std::string& datagram : datagrams) {
+        send(datagram);
+    }
+}
+
 int StatsdClient::send(std::string key, size_t value, const std::string& type, float sample_rate)
 {
     if (!should_send(sample_rate)) {
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 
 static const bool DEFAULT_STATSD_ENABLE = false;
 static const int DEFAULT_STATSD_PORT = 8125;
@@ -15,6 +16,13 @@ static const int DEFAULT_STATSD_PERIOD = 60;
 static const int MIN_STATSD_PERIOD = 5;
 static const int MAX_STATSD_PERIOD = 60 * 60;
 
+// aggregate metrics on the client and send them every n milliseconds, 0 sends every metric right away
+static const int DEFAULT_STATSD_FLUSH_INTERVAL = 1000;
+// metrics are packed into datagrams of at most this size
+static const size_t STATSD_MAX_DATAGRAM_SIZE = 1432;
+// timing samples kept per key between flushes, the rest is accounted for by the sample rate
+static const size_t STATSD_MAX_TIMING_SAMPLES = 1000;
+
 namespace statsd {
 
 struct _StatsdClientData;
@@ -30,6 +38,13 @@ class StatsdClient {
         const char* errmsg();
 
     public:
+        /**
+         * With aggregation enabled the metric calls below don't send anything.
+         * Counters are summed up, the last value of a gauge is kept and timings
+         * are collected in a per-thread shard, flush() sends them all in as few
+         * datagrams as possible. Aggregated counters are exact, the sample rate
+         * only applies when sending right away.
+         */
         int inc(const std::string& key, float sample_rate = 1.0);
         int dec(const std::string& key, float sample_rate = 1.0);
         int count(const std::string& key, size_t value, float sample_rate = 1.0);
@@ -37,6 +52,17 @@ class StatsdClient {
         int gaugeDouble(const std::string& key, double value, float sample_rate = 1.0);
         int timing(const std::string& key, size_t ms, float sample_rate = 1.0);
 
+        /** Aggregate metrics from now on, see DEFAULT_STATSD_FLUSH_INTERVAL */
+        void setAggregate(bool aggregate);
+        /** Send all aggregated metrics */
+        void flush();
+        /**
+         * Take the aggregated metrics of all threads and pack them into
+         * datagrams of at most STATSD_MAX_DATAGRAM_SIZE bytes, one line per
+         * metric. A line which doesn't fit on its own is sent by itself.
+         */
+        std::vector<std::string> takeDatagrams();
+
     public:
         /**
          * (Low Level Api) manually send a message
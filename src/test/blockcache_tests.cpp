@@ -0,0 +1,83 @@
+// Copyright (c) 2026 The PirateCash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <arith_uint256.h>
+#include <chainparams.h>
+#include <node/blockcache.h>
+#include <primitives/block.h>
+#include <test/util/setup_common.h>
+#include <undo.h>
+#include <validation.h>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(blockcache_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(blockcache_lru)
+{
+    CBlockCache cache(2);
+    std::vector<uint256> hashes;
+    for (int i = 0; i < 6; i++) {
+        hashes.emplace_back(ArithToUint256(arith_uint256(i + 1)));
+    }
+
+    for (int i = 0; i < 5; i++) {
+        cache.AddBlock(hashes[i], std::make_shared<const CBlock>());
+    }
+    // refresh the oldest entry, the next insert truncates to the two most recently used ones
+    auto block = cache.GetBlock(hashes[0]);
+    BOOST_CHECK(block);
+    cache.AddBlock(hashes[5], std::make_shared<const CBlock>());
+
+    BOOST_CHECK(cache.GetBlock(hashes[0]) == block);
+    BOOST_CHECK(cache.GetBlock(hashes[1]) == nullptr);
+    BOOST_CHECK(cache.GetBlock(hashes[3]) == nullptr);
+    BOOST_CHECK(cache.GetBlock(hashes[4]));
+    BOOST_CHECK(cache.GetBlock(hashes[5]));
+
+    BOOST_CHECK(cache.GetUndo(hashes[0]) == nullptr);
+    cache.AddUndo(hashes[0], std::make_shared<const CBlockUndo>());
+    BOOST_CHECK(cache.GetUndo(hashes[0]));
+
+    const CBlockCache::Stats stats = cache.GetStats();
+    BOOST_CHECK_EQUAL(stats.nBlockHits, 4U);
+    BOOST_CHECK_EQUAL(stats.nBlockMisses, 2U);
+    BOOST_CHECK_EQUAL(stats.nUndoHits, 1U);
+    BOOST_CHECK_EQUAL(stats.nUndoMisses, 1U);
+
+    cache.Clear();
+    BOOST_CHECK(cache.GetBlock(hashes[5]) == nullptr);
+}
+
+BOOST_FIXTURE_TEST_CASE(blockcache_shared_reads, TestChain100Setup)
+{
+    const CBlockIndex* tip = WITH_LOCK(cs_main, return ::ChainActive().Tip());
+    const Consensus::Params& params = Params().GetConsensus();
+
+    // the connected tip is handed out without touching the disk again
+    auto pblock1 = ReadSharedBlockFromDisk(tip, params);
+    auto pblock2 = ReadSharedBlockFromDisk(tip, params);
+    BOOST_REQUIRE(pblock1);
+    BOOST_CHECK(pblock1 == pblock2);
+    BOOST_CHECK(pblock1->GetHash() == tip->GetBlockHash());
+
+    // reads into a caller owned block share the transactions
+    CBlock block;
+    BOOST_CHECK(ReadBlockFromDisk(block, tip, params));
+    BOOST_CHECK(block.vtx[0] == pblock1->vtx[0]);
+
+    // a cold cache falls back to the disk and repopulates the cache
+    g_block_cache.Clear();
+    auto pblock3 = ReadSharedBlockFromDisk(tip, params);
+    BOOST_REQUIRE(pblock3);
+    BOOST_CHECK(pblock3 != pblock1);
+    BOOST_CHECK(pblock3->GetHash() == pblock1->GetHash());
+    BOOST_CHECK(ReadSharedBlockFromDisk(tip, params) == pblock3);
+
+    CBlockUndo undo;
+    BOOST_CHECK(UndoReadFromDisk(undo, tip));
+    BOOST_CHECK_EQUAL(undo.vtxundo.size(), pblock3->vtx.size() - 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -252,6 +252,22 @@ BOOST_FIXTURE_TEST_CASE(blockfilter_index_initial_sync, TestChain100Setup)
     BOOST_CHECK_EQUAL(filters.size(), tip->nHeight + 1);
     BOOST_CHECK_EQUAL(filter_hashes.size(), tip->nHeight + 1);
 
+    // Encoded filters must match the decoded ones, whether they come from memory or disk.
+    std::vector<EncodedBlockFilter> encoded_filters;
+    BOOST_CHECK(filter_index.LookupEncodedFilterRange(0, tip, encoded_filters));
+    BOOST_REQUIRE_EQUAL(encoded_filters.size(), filters.size());
+    for (size_t i = 0; i < filters.size(); i++) {
+        BOOST_CHECK_EQUAL(encoded_filters[i].block_hash, filters[i].GetBlockHash());
+        BOOST_CHECK(encoded_filters[i].encoded_filter == filters[i].GetEncodedFilter());
+        BOOST_CHECK_EQUAL(filters[i].GetHash(), filter_hashes[i]);
+    }
+    BOOST_CHECK(!filter_index.LookupEncodedFilterRange(tip->nHeight + 1, tip, encoded_filters));
+
+    // No checkpoint heights yet
+    std::vector<uint256> checkpoint_headers;
+    BOOST_CHECK(filter_index.LookupCheckpointHeaders(tip, checkpoint_headers));
+    BOOST_CHECK(checkpoint_headers.empty());
+
     filters.clear();
     filter_hashes.clear();
 
@@ -4,6 +4,9 @@
 
 #include <bls/bls.h>
 #include <bls/bls_batchverifier.h>
+#include <bls/bls_pubkeystore.h>
+#include <bls/bls_worker.h>
+#include <streams.h>
 #include <random.h>
 #include <test/util/setup_common.h>
 
@@ -155,4 +158,124 @@ BOOST_AUTO_TEST_CASE(batch_verifier_tests)
     Verify(msgs);
 }
 
+BOOST_AUTO_TEST_CASE(bls_worker_unbatched_verify_tests)
+{
+    // two valid quorum signatures over different commitments, e.g. of different LLMQ types in the same block
+    CBLSSecretKey sk1, sk2, skX;
+    sk1.MakeNewKey();
+    sk2.MakeNewKey();
+    skX.MakeNewKey();
+    const uint256 hash1 = InsecureRand256();
+    const uint256 hash2 = InsecureRand256();
+    CBLSSignature sig1 = sk1.Sign(hash1);
+    CBLSSignature sig2 = sk2.Sign(hash2);
+
+    // add X to one of them and subtract it from the other, their aggregate stays valid
+    const CBLSSignature sigX = skX.Sign(InsecureRand256());
+    sig1.AggregateInsecure(sigX);
+    sig2.SubInsecure(sigX);
+    CBLSSignature aggSig = CBLSSignature::AggregateInsecure({sig1, sig2});
+    BOOST_CHECK(aggSig.VerifyInsecureAggregated({sk1.GetPublicKey(), sk2.GetPublicKey()}, {hash1, hash2}));
+
+    CBLSWorker worker;
+    worker.Start();
+    auto f1 = worker.AsyncVerifySigUnbatched(sig1, sk1.GetPublicKey(), hash1);
+    auto f2 = worker.AsyncVerifySigUnbatched(sig2, sk2.GetPublicKey(), hash2);
+    BOOST_CHECK(!f1.get());
+    BOOST_CHECK(!f2.get());
+    BOOST_CHECK(worker.AsyncVerifySigUnbatched(sk1.Sign(hash1), sk1.GetPublicKey(), hash1).get());
+    worker.Stop();
+}
+
+BOOST_AUTO_TEST_CASE(bls_sig_cache_tests)
+{
+    CBLSSecretKey sk;
+    sk.MakeNewKey();
+    CBLSPublicKey pk = sk.GetPublicKey();
+    uint256 hash = GetRandHash();
+    uint256 otherHash = GetRandHash();
+    CBLSSignature sig = sk.Sign(hash);
+
+    CBLSSecretKey otherSk;
+    otherSk.MakeNewKey();
+    CBLSSignature badSig = otherSk.Sign(hash);
+
+    BOOST_CHECK(!sig.IsVerificationCached(pk, hash));
+    BOOST_CHECK(sig.VerifyInsecure(pk, hash));
+    BOOST_CHECK(sig.IsVerificationCached(pk, hash));
+
+    // only the exact (pubkey, hash, signature) triple is cached
+    BOOST_CHECK(!sig.IsVerificationCached(pk, otherHash));
+    BOOST_CHECK(!sig.VerifyInsecure(pk, otherHash));
+    BOOST_CHECK(!sig.IsVerificationCached(otherSk.GetPublicKey(), hash));
+
+    // failed verifications are never cached
+    BOOST_CHECK(!badSig.VerifyInsecure(pk, hash));
+    BOOST_CHECK(!badSig.IsVerificationCached(pk, hash));
+
+    const CBLSSignatureCacheStats before = GetBLSSignatureCacheStats();
+    BOOST_CHECK(sig.VerifyInsecure(pk, hash));
+    const CBLSSignatureCacheStats after = GetBLSSignatureCacheStats();
+    BOOST_CHECK_EQUAL(after.nHits, before.nHits + 1);
+    BOOST_CHECK_EQUAL(after.nMisses, before.nMisses);
+    BOOST_CHECK(after.nMaxEntries > 0);
+
+    // a verification which goes through the per-message fallback of the batch verifier is still counted once
+    CBLSBatchVerifier<uint32_t, uint32_t> batchVerifier(false, true);
+    const uint256 hash1 = GetRandHash();
+    const uint256 hash2 = GetRandHash();
+    batchVerifier.PushMessage(0, 0, hash1, sk.Sign(hash1), pk);
+    batchVerifier.PushMessage(0, 1, hash2, otherSk.Sign(hash2), pk);
+    batchVerifier.PushMessage(1, 2, hash, sig, pk);
+    batchVerifier.Verify();
+    BOOST_CHECK(batchVerifier.badSources == std::set<uint32_t>({0}));
+    BOOST_CHECK(batchVerifier.badMessages == std::set<uint32_t>({1}));
+    const CBLSSignatureCacheStats afterBatch = GetBLSSignatureCacheStats();
+    BOOST_CHECK_EQUAL(afterBatch.nHits, after.nHits + 1);
+    BOOST_CHECK_EQUAL(afterBatch.nMisses, after.nMisses + 2);
+}
+
+BOOST_AUTO_TEST_CASE(bls_pubkeystore_tests)
+{
+    CBLSSecretKey sk;
+    sk.MakeNewKey();
+    CBLSPublicKey pk = sk.GetPublicKey();
+
+    const size_t nStoreSize = CBLSPublicKeyStore::Instance().Size();
+    {
+        CBLSInternedPublicKey key1;
+        BOOST_CHECK(!key1.Get().IsValid());
+        key1.Set(pk);
+        BOOST_CHECK(key1.Get() == pk);
+        BOOST_CHECK_EQUAL(CBLSPublicKeyStore::Instance().Size(), nStoreSize + 1);
+
+        // round-trip through serialization ends up with the same entry
+        CDataStream ds(SER_NETWORK, PROTOCOL_VERSION);
+        ds << key1;
+        BOOST_CHECK_EQUAL(ds.size(), (size_t)BLS_CURVE_PUBKEY_SIZE);
+        CBLSInternedPublicKey key2;
+        ds >> key2;
+        BOOST_CHECK(key1 == key2);
+        BOOST_CHECK(&key1.Get() == &key2.Get());
+        BOOST_CHECK_EQUAL(CBLSPublicKeyStore::Instance().Size(), nStoreSize + 1);
+
+        // hash must match the lazy wrapper
+        CBLSLazyPublicKey lazy;
+        lazy.Set(pk);
+        BOOST_CHECK(key2.GetHash() == lazy.GetHash());
+        BOOST_CHECK(::SerializeHash(key2) == ::SerializeHash(lazy));
+
+        // null keys are not stored
+        CBLSInternedPublicKey key3;
+        key3.Set(CBLSPublicKey());
+        BOOST_CHECK(key3 == CBLSInternedPublicKey());
+        BOOST_CHECK(key3 != key1);
+        CBLSLazyPublicKey lazyNull;
+        BOOST_CHECK(key3.GetHash() == lazyNull.GetHash());
+        BOOST_CHECK_EQUAL(CBLSPublicKeyStore::Instance().Size(), nStoreSize + 1);
+    }
+    // entry is released with the last reference
+    BOOST_CHECK_EQUAL(CBLSPublicKeyStore::Instance().Size(), nStoreSize);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
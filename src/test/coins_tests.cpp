@@ -880,4 +880,51 @@ BOOST_AUTO_TEST_CASE(ccoins_write)
                     CheckWriteCoins(parent_value, child_value, parent_value, parent_flags, child_flags, parent_flags);
 }
 
+BOOST_AUTO_TEST_CASE(ccoins_snapshot_cursors)
+{
+    CCoinsViewDB db{"test_snapshot", /*nCacheSize*/ 1 << 23, /*fMemory*/ true, /*fWipe*/ false};
+    std::set<COutPoint> expected;
+    {
+        CCoinsViewCache cache(&db);
+        for (int i = 0; i < 1000; i++) {
+            COutPoint outpoint(InsecureRand256(), InsecureRandBits(2));
+            cache.AddCoin(outpoint, Coin(CTxOut(InsecureRandRange(1000), CScript() << OP_TRUE), 1, false, false), false);
+            expected.insert(outpoint);
+        }
+        cache.SetBestBlock(InsecureRand256());
+        BOOST_CHECK(cache.Flush());
+    }
+
+    for (const unsigned int count : {1, 3, 8}) {
+        auto cursors = db.SnapshotCursors(count);
+        BOOST_CHECK_EQUAL(cursors.size(), count);
+
+        // coins written after the snapshot are not visible
+        CCoinsViewCache cache(&db);
+        cache.AddCoin(COutPoint(InsecureRand256(), 0), Coin(CTxOut(1, CScript() << OP_TRUE), 2, false, false), false);
+        cache.SetBestBlock(InsecureRand256());
+        BOOST_CHECK(cache.Flush());
+
+        std::set<COutPoint> found;
+        for (const auto& cursor : cursors) {
+            BOOST_CHECK(cursor->GetBestBlock() == cursors.front()->GetBestBlock());
+            for (; cursor->Valid(); cursor->Next()) {
+                COutPoint outpoint;
+                Coin coin;
+                BOOST_CHECK(cursor->GetKey(outpoint));
+                BOOST_CHECK(cursor->GetValue(coin));
+                BOOST_CHECK(found.insert(outpoint).second);
+            }
+        }
+        BOOST_CHECK(found == expected);
+
+        std::unique_ptr<CCoinsViewCursor> cursor(db.Cursor());
+        for (; cursor->Valid(); cursor->Next()) {
+            COutPoint outpoint;
+            BOOST_CHECK(cursor->GetKey(outpoint));
+            expected.insert(outpoint);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
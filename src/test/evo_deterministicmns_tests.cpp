@@ -656,6 +656,63 @@ BOOST_FIXTURE_TEST_CASE(dip3_verify_db, TestChainDIP3Setup)
     BOOST_ASSERT(CVerifyDB().VerifyDB(Params(), &::ChainstateActive().CoinsTip(), 4, 2));
 }
 
+BOOST_FIXTURE_TEST_CASE(dip3_list_side_indexes, BasicTestingSetup)
+{
+    CDeterministicMNList mnList(uint256(), 100, 0);
+    std::vector<uint256> proTxHashes;
+    for (int i = 0; i < 10; i++) {
+        auto dmn = std::make_shared<CDeterministicMN>(i);
+        dmn->proTxHash = InsecureRand256();
+        dmn->collateralOutpoint = COutPoint(InsecureRand256(), 0);
+        auto state = std::make_shared<CDeterministicMNState>();
+        state->keyIDOwner = CKeyID(uint160(std::vector<unsigned char>(dmn->proTxHash.begin(), dmn->proTxHash.begin() + 20)));
+        state->nRegisteredHeight = 90 + i;
+        dmn->pdmnState = state;
+        mnList.AddMN(dmn);
+        proTxHashes.emplace_back(dmn->proTxHash);
+    }
 
+    auto collect = [](const CDeterministicMNList& list, bool penalized) {
+        std::set<uint256> ret;
+        auto cb = [&](const CDeterministicMN& dmn) { ret.emplace(dmn.proTxHash); };
+        if (penalized) {
+            list.ForEachPoSePenalizedMN(cb);
+        } else {
+            list.ForEachUnconfirmedMN(cb);
+        }
+        return ret;
+    };
+    BOOST_CHECK_EQUAL(collect(mnList, false).size(), 10U);
+    BOOST_CHECK(collect(mnList, true).empty());
+
+    // confirm one, punish two (one of them until banned) and remove one
+    CDeterministicMNList oldList = mnList;
+    auto newState = std::make_shared<CDeterministicMNState>(*mnList.GetMN(proTxHashes[0])->pdmnState);
+    newState->UpdateConfirmedHash(proTxHashes[0], InsecureRand256());
+    mnList.UpdateMN(proTxHashes[0], newState);
+    mnList.PoSePunish(proTxHashes[1], 1, false);
+    mnList.PoSePunish(proTxHashes[2], mnList.CalcMaxPoSePenalty(), false);
+    mnList.RemoveMN(proTxHashes[3]);
+
+    BOOST_CHECK_EQUAL(collect(mnList, false).size(), 8U);
+    BOOST_CHECK(!collect(mnList, false).count(proTxHashes[0]));
+    BOOST_CHECK(collect(mnList, true) == std::set<uint256>({proTxHashes[1]}));
+
+    // the list it was copied from is not affected
+    BOOST_CHECK_EQUAL(collect(oldList, false).size(), 10U);
+    BOOST_CHECK(collect(oldList, true).empty());
+
+    mnList.PoSeDecrease(proTxHashes[1]);
+    BOOST_CHECK(collect(mnList, true).empty());
+
+    // indexes are rebuilt when the list is loaded
+    mnList.PoSePunish(proTxHashes[4], 1, false);
+    CDataStream ss(SER_DISK, CLIENT_VERSION);
+    ss << mnList;
+    CDeterministicMNList mnList2;
+    ss >> mnList2;
+    BOOST_CHECK(collect(mnList2, false) == collect(mnList, false));
+    BOOST_CHECK(collect(mnList2, true) == std::set<uint256>({proTxHashes[4]}));
+}
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,95 @@
+// Copyright (c) 2026 The PirateCash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bloom.h>
+#include <net.h>
+#include <net_filtermatcher.h>
+#include <random.h>
+#include <script/standard.h>
+#include <txmempool.h>
+#include <validation.h>
+
+#include <test/util/setup_common.h>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(filtermatcher_tests, TestingSetup)
+
+static CTransactionRef AddToMempool(const std::vector<COutPoint>& vPrevouts, const std::vector<CScript>& vScripts)
+{
+    CMutableTransaction mtx;
+    for (const auto& prevout : vPrevouts) {
+        mtx.vin.emplace_back(prevout);
+    }
+    for (const auto& script : vScripts) {
+        mtx.vout.emplace_back(1 * COIN, script);
+    }
+    CTransactionRef tx = MakeTransactionRef(mtx);
+    TestMemPoolEntryHelper entry;
+    LOCK2(cs_main, mempool.cs);
+    mempool.addUnchecked(entry.FromTx(tx));
+    return tx;
+}
+
+BOOST_AUTO_TEST_CASE(filtermatcher_matches_serial)
+{
+    std::vector<unsigned char> vWatched(20);
+    GetRandBytes(vWatched.data(), vWatched.size());
+    const CScript scriptWatched = GetScriptForDestination(CKeyID(uint160(vWatched)));
+    const uint256 hashOther = InsecureRand256();
+    const CScript scriptOther = GetScriptForDestination(CKeyID(uint160(std::vector<unsigned char>(hashOther.begin(), hashOther.begin() + 20))));
+
+    // tx1 pays to the watched key, tx2 only matches because the filter was updated with tx1's outpoint,
+    // tx3 doesn't match, tx4 matches by its own output
+    std::vector<CTransactionRef> vtx;
+    vtx.push_back(AddToMempool({COutPoint(InsecureRand256(), 0)}, {scriptWatched, scriptOther}));
+    vtx.push_back(AddToMempool({COutPoint(vtx[0]->GetHash(), 0)}, {scriptOther}));
+    vtx.push_back(AddToMempool({COutPoint(InsecureRand256(), 0)}, {scriptOther}));
+    vtx.push_back(AddToMempool({COutPoint(InsecureRand256(), 1)}, {scriptOther, scriptWatched}));
+
+    CBloomFilter filter(10, 0.000001, 0, BLOOM_UPDATE_ALL);
+    filter.insert(vWatched);
+
+    // the serial path SendMessages used to run
+    CBloomFilter filterSerial = filter;
+    std::set<uint256> setExpected;
+    for (const auto& tx : vtx) {
+        if (filterSerial.IsRelevantAndUpdate(*tx)) {
+            setExpected.insert(tx->GetHash());
+        }
+    }
+    BOOST_CHECK_EQUAL(setExpected.size(), 3U);
+
+    CAddress addr(CService(CNetAddr(), 0), NODE_NONE);
+    CNode node(0, NODE_NETWORK, 0, INVALID_SOCKET, addr, 0, 0, CAddress(), "", /*fInboundIn=*/ true);
+    {
+        LOCK(node.cs_filter);
+        node.pfilter.reset(new CBloomFilter(filter));
+    }
+    {
+        LOCK(node.cs_inventory);
+        for (const auto& tx : vtx) {
+            node.vInventoryTxToMatch.push_back(tx->GetHash());
+        }
+        node.fMatchMempool = true;
+    }
+
+    CFilterMatcher matcher(*g_connman, mempool);
+    matcher.MatchPeer(node);
+
+    LOCK(node.cs_inventory);
+    BOOST_CHECK(node.vInventoryTxToMatch.empty());
+    BOOST_CHECK(node.setInventoryTxToSend == setExpected);
+    BOOST_CHECK(node.fSendMempoolMatched);
+    BOOST_CHECK(!node.fMatchMempool);
+    {
+        // the filter was updated in the queued order, and matching the mempool finds the same 3 of the 4 transactions
+        LOCK(node.cs_filter);
+        BOOST_CHECK(node.pfilter->contains(COutPoint(vtx[0]->GetHash(), 0)));
+        BOOST_CHECK(node.pfilter->contains(COutPoint(vtx[3]->GetHash(), 1)));
+    }
+    BOOST_CHECK_EQUAL(node.vInventoryMempoolMatched.size(), setExpected.size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
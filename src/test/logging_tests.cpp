@@ -7,6 +7,9 @@
 #include <test/util/setup_common.h>
 
 #include <chrono>
+#include <map>
+#include <thread>
+#include <vector>
 
 #include <boost/test/unit_test.hpp>
 
@@ -33,4 +36,47 @@ BOOST_AUTO_TEST_CASE(logging_timer)
     SetMockTime(0);
 }
 
+BOOST_AUTO_TEST_CASE(logging_async)
+{
+    BCLog::Logger logger;
+    logger.m_log_timestamps = false;
+    std::vector<std::string> lines;
+    logger.PushBackCallback([&lines](const std::string& s) { lines.push_back(s); });
+    BOOST_CHECK(logger.StartLogging());
+    logger.StartAsyncLogging();
+    BOOST_CHECK(logger.IsAsyncLogging());
+
+    constexpr int THREADS = 4;
+    constexpr int MESSAGES = 500;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; t++) {
+        threads.emplace_back([&logger, t] {
+            for (int i = 0; i < MESSAGES; i++) {
+                logger.LogPrintStr(strprintf("%d %d\n", t, i));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // everything queued is written when stopping
+    logger.StopAsyncLogging();
+    BOOST_CHECK(!logger.IsAsyncLogging());
+    BOOST_CHECK_EQUAL(logger.GetAsyncDropped(), 0U);
+    BOOST_CHECK_EQUAL(lines.size(), size_t{THREADS * MESSAGES});
+
+    // messages of one thread keep their order
+    std::map<int, int> next;
+    for (const auto& line : lines) {
+        int t, i;
+        BOOST_REQUIRE(sscanf(line.c_str(), "%d %d", &t, &i) == 2);
+        BOOST_CHECK_EQUAL(i, next[t]++);
+    }
+
+    // back to synchronous logging
+    logger.LogPrintStr("sync\n");
+    BOOST_CHECK_EQUAL(lines.back(), "sync\n");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
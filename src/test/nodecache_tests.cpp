@@ -0,0 +1,66 @@
+// Copyright (c) 2026 The PirateCash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <dbwrapper.h>
+#include <masternode/meta.h>
+#include <netbase.h>
+#include <netfulfilledman.h>
+#include <random.h>
+#include <test/util/setup_common.h>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(nodecache_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(netfulfilled_cache)
+{
+    CDBWrapper db("", 1 << 20, true);
+    const CService addr = LookupNumeric("1.2.3.4", 9999);
+    {
+        CNetFulfilledRequestManager man;
+        man.ConnectCacheDB(db);
+        man.AddFulfilledRequest(addr, "request");
+        man.DisconnectCacheDB();
+    }
+
+    // requests are loaded on first use
+    CNetFulfilledRequestManager man;
+    man.ConnectCacheDB(db);
+    BOOST_CHECK(man.HasFulfilledRequest(addr, "request"));
+    BOOST_CHECK(!man.HasFulfilledRequest(addr, "other"));
+
+    man.RemoveAllFulfilledRequests(addr);
+    CNetFulfilledRequestManager man2;
+    man2.ConnectCacheDB(db);
+    BOOST_CHECK(!man2.HasFulfilledRequest(addr, "request"));
+}
+
+BOOST_AUTO_TEST_CASE(mnmeta_cache)
+{
+    CDBWrapper db("", 1 << 20, true);
+    const uint256 proTxHash = GetRandHash();
+    {
+        CMasternodeMetaMan man;
+        man.ConnectCacheDB(db);
+        man.AllowMixing(proTxHash);
+        man.GetMetaInfo(proTxHash)->SetLastOutboundSuccess(1000);
+        man.DisconnectCacheDB();
+    }
+
+    // meta infos are loaded on first use
+    CMasternodeMetaMan man;
+    man.ConnectCacheDB(db);
+    BOOST_CHECK_EQUAL(man.GetDsqCount(), 1);
+    BOOST_CHECK(man.GetMetaInfo(GetRandHash(), false) == nullptr);
+    auto info = man.GetMetaInfo(proTxHash, false);
+    BOOST_REQUIRE(info != nullptr);
+    BOOST_CHECK_EQUAL(info->GetLastDsq(), 1);
+    BOOST_CHECK_EQUAL(info->GetLastOutboundSuccess(), 1000);
+
+    // clearing wipes the stored meta infos too
+    man.Clear();
+    BOOST_CHECK(man.GetMetaInfo(proTxHash, false) == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
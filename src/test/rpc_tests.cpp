@@ -4,6 +4,7 @@
 
 #include <rpc/server.h>
 #include <rpc/client.h>
+#include <rpc/jsonstream.h>
 #include <rpc/util.h>
 
 #include <core_io.h>
@@ -417,4 +418,73 @@ BOOST_AUTO_TEST_CASE(rpc_getblockstats_calculate_percentiles_by_size)
     }
 }
 
+BOOST_AUTO_TEST_CASE(rpc_json_stream_writer)
+{
+    UniValue entry(UniValue::VOBJ);
+    entry.pushKV("str", "a\"b");
+    entry.pushKV("num", 1.5);
+    entry.pushKV("arr", UniValue(UniValue::VARR));
+
+    UniValue expected(UniValue::VOBJ);
+    UniValue list(UniValue::VARR);
+    for (int i = 0; i < 100; i++) {
+        list.push_back(entry);
+    }
+    expected.pushKV("list", list);
+    expected.pushKV("empty", UniValue(UniValue::VOBJ));
+    expected.pushKV("null", NullUniValue);
+
+    // output is identical to UniValue::write() and handed to the sink in chunks
+    std::string strJSON;
+    size_t nChunks = 0;
+    JSONStreamWriter writer([&](const char* data, size_t size) {
+        strJSON.append(data, size);
+        nChunks++;
+    }, 256);
+    writer.BeginObject();
+    writer.Key("list");
+    writer.BeginArray();
+    for (int i = 0; i < 100; i++) {
+        writer.Value(entry);
+    }
+    writer.EndArray();
+    writer.Key("empty");
+    writer.BeginObject();
+    writer.EndObject();
+    BOOST_CHECK(!writer.IsValuePending());
+    writer.Key("null");
+    BOOST_CHECK(writer.IsValuePending());
+    writer.Value(NullUniValue);
+    writer.EndObject();
+    writer.Flush();
+    BOOST_CHECK_EQUAL(strJSON, expected.write());
+    BOOST_CHECK(nChunks > 1);
+
+    // without a stream writer in the request the result is returned as UniValue
+    JSONRPCRequest request;
+    UniValue result = StreamRPCResult(request, [&](JSONStreamWriter& w) {
+        w.BeginArray();
+        w.Value(entry);
+        w.Value(42);
+        w.EndArray();
+    });
+    BOOST_CHECK_EQUAL(result.write(), "[" + entry.write() + ",42]");
+
+    // with a stream writer waiting for the result it's written there
+    strJSON.clear();
+    JSONStreamWriter replyWriter([&](const char* data, size_t size) { strJSON.append(data, size); });
+    replyWriter.BeginObject();
+    replyWriter.Key("result");
+    request.streamWriter = &replyWriter;
+    result = StreamRPCResult(request, [&](JSONStreamWriter& w) {
+        w.BeginArray();
+        w.Value(42);
+        w.EndArray();
+    });
+    BOOST_CHECK(result.isNull());
+    replyWriter.EndObject();
+    replyWriter.Flush();
+    BOOST_CHECK_EQUAL(strJSON, "{\"result\":[42]}");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
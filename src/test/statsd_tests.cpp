@@ -0,0 +1,132 @@
+// Copyright (c) 2026 The PirateCash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <statsd_client.h>
+
+#include <test/util/setup_common.h>
+#include <tinyformat.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+#include <thread>
+#include <vector>
+
+namespace {
+//! All lines of the given datagrams
+std::vector<std::string> SplitLines(const std::vector<std::string>& datagrams)
+{
+    std::vector<std::string> lines;
+    for (const std::string& datagram : datagrams) {
+        size_t start = 0;
+        while (true) {
+            const size_t end = datagram.find('\n', start);
+            lines.emplace_back(datagram.substr(start, end - start));
+            if (end == std::string::npos) break;
+            start = end + 1;
+        }
+    }
+    return lines;
+}
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(statsd_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(statsd_aggregate_counts_and_gauges)
+{
+    statsd::StatsdClient client("127.0.0.1", DEFAULT_STATSD_PORT, "test.");
+    client.setAggregate(true);
+
+    // counters of all threads are summed up
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([&client, i] {
+            for (int n = 0; n < 100; n++) {
+                client.inc("counter");
+            }
+            client.gauge("gauge", i);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    client.count("counter", 5);
+    client.dec("counter");
+    // the latest value of a gauge wins, no matter which thread set it
+    client.gauge("gauge", 42);
+
+    std::map<std::string, int> count;
+    for (const std::string& line : SplitLines(client.takeDatagrams())) {
+        count[line]++;
+    }
+    BOOST_CHECK_EQUAL(count.size(), 2U);
+    BOOST_CHECK_EQUAL(count["test.counter:404|c"], 1);
+    BOOST_CHECK_EQUAL(count["test.gauge:42|g"], 1);
+
+    // everything was taken
+    BOOST_CHECK(client.takeDatagrams().empty());
+}
+
+BOOST_AUTO_TEST_CASE(statsd_aggregate_timings)
+{
+    statsd::StatsdClient client("127.0.0.1", DEFAULT_STATSD_PORT, "test.");
+    client.setAggregate(true);
+
+    for (size_t i = 0; i < 10; i++) {
+        client.timing("few", i);
+    }
+    for (size_t i = 0; i < STATSD_MAX_TIMING_SAMPLES * 2; i++) {
+        client.timing("many", i);
+    }
+
+    size_t nFew = 0, nMany = 0;
+    for (const std::string& line : SplitLines(client.takeDatagrams())) {
+        if (line.rfind("test.few:", 0) == 0) {
+            // all samples were kept
+            BOOST_CHECK(line.find("|ms") != std::string::npos);
+            BOOST_CHECK(line.find("|@") == std::string::npos);
+            nFew++;
+        } else {
+            // only the first samples are kept, the server is told about the rest by the sample rate
+            BOOST_CHECK(line.rfind("test.many:", 0) == 0);
+            BOOST_CHECK(line.find("|ms|@0.500000") != std::string::npos);
+            nMany++;
+        }
+    }
+    BOOST_CHECK_EQUAL(nFew, 10U);
+    BOOST_CHECK_EQUAL(nMany, STATSD_MAX_TIMING_SAMPLES);
+}
+
+BOOST_AUTO_TEST_CASE(statsd_datagram_size)
+{
+    statsd::StatsdClient client("127.0.0.1", DEFAULT_STATSD_PORT, "test.");
+    client.setAggregate(true);
+
+    for (int i = 0; i < 1000; i++) {
+        client.inc(strprintf("counter%d", i));
+    }
+    const std::vector<std::string> datagrams = client.takeDatagrams();
+    BOOST_CHECK(datagrams.size() > 1);
+    for (const std::string& datagram : datagrams) {
+        BOOST_CHECK(datagram.size() <= STATSD_MAX_DATAGRAM_SIZE);
+    }
+    BOOST_CHECK_EQUAL(SplitLines(datagrams).size(), 1000U);
+
+    // a line longer than a datagram is sent on its own, the lines around it are not held back
+    client.inc("before");
+    client.inc(std::string(STATSD_MAX_DATAGRAM_SIZE, 'x'));
+    client.inc("after");
+    const std::vector<std::string> long_datagrams = client.takeDatagrams();
+    BOOST_CHECK_EQUAL(SplitLines(long_datagrams).size(), 3U);
+    size_t nLong = 0;
+    for (const std::string& datagram : long_datagrams) {
+        if (datagram.size() > STATSD_MAX_DATAGRAM_SIZE) {
+            BOOST_CHECK_EQUAL(datagram, "test." + std::string(STATSD_MAX_DATAGRAM_SIZE, 'x') + ":1|c");
+            nLong++;
+        }
+    }
+    BOOST_CHECK_EQUAL(nLong, 1U);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
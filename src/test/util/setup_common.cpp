@@ -90,6 +90,7 @@ BasicTestingSetup::BasicTestingSetup(const std::string& chainName)
     SetupNetworking();
     InitSignatureCache();
     InitScriptExecutionCache();
+    InitBLSSignatureCache(DEFAULT_MAX_BLS_SIG_CACHE_SIZE << 20);
     fCheckBlockIndex = true;
     SelectParams(chainName);
     evoDb.reset(new CEvoDB(1 << 20, true, true));
@@ -149,6 +150,8 @@ TestingSetup::TestingSetup(const std::string& chainName) : BasicTestingSetup(cha
     // Start script-checking threads. Set g_parallel_script_checks to true so they are used.
     constexpr int script_check_threads = 2;
     StartScriptCheckWorkerThreads(script_check_threads);
+    StartHeaderCheckWorkerThreads(script_check_threads);
+    StartTxInputsCheckWorkerThreads(script_check_threads);
     g_parallel_script_checks = true;
 }
 
@@ -163,6 +166,8 @@ TestingSetup::~TestingSetup()
     threadGroup.interrupt_all();
     threadGroup.join_all();
     StopScriptCheckWorkerThreads();
+    StopHeaderCheckWorkerThreads();
+    StopTxInputsCheckWorkerThreads();
     GetMainSignals().FlushBackgroundCallbacks();
     GetMainSignals().UnregisterBackgroundSignalScheduler();
     g_connman.reset();
@@ -8,11 +8,13 @@
 #include <consensus/consensus.h>
 #include <consensus/merkle.h>
 #include <consensus/validation.h>
+#include <key.h>
 #include <miner.h>
 #include <pow.h>
 #include <random.h>
 #include <script/standard.h>
 #include <test/util/setup_common.h>
+#include <util/memory.h>
 #include <util/time.h>
 #include <validation.h>
 #include <validationinterface.h>
@@ -333,4 +335,76 @@ BOOST_AUTO_TEST_CASE(mempool_locks_reorg)
         rpc_thread.join();
     }
 }
+BOOST_AUTO_TEST_CASE(precheck_block_headers)
+{
+    std::deque<CBlockHeader> headers(3);
+    // legacy proof of work header, the block hash is the scrypt hash
+    headers[0].nVersion = 3;
+    headers[0].nBits = 0x207fffff;
+    // proof of work header
+    headers[1].nVersion = 0x20000000;
+    headers[1].nBits = 0x207fffff;
+    headers[1].hashPrevBlock = GetRandHash();
+    // proof of stake v2 header
+    CKey key;
+    key.MakeNewKey(true);
+    headers[2].nVersion = 0x20000000 | CBlockHeader::POSV2_BITS;
+    headers[2].nBits = 0x207fffff;
+    headers[2].posStakeHash = GetRandHash();
+    BOOST_CHECK(key.SignCompact(headers[2].GetHash(), headers[2].vchBlockSig));
+
+    std::deque<CBlockHeaderPrecheck> prechecks = PrecheckBlockHeaders(headers);
+    BOOST_CHECK_EQUAL(prechecks.size(), headers.size());
+    for (size_t i = 0; i < headers.size(); i++) {
+        BOOST_CHECK_EQUAL(prechecks[i].hash, headers[i].GetHash());
+    }
+    BOOST_CHECK_EQUAL(prechecks[0].hashPoW, headers[0].GetPoWHash());
+    BOOST_CHECK_EQUAL(prechecks[1].hashPoW, headers[1].GetPoWHash());
+    BOOST_CHECK(!prechecks[0].signer.IsValid());
+    BOOST_CHECK(prechecks[2].hashPoW.IsNull());
+    BOOST_CHECK(prechecks[2].signer == key.GetPubKey());
+
+    // only the given range is prechecked, hashes which are already known are kept
+    std::deque<CBlockHeaderPrecheck> partial(headers.size());
+    partial[1].hash = prechecks[1].hash;
+    PrecheckBlockHeaders(headers, partial, 1, 2);
+    BOOST_CHECK(partial[0].hash.IsNull());
+    BOOST_CHECK(partial[0].hashPoW.IsNull());
+    BOOST_CHECK_EQUAL(partial[1].hash, prechecks[1].hash);
+    BOOST_CHECK_EQUAL(partial[1].hashPoW, prechecks[1].hashPoW);
+    BOOST_CHECK(partial[2].hash.IsNull());
+    BOOST_CHECK(!partial[2].signer.IsValid());
+}
+
+BOOST_AUTO_TEST_CASE(precheck_block_signers)
+{
+    CKey key;
+    key.MakeNewKey(true);
+    CBlockHeader header;
+    header.nVersion = 0x20000000 | CBlockHeader::POSV2_BITS;
+    header.nBits = 0x207fffff;
+
+    std::vector<uint256> hashes;
+    std::vector<std::unique_ptr<CBlockIndex>> indexes;
+    for (int i = 0; i < 3; i++) {
+        header.posStakeHash = GetRandHash();
+        BOOST_CHECK(key.SignCompact(header.GetHash(), header.vchBlockSig));
+        hashes.push_back(header.GetHash());
+        indexes.push_back(MakeUnique<CBlockIndex>(header));
+    }
+    // the signature doesn't match the hash of the last block
+    hashes.back() = GetRandHash();
+
+    std::vector<CBlockIndex*> vpindex;
+    for (size_t i = 0; i < indexes.size(); i++) {
+        indexes[i]->phashBlock = &hashes[i];
+        vpindex.push_back(indexes[i].get());
+    }
+
+    WITH_LOCK(cs_main, PrecheckBlockSigners(vpindex));
+    BOOST_CHECK(indexes[0]->posSignerID == key.GetPubKey().GetID());
+    BOOST_CHECK(indexes[1]->posSignerID == key.GetPubKey().GetID());
+    BOOST_CHECK(indexes[2]->posSignerID.IsNull());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -2,7 +2,10 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include <chain.h>
+#include <consensus/validation.h>
 #include <net.h>
+#include <script/interpreter.h>
 #include <validation.h>
 
 #include <test/util/setup_common.h>
@@ -28,4 +31,65 @@ BOOST_AUTO_TEST_CASE(test_combiner_all)
     Test.disconnect(&ReturnTrue);
     BOOST_CHECK(Test());
 }
+
+static CTransactionRef MakeSpend(const COutPoint& prevout, CAmount nValue)
+{
+    CMutableTransaction mtx;
+    mtx.vin.emplace_back(prevout);
+    mtx.vout.emplace_back(nValue, CScript() << OP_TRUE);
+    return MakeTransactionRef(mtx);
+}
+
+BOOST_AUTO_TEST_CASE(precheck_block_inputs)
+{
+    CCoinsView viewDummy;
+    CCoinsViewCache view(&viewDummy);
+    const COutPoint prevout(InsecureRand256(), 0);
+    view.AddCoin(prevout, Coin(CTxOut(10 * COIN, CScript() << OP_TRUE), 1, false, false), false);
+
+    CMutableTransaction coinbase;
+    coinbase.vin.resize(1);
+    coinbase.vin[0].prevout.SetNull();
+    coinbase.vout.emplace_back(0, CScript() << OP_TRUE);
+
+    CBlock block;
+    block.vtx.push_back(MakeTransactionRef(coinbase));
+    block.vtx.push_back(MakeSpend(prevout, 9 * COIN));
+    // spends an output created earlier in the block
+    block.vtx.push_back(MakeSpend(COutPoint(block.vtx[1]->GetHash(), 0), 7 * COIN));
+    // double spend of an output spent earlier in the block
+    block.vtx.push_back(MakeSpend(prevout, 1 * COIN));
+    block.vtx.push_back(MakeSpend(COutPoint(block.vtx[2]->GetHash(), 0), 7 * COIN));
+    // spends an output created later in the block
+    const CTransactionRef txLater = MakeSpend(COutPoint(block.vtx[4]->GetHash(), 0), 6 * COIN);
+    block.vtx.push_back(MakeSpend(COutPoint(txLater->GetHash(), 0), 1 * COIN));
+    block.vtx.push_back(txLater);
+
+    CBlockIndex indexPrev;
+    indexPrev.nHeight = 100;
+    CBlockIndex index;
+    index.pprev = &indexPrev;
+    index.nHeight = 101;
+
+    for (bool fParallel : {false, true}) {
+        const auto prechecks = PrecheckBlockInputs(block, view, index, SCRIPT_VERIFY_P2SH, 0, fParallel);
+        BOOST_REQUIRE_EQUAL(prechecks.size(), block.vtx.size());
+        BOOST_CHECK(prechecks[0].fInputsValid);
+        BOOST_CHECK(prechecks[1].fInputsValid);
+        BOOST_CHECK_EQUAL(prechecks[1].nFee, 1 * COIN);
+        BOOST_CHECK(prechecks[2].fInputsValid);
+        BOOST_CHECK_EQUAL(prechecks[2].nFee, 2 * COIN);
+        BOOST_CHECK(!prechecks[3].fInputsValid);
+        BOOST_CHECK_EQUAL(prechecks[3].state.GetRejectReason(), "bad-txns-inputs-missingorspent");
+        BOOST_CHECK(prechecks[4].fInputsValid);
+        BOOST_CHECK(!prechecks[5].fInputsValid);
+        BOOST_CHECK(prechecks[6].fInputsValid);
+        BOOST_CHECK_EQUAL(prechecks[6].nSigOps, 0U);
+    }
+
+    // the view itself is left untouched
+    BOOST_CHECK(view.HaveCoin(prevout));
+    BOOST_CHECK(!view.HaveCoin(COutPoint(block.vtx[1]->GetHash(), 0)));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
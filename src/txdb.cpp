@@ -32,6 +32,7 @@ static const char DB_HEAD_BLOCKS = 'H';
 static const char DB_FLAG = 'F';
 static const char DB_REINDEX_FLAG = 'R';
 static const char DB_LAST_BLOCK = 'l';
+static const char DB_UTXO_STATS = 'S';
 
 namespace {
 
@@ -126,6 +127,12 @@ bool CCoinsViewDB::BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock) {
     // In the last batch, mark the database as consistent with hashBlock again.
     batch.Erase(DB_HEAD_BLOCKS);
     batch.Write(DB_BEST_BLOCK, hashBlock);
+    if (m_pending_stats && m_pending_stats->hashBlock == hashBlock) {
+        batch.Write(DB_UTXO_STATS, *m_pending_stats);
+    } else {
+        batch.Erase(DB_UTXO_STATS);
+    }
+    m_pending_stats = nullopt;
 
     LogPrint(BCLog::COINDB, "Writing final batch of %.2f MiB\n", batch.SizeEstimate() * (1.0 / 1048576.0));
     bool ret = db.WriteBatch(batch);
@@ -133,6 +140,11 @@ bool CCoinsViewDB::BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock) {
     return ret;
 }
 
+bool CCoinsViewDB::ReadUTXOStats(CUTXOStats& stats) const
+{
+    return db.Read(DB_UTXO_STATS, stats) && stats.hashBlock == GetBestBlock();
+}
+
 size_t CCoinsViewDB::EstimateSize() const
 {
     return db.EstimateSize(DB_COIN, (char)(DB_COIN+1));
@@ -166,16 +178,40 @@ CCoinsViewCursor *CCoinsViewDB::Cursor() const
     /* It seems that there are no "const iterators" for LevelDB.  Since we
        only need read operations on it, use a const-cast to get around
        that restriction.  */
-    i->pcursor->Seek(DB_COIN);
-    // Cache key of first record
-    if (i->pcursor->Valid()) {
-        CoinEntry entry(&i->keyTmp.second);
-        i->pcursor->GetKey(entry);
-        i->keyTmp.first = entry.key;
+    i->Seek(0);
+    return i;
+}
+
+std::vector<std::unique_ptr<CCoinsViewCursor>> CCoinsViewDB::SnapshotCursors(unsigned int count) const
+{
+    assert(count > 0 && count <= 0x100);
+    const auto snapshot = db.GetSnapshot();
+    const uint256 hashBestBlock = GetBestBlock();
+    std::vector<std::unique_ptr<CCoinsViewCursor>> cursors;
+    for (unsigned int n = 0; n < count; n++) {
+        CCoinsViewDBCursor *i = new CCoinsViewDBCursor(db.NewIterator(snapshot), hashBestBlock, (n + 1) * 0x100 / count);
+        i->Seek(n * 0x100 / count);
+        cursors.emplace_back(i);
+    }
+    return cursors;
+}
+
+void CCoinsViewDBCursor::Seek(unsigned int nBeginByte)
+{
+    uint256 begin;
+    *begin.begin() = nBeginByte;
+    pcursor->Seek(std::make_pair(DB_COIN, begin));
+    CacheKey();
+}
+
+void CCoinsViewDBCursor::CacheKey()
+{
+    CoinEntry entry(&keyTmp.second);
+    if (!pcursor->Valid() || !pcursor->GetKey(entry) || *keyTmp.second.hash.begin() >= nEndByte) {
+        keyTmp.first = 0; // Invalidate cached key after last record so that Valid() and GetKey() return false
     } else {
-        i->keyTmp.first = 0; // Make sure Valid() and GetKey() return false
+        keyTmp.first = entry.key;
     }
-    return i;
 }
 
 bool CCoinsViewDBCursor::GetKey(COutPoint &key) const
@@ -206,12 +242,7 @@ bool CCoinsViewDBCursor::Valid() const
 void CCoinsViewDBCursor::Next()
 {
     pcursor->Next();
-    CoinEntry entry(&keyTmp.second);
-    if (!pcursor->Valid() || !pcursor->GetKey(entry)) {
-        keyTmp.first = 0; // Invalidate cached key after last record so that Valid() and GetKey() return false
-    } else {
-        keyTmp.first = entry.key;
-    }
+    CacheKey();
 }
 
 bool CBlockTreeDB::WriteBatchSync(const std::vector<std::pair<int, const CBlockFileInfo*> >& fileInfo, int nLastFile, const std::vector<const CBlockIndex*>& blockinfo) {
@@ -9,6 +9,8 @@
 #include <coins.h>
 #include <dbwrapper.h>
 #include <chain.h>
+#include <node/coinstats.h>
+#include <optional.h>
 #include <primitives/block.h>
 #include <spentindex.h>
 
@@ -45,6 +47,8 @@ class CCoinsViewDB final : public CCoinsView
 {
 protected:
     CDBWrapper db;
+    //! UTXO set statistics to store together with the next BatchWrite
+    Optional<CUTXOStats> m_pending_stats;
 public:
     /**
      * @param[in] ldb_path    Location in the filesystem where leveldb data will be stored.
@@ -59,9 +63,23 @@ public:
     bool BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock) override;
     CCoinsViewCursor *Cursor() const override;
 
+    /**
+     * Split the coin database into count cursors over disjoint txid ranges,
+     * which together visit every coin exactly once. They all read from the same
+     * snapshot, so they can be used from different threads while the database
+     * is being written to. Must be called while no BatchWrite() is in progress.
+     */
+    std::vector<std::unique_ptr<CCoinsViewCursor>> SnapshotCursors(unsigned int count) const;
+
     //! Attempt to update from an older database format. Returns whether an error occurred.
     bool Upgrade();
     size_t EstimateSize() const override;
+
+    //! Queue statistics to be written atomically with the next flush. They are
+    //! only stored if they are valid for the block the flush moves the database to.
+    void SetUTXOStats(const CUTXOStats& stats) { m_pending_stats = stats; }
+    //! Read the statistics stored with the current best block, if any.
+    bool ReadUTXOStats(CUTXOStats& stats) const;
 };
 
 /** Specialization of CCoinsViewCursor to iterate over a CCoinsViewDB */
@@ -78,10 +96,15 @@ public:
     void Next() override;
 
 private:
-    CCoinsViewDBCursor(CDBIterator* pcursorIn, const uint256 &hashBlockIn):
-        CCoinsViewCursor(hashBlockIn), pcursor(pcursorIn) {}
+    CCoinsViewDBCursor(CDBIterator* pcursorIn, const uint256 &hashBlockIn, unsigned int nEndByteIn = 0x100):
+        CCoinsViewCursor(hashBlockIn), pcursor(pcursorIn), nEndByte(nEndByteIn) {}
+    void Seek(unsigned int nBeginByte);
+    void CacheKey();
+
     std::unique_ptr<CDBIterator> pcursor;
     std::pair<char, COutPoint> keyTmp;
+    //! The cursor stops at the first txid whose first byte is not below this
+    unsigned int nEndByte;
 
     friend class CCoinsViewDB;
 };
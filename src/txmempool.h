@@ -347,6 +347,15 @@ struct TxMempoolInfo
 
     /** The fee delta. */
     int64_t nFeeDelta;
+
+    /** Fee of the transaction (without any delta). */
+    CAmount nFee;
+
+    /** Serialized size of the transaction. */
+    size_t nTxSize;
+
+    /** Sigop count of the transaction as computed when it entered the mempool. */
+    unsigned int nSigOpCount;
 };
 
 /** Reason why a transaction was removed from the mempool,
@@ -32,6 +32,8 @@ int64_t GetTimeMillis();
 int64_t GetTimeMicros();
 /** Returns the system time (not mockable) */
 int64_t GetSystemTimeInSeconds(); // Like GetTime(), but not mockable
+/** Returns the CPU time consumed by the calling thread, or 0 if the platform can't tell */
+int64_t GetThreadCPUTimeMicros();
 
 /** For testing. Set e.g. with the setmocktime rpc, or -mocktime argument */
 void SetMockTime(int64_t nMockTimeIn);
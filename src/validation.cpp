@@ -23,6 +23,8 @@
 #include <index/txindex.h>
 #include <logging.h>
 #include <logging/timer.h>
+#include <node/blockcache.h>
+#include <node/coinstats.h>
 #include <policy/fees.h>
 #include <policy/policy.h>
 #include <policy/settings.h>
@@ -30,6 +32,7 @@
 #include <primitives/block.h>
 #include <primitives/transaction.h>
 #include <reverse_iterator.h>
+#include <saltedhasher.h>
 #include <script/script.h>
 #include <script/sigcache.h>
 #include <script/standard.h>
@@ -61,9 +64,13 @@
 
 #include <statsd_client.h>
 
+#include <deque>
 #include <future>
+#include <set>
 #include <sstream>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <boost/algorithm/string/replace.hpp>
 
@@ -1005,19 +1012,38 @@ bool ReadBlockFromDisk(CBlock& block, const FlatFilePos& pos, const Consensus::P
     return true;
 }
 
-bool ReadBlockFromDisk(CBlock& block, const CBlockIndex* pindex, const Consensus::Params& consensusParams)
+std::shared_ptr<const CBlock> ReadSharedBlockFromDisk(const CBlockIndex* pindex, const Consensus::Params& consensusParams)
 {
+    const uint256 hash = pindex->GetBlockHash();
+    if (auto cached = g_block_cache.GetBlock(hash)) {
+        return cached;
+    }
+
     FlatFilePos blockPos;
     {
         LOCK(cs_main);
         blockPos = pindex->GetBlockPos();
     }
 
-    if (!ReadBlockFromDisk(block, blockPos, consensusParams))
-        return false;
-    if (block.GetHash() != pindex->GetBlockHash())
-        return error("ReadBlockFromDisk(CBlock&, CBlockIndex*): GetHash() doesn't match index for %s at %s",
+    auto pblock = std::make_shared<CBlock>();
+    if (!ReadBlockFromDisk(*pblock, blockPos, consensusParams))
+        return nullptr;
+    if (pblock->GetHash() != hash) {
+        error("ReadBlockFromDisk(CBlock&, CBlockIndex*): GetHash() doesn't match index for %s at %s",
                 pindex->ToString(), pindex->GetBlockPos().ToString());
+        return nullptr;
+    }
+    g_block_cache.AddBlock(hash, pblock);
+    return pblock;
+}
+
+bool ReadBlockFromDisk(CBlock& block, const CBlockIndex* pindex, const Consensus::Params& consensusParams)
+{
+    auto pblock = ReadSharedBlockFromDisk(pindex, consensusParams);
+    if (!pblock)
+        return false;
+    // transactions are shared, so this only copies the header and the tx references
+    block = *pblock;
     return true;
 }
 
@@ -1328,8 +1354,11 @@ void UpdateCoins(const CTransaction& tx, CCoinsViewCache& inputs, int nHeight)
 
 bool CScriptCheck::operator()() {
     const CScript &scriptSig = ptxTo->vin[nIn].scriptSig;
-    PrecomputedTransactionData txdata(*ptxTo);
-    return VerifyScript(scriptSig, m_tx_out.scriptPubKey, nFlags, CachingTransactionSignatureChecker(ptxTo, nIn, m_tx_out.nValue, txdata, cacheStore), &error);
+    if (txdata != nullptr && txdata->m_ready) {
+        return VerifyScript(scriptSig, m_tx_out.scriptPubKey, nFlags, CachingTransactionSignatureChecker(ptxTo, nIn, m_tx_out.nValue, *txdata, cacheStore), &error);
+    }
+    PrecomputedTransactionData txdataLocal(*ptxTo);
+    return VerifyScript(scriptSig, m_tx_out.scriptPubKey, nFlags, CachingTransactionSignatureChecker(ptxTo, nIn, m_tx_out.nValue, txdataLocal, cacheStore), &error);
 }
 
 int GetSpendHeight(const CCoinsViewCache& inputs)
@@ -1343,6 +1372,14 @@ int GetSpendHeight(const CCoinsViewCache& inputs)
 static CuckooCache::cache<uint256, SignatureCacheHasher> g_scriptExecutionCache;
 static CSHA256 g_scriptExecutionCacheHasher;
 
+static uint256 GetScriptExecutionCacheEntry(const CTransaction& tx, unsigned int flags)
+{
+    uint256 hashCacheEntry;
+    CSHA256 hasher = g_scriptExecutionCacheHasher;
+    hasher.Write(tx.GetHash().begin(), 32).Write((unsigned char*)&flags, sizeof(flags)).Finalize(hashCacheEntry.begin());
+    return hashCacheEntry;
+}
+
 void InitScriptExecutionCache() {
     // Setup the salted hasher
     uint256 nonce = GetRandHash();
@@ -1396,9 +1433,7 @@ bool CheckInputs(const CTransaction& tx, CValidationState &state, const CCoinsVi
             // correct (ie that the transaction hash which is in tx's prevouts
             // properly commits to the scriptPubKey in the inputs view of that
             // transaction).
-            uint256 hashCacheEntry;
-            CSHA256 hasher = g_scriptExecutionCacheHasher;
-            hasher.Write(tx.GetHash().begin(), 32).Write((unsigned char*)&flags, sizeof(flags)).Finalize(hashCacheEntry.begin());
+            const uint256 hashCacheEntry = GetScriptExecutionCacheEntry(tx, flags);
             AssertLockHeld(cs_main); //TODO: Remove this requirement by making CuckooCache not require external locks
             if (g_scriptExecutionCache.contains(hashCacheEntry, !cacheFullScriptStore)) {
                 return true;
@@ -1495,6 +1530,12 @@ static bool UndoWriteToDisk(const CBlockUndo& blockundo, FlatFilePos& pos, const
 
 bool UndoReadFromDisk(CBlockUndo& blockundo, const CBlockIndex* pindex)
 {
+    const uint256 hash = pindex->GetBlockHash();
+    if (auto cached = g_block_cache.GetUndo(hash)) {
+        blockundo = *cached;
+        return true;
+    }
+
     FlatFilePos pos = pindex->GetUndoPos();
     if (pos.IsNull()) {
         return error("%s: no undo data available", __func__);
@@ -1581,7 +1622,7 @@ int ApplyTxInUndo(Coin&& undo, CCoinsViewCache& view, const COutPoint& out)
 
 /** Undo the effects of this block (with given index) on the UTXO set represented by coins.
  *  When FAILED is returned, view is left in an indeterminate state. */
-DisconnectResult CChainState::DisconnectBlock(const CBlock& block, const CBlockIndex* pindex, CCoinsViewCache& view)
+DisconnectResult CChainState::DisconnectBlock(const CBlock& block, const CBlockIndex* pindex, CCoinsViewCache& view, CUTXOStats* utxo_stats)
 {
     AssertLockHeld(cs_main);
 
@@ -1611,6 +1652,12 @@ DisconnectResult CChainState::DisconnectBlock(const CBlock& block, const CBlockI
     std::vector<std::pair<CAddressUnspentKey, CAddressUnspentValue> > addressUnspentIndex;
     std::vector<std::pair<CSpentIndexKey, CSpentIndexValue> > spentIndex;
 
+    // Work on a copy of the statistics so they are left untouched unless the block is cleanly disconnected
+    Optional<CUTXOStats> stats;
+    if (utxo_stats && utxo_stats->hashBlock == pindex->GetBlockHash()) {
+        stats = *utxo_stats;
+    }
+
     if (!UndoSpecialTxsInBlock(block, pindex)) {
         return DISCONNECT_FAILED;
     }
@@ -1667,6 +1714,9 @@ DisconnectResult CChainState::DisconnectBlock(const CBlock& block, const CBlockI
                 if (!is_spent || tx.vout[o] != coin.out || pindex->nHeight != coin.nHeight || is_coinbase != coin.fCoinBase || is_coinstake != coin.fCoinStake) {
                     fClean = false; // transaction output mismatch
                 }
+                if (is_spent && stats) {
+                    stats->RemoveCoin(out, coin);
+                }
             }
         }
 
@@ -1683,6 +1733,9 @@ DisconnectResult CChainState::DisconnectBlock(const CBlock& block, const CBlockI
                 int res = ApplyTxInUndo(std::move(txundo.vprevout[j]), view, out);
                 if (res == DISCONNECT_FAILED) return DISCONNECT_FAILED;
                 fClean = fClean && res != DISCONNECT_UNCLEAN;
+                if (stats) {
+                    stats->AddCoin(out, view.AccessCoin(out));
+                }
 
                 const CTxIn input = tx.vin[j];
 
@@ -1750,6 +1803,11 @@ DisconnectResult CChainState::DisconnectBlock(const CBlock& block, const CBlockI
     view.SetBestBlock(pindex->pprev->GetBlockHash());
     evoDb->WriteBestBlock(pindex->pprev->GetBlockHash());
 
+    if (stats && fClean) {
+        stats->hashBlock = pindex->pprev->GetBlockHash();
+        *utxo_stats = std::move(*stats);
+    }
+
     boost::posix_time::ptime finish = boost::posix_time::microsec_clock::local_time();
     boost::posix_time::time_duration diff = finish - start;
     statsClient.timing("DisconnectBlock_ms", diff.total_milliseconds(), 1.0f);
@@ -1818,6 +1876,203 @@ void StopScriptCheckWorkerThreads()
     scriptcheckqueue.StopWorkerThreads();
 }
 
+bool RunScriptChecks(std::vector<CScriptCheck>& vChecks)
+{
+    // Must not be called with cs_main held, see LoadMempool
+    CCheckQueueControl<CScriptCheck> control(&scriptcheckqueue);
+    control.Add(vChecks);
+    return control.Wait();
+}
+
+/** Extract the address type and hash indexed for a script, 0 if it isn't indexed */
+static int GetAddressIndexHash(const CScript& script, uint160& hashBytes)
+{
+    if (script.IsPayToScriptHash()) {
+        hashBytes = uint160(std::vector<unsigned char>(script.begin()+2, script.begin()+22));
+        return 2;
+    } else if (script.IsPayToPublicKeyHash()) {
+        hashBytes = uint160(std::vector<unsigned char>(script.begin()+3, script.begin()+23));
+        return 1;
+    } else if (script.IsPayToPublicKey()) {
+        hashBytes = Hash160(script.begin()+1, script.end()-1);
+        return 1;
+    }
+    hashBytes.SetNull();
+    return 0;
+}
+
+namespace {
+/** Block wide parameters shared by all CTxInputsCheck of a block */
+struct CBlockInputsContext
+{
+    const CBlockIndex* pindex;
+    unsigned int flags;
+    int nLockTimeFlags;
+};
+
+/** Input checks and index extraction of one transaction of a block, see PrecheckBlockInputs */
+class CTxInputsCheck
+{
+private:
+    const CBlockInputsContext* pctx{nullptr};
+    const CTransaction* ptx{nullptr};
+    unsigned int nTx{0};
+    const std::vector<const Coin*>* pcoins{nullptr};
+    CTxInputsPrecheck* pprecheck{nullptr};
+
+public:
+    CTxInputsCheck() = default;
+    CTxInputsCheck(const CBlockInputsContext& ctx, const CTransaction& tx, unsigned int nTxIn, const std::vector<const Coin*>& coins, CTxInputsPrecheck& precheck) :
+        pctx(&ctx), ptx(&tx), nTx(nTxIn), pcoins(&coins), pprecheck(&precheck) {}
+
+    bool operator()()
+    {
+        const CTransaction& tx = *ptx;
+        const std::vector<const Coin*>& coins = *pcoins;
+        const CBlockIndex& index = *pctx->pindex;
+        CTxInputsPrecheck& precheck = *pprecheck;
+        const uint256& txhash = tx.GetHash();
+
+        if (!tx.IsCoinBase()) {
+            precheck.fInputsValid = Consensus::CheckTxInputs(tx, precheck.state, coins, index.nHeight, precheck.nFee);
+            // The remaining checks need all inputs, failures are reported by ConnectBlock in block order
+            if (!precheck.fInputsValid) {
+                return true;
+            }
+
+            std::vector<int> prevheights(tx.vin.size());
+            for (size_t j = 0; j < tx.vin.size(); j++) {
+                prevheights[j] = coins[j]->nHeight;
+            }
+            precheck.fSequenceLocksValid = SequenceLocks(tx, pctx->nLockTimeFlags, &prevheights, index);
+
+            if (fAddressIndex || fSpentIndex) {
+                for (size_t j = 0; j < tx.vin.size(); j++) {
+                    const CTxIn& input = tx.vin[j];
+                    const CTxOut& prevout = coins[j]->out;
+                    uint160 hashBytes;
+                    int addressType = GetAddressIndexHash(prevout.scriptPubKey, hashBytes);
+
+                    if (fAddressIndex && addressType > 0) {
+                        // record spending activity
+                        precheck.addressIndex.push_back(std::make_pair(CAddressIndexKey(addressType, hashBytes, index.nHeight, nTx, txhash, j, true), prevout.nValue * -1));
+
+                        // remove address from unspent index
+                        precheck.addressUnspentIndex.push_back(std::make_pair(CAddressUnspentKey(addressType, hashBytes, input.prevout.hash, input.prevout.n), CAddressUnspentValue()));
+                    }
+
+                    if (fSpentIndex) {
+                        // add the spent index to determine the txid and input that spent an output
+                        // and to find the amount and address from an input
+                        precheck.spentIndex.push_back(std::make_pair(CSpentIndexKey(input.prevout.hash, input.prevout.n), CSpentIndexValue(txhash, j, index.nHeight, prevout.nValue, addressType, hashBytes)));
+                    }
+                }
+            }
+        }
+
+        // GetTransactionSigOpCount counts 2 types of sigops:
+        // * legacy (always)
+        // * p2sh (when P2SH enabled in flags and excludes coinbase)
+        precheck.nSigOps = GetTransactionSigOpCount(tx, coins, pctx->flags);
+
+        if (fAddressIndex) {
+            for (unsigned int k = 0; k < tx.vout.size(); k++) {
+                const CTxOut& out = tx.vout[k];
+                uint160 hashBytes;
+                int addressType = GetAddressIndexHash(out.scriptPubKey, hashBytes);
+                if (addressType == 0) {
+                    continue;
+                }
+
+                // record receiving activity
+                precheck.addressIndex.push_back(std::make_pair(CAddressIndexKey(addressType, hashBytes, index.nHeight, nTx, txhash, k, false), out.nValue));
+
+                // record unspent output
+                precheck.addressUnspentIndex.push_back(std::make_pair(CAddressUnspentKey(addressType, hashBytes, txhash, k), CAddressUnspentValue(out.nValue, out.scriptPubKey, index.nHeight)));
+            }
+        }
+        return true;
+    }
+
+    void swap(CTxInputsCheck& check)
+    {
+        std::swap(pctx, check.pctx);
+        std::swap(ptx, check.ptx);
+        std::swap(nTx, check.nTx);
+        std::swap(pcoins, check.pcoins);
+        std::swap(pprecheck, check.pprecheck);
+    }
+};
+} // namespace
+
+static CCheckQueue<CTxInputsCheck> txinputscheckqueue(32);
+
+void StartTxInputsCheckWorkerThreads(int threads_num)
+{
+    txinputscheckqueue.StartWorkerThreads(threads_num, "txinputs");
+}
+
+void StopTxInputsCheckWorkerThreads()
+{
+    txinputscheckqueue.StopWorkerThreads();
+}
+
+std::vector<CTxInputsPrecheck> PrecheckBlockInputs(const CBlock& block, const CCoinsViewCache& view, const CBlockIndex& index, unsigned int flags, int nLockTimeFlags, bool fParallel)
+{
+    // Resolve the spent coins serially, the view caches what it fetches and isn't thread safe.
+    // Outputs of earlier transactions of the block are not in the view yet, and outputs spent
+    // by earlier transactions still are, so both are tracked here to match the view state
+    // each transaction would see when the block is applied in order.
+    std::unordered_map<uint256, unsigned int, StaticSaltedHasher> mapBlockTxs;
+    std::unordered_set<COutPoint, SaltedOutpointHasher> setSpent;
+    std::deque<Coin> blockCoins;
+    std::vector<std::vector<const Coin*> > vCoins(block.vtx.size());
+    for (unsigned int i = 0; i < block.vtx.size(); i++) {
+        const CTransaction& tx = *block.vtx[i];
+        if (!tx.IsCoinBase()) {
+            vCoins[i].reserve(tx.vin.size());
+            for (const CTxIn& txin : tx.vin) {
+                const Coin* coin = nullptr;
+                auto it = mapBlockTxs.find(txin.prevout.hash);
+                if (!setSpent.emplace(txin.prevout).second) {
+                    // spent by an earlier transaction of the block
+                } else if (it != mapBlockTxs.end()) {
+                    const CTransaction& txPrev = *block.vtx[it->second];
+                    if (txin.prevout.n < txPrev.vout.size() && !txPrev.vout[txin.prevout.n].scriptPubKey.IsUnspendable()) {
+                        blockCoins.emplace_back(txPrev.vout[txin.prevout.n], index.nHeight, txPrev.IsCoinBase(), txPrev.IsCoinStake());
+                        coin = &blockCoins.back();
+                    }
+                } else {
+                    const Coin& viewCoin = view.AccessCoin(txin.prevout);
+                    if (!viewCoin.IsSpent()) {
+                        coin = &viewCoin;
+                    }
+                }
+                vCoins[i].emplace_back(coin);
+            }
+        }
+        mapBlockTxs.emplace(tx.GetHash(), i);
+    }
+
+    const CBlockInputsContext ctx{&index, flags, nLockTimeFlags};
+    std::vector<CTxInputsPrecheck> prechecks(block.vtx.size());
+    std::vector<CTxInputsCheck> vChecks;
+    vChecks.reserve(block.vtx.size());
+    for (unsigned int i = 0; i < block.vtx.size(); i++) {
+        vChecks.emplace_back(ctx, *block.vtx[i], i, vCoins[i], prechecks[i]);
+    }
+    if (fParallel) {
+        CCheckQueueControl<CTxInputsCheck> control(&txinputscheckqueue);
+        control.Add(vChecks);
+        control.Wait();
+    } else {
+        for (auto& check : vChecks) {
+            check();
+        }
+    }
+    return prechecks;
+}
+
 VersionBitsCache versionbitscache GUARDED_BY(cs_main);
 
 int32_t ComputeBlockVersion(const CBlockIndex* pindexPrev, const Consensus::Params& params, bool fCheckMasternodesUpgraded, bool isPos)
@@ -1939,6 +2194,7 @@ static int64_t nTimeSubsidy = 0;
 static int64_t nTimeValueValid = 0;
 static int64_t nTimePayeeValid = 0;
 static int64_t nTimeProcessSpecial = 0;
+static int64_t nTimePrecheckInputs = 0;
 static int64_t nTimePirateCashSpecific = 0;
 static int64_t nTimeConnect = 0;
 static int64_t nTimeIndex = 0;
@@ -1950,7 +2206,7 @@ static int64_t nBlocksTotal = 0;
  *  Validity checks that depend on the UTXO set are also done; ConnectBlock()
  *  can fail if those validity checks fail (among other reasons). */
 bool CChainState::ConnectBlock(const CBlock& block, CValidationState& state, CBlockIndex* pindex,
-                  CCoinsViewCache& view, const CChainParams& chainparams, bool fJustCheck)
+                  CCoinsViewCache& view, const CChainParams& chainparams, bool fJustCheck, CUTXOStats* utxo_stats)
 {
     boost::posix_time::ptime start = boost::posix_time::microsec_clock::local_time();
 
@@ -1972,7 +2228,13 @@ bool CChainState::ConnectBlock(const CBlock& block, CValidationState& state, CBl
     // is enforced in ContextualCheckBlockHeader(); we wouldn't want to
     // re-enforce that rule here (at least until we make it impossible for
     // GetAdjustedTime() to go backward).
-    if (!CheckBlock(block, state, chainparams.GetConsensus(), !fJustCheck, !fJustCheck)) {
+    // PirateCash: the signer recovered from the indexed header is only valid for the same signature
+    const CBlockHeader& header = block;
+    const CKeyID* signer = nullptr;
+    if (!pindex->posSignerID.IsNull() && header.vchBlockSig == pindex->vchBlockSig) {
+        signer = &pindex->posSignerID;
+    }
+    if (!CheckBlock(block, state, chainparams.GetConsensus(), !fJustCheck, !fJustCheck, signer)) {
         if (state.CorruptionPossible()) {
             // We don't write down blocks to disk if they may have been
             // corrupted, so this should be impossible unless we're having hardware
@@ -2003,8 +2265,12 @@ bool CChainState::ConnectBlock(const CBlock& block, CValidationState& state, CBl
     // Special case for the genesis block, skipping connection of its transactions
     // (its coinbase is unspendable)
     if (block.GetHash() == chainparams.GetConsensus().hashGenesisBlock) {
-        if (!fJustCheck)
+        if (!fJustCheck) {
             view.SetBestBlock(pindex->GetBlockHash());
+            if (utxo_stats && utxo_stats->hashBlock == hashPrevBlock) {
+                utxo_stats->hashBlock = pindex->GetBlockHash();
+            }
+        }
         return true;
     }
 
@@ -2130,7 +2396,6 @@ bool CChainState::ConnectBlock(const CBlock& block, CValidationState& state, CBl
     CCheckQueueControl<CScriptCheck> control(fScriptChecks && g_parallel_script_checks ? &scriptcheckqueue : nullptr);
     std::vector<PrecomputedTransactionData> txsdata(block.vtx.size());
 
-    std::vector<int> prevheights;
     CAmount nFees = 0;
     int nInputs = 0;
     unsigned int nSigOps = 0;
@@ -2150,20 +2415,27 @@ bool CChainState::ConnectBlock(const CBlock& block, CValidationState& state, CBl
     int64_t nTime2_1 = GetTimeMicros(); nTimeProcessSpecial += nTime2_1 - nTime2;
     LogPrint(BCLog::BENCHMARK, "      - ProcessSpecialTxsInBlock: %.2fms [%.2fs (%.2fms/blk)]\n", MILLI * (nTime2_1 - nTime2), nTimeProcessSpecial * MICRO, nTimeProcessSpecial * MILLI / nBlocksTotal);
 
+    // Phase 1: check the inputs of all transactions against the view before it is modified
+    const std::vector<CTxInputsPrecheck> prechecks = PrecheckBlockInputs(block, view, *pindex, flags, nLockTimeFlags, g_parallel_script_checks);
+
+    int64_t nTime2_2 = GetTimeMicros(); nTimePrecheckInputs += nTime2_2 - nTime2_1;
+    LogPrint(BCLog::BENCHMARK, "      - Precheck inputs: %.2fms [%.2fs (%.2fms/blk)]\n", MILLI * (nTime2_2 - nTime2_1), nTimePrecheckInputs * MICRO, nTimePrecheckInputs * MILLI / nBlocksTotal);
+
+    // Phase 2: report the results and apply the coin updates in block order
     for (unsigned int i = 0; i < block.vtx.size(); i++)
     {
         const CTransaction &tx = *(block.vtx[i]);
-        const uint256 txhash = tx.GetHash();
+        const CTxInputsPrecheck& precheck = prechecks[i];
 
         nInputs += tx.vin.size();
 
         if (!tx.IsCoinBase())
         {
-            CAmount txfee = 0;
-            if (!Consensus::CheckTxInputs(tx, state, view, pindex->nHeight, txfee)) {
+            if (!precheck.fInputsValid) {
+                state = precheck.state;
                 return error("%s: Consensus::CheckTxInputs: %s, %s", __func__, tx.GetHash().ToString(), FormatStateMessage(state));
             }
-            nFees += txfee;
+            nFees += precheck.nFee;
             if (!MoneyRange(nFees)) {
                 return state.DoS(100, error("%s: accumulated fee in the block out of range.", __func__),
                                  REJECT_INVALID, "bad-txns-accumulated-fee-outofrange");
@@ -2172,62 +2444,13 @@ bool CChainState::ConnectBlock(const CBlock& block, CValidationState& state, CBl
             // Check that transaction is BIP68 final
             // BIP68 lock checks (as opposed to nLockTime checks) must
             // be in ConnectBlock because they require the UTXO set
-            prevheights.resize(tx.vin.size());
-            for (size_t j = 0; j < tx.vin.size(); j++) {
-                prevheights[j] = view.AccessCoin(tx.vin[j].prevout).nHeight;
-            }
-
-            if (!SequenceLocks(tx, nLockTimeFlags, &prevheights, *pindex)) {
+            if (!precheck.fSequenceLocksValid) {
                 return state.DoS(100, error("%s: contains a non-BIP68-final transaction", __func__),
                                  REJECT_INVALID, "bad-txns-nonfinal");
             }
-
-            if (fAddressIndex || fSpentIndex)
-            {
-                for (size_t j = 0; j < tx.vin.size(); j++) {
-                    const CTxIn input = tx.vin[j];
-                    const Coin& coin = view.AccessCoin(tx.vin[j].prevout);
-                    const CTxOut &prevout = coin.out;
-                    uint160 hashBytes;
-                    int addressType;
-
-                    if (prevout.scriptPubKey.IsPayToScriptHash()) {
-                        hashBytes = uint160(std::vector<unsigned char>(prevout.scriptPubKey.begin()+2, prevout.scriptPubKey.begin()+22));
-                        addressType = 2;
-                    } else if (prevout.scriptPubKey.IsPayToPublicKeyHash()) {
-                        hashBytes = uint160(std::vector<unsigned char>(prevout.scriptPubKey.begin()+3, prevout.scriptPubKey.begin()+23));
-                        addressType = 1;
-                    } else if (prevout.scriptPubKey.IsPayToPublicKey()) {
-                        hashBytes = Hash160(prevout.scriptPubKey.begin()+1, prevout.scriptPubKey.end()-1);
-                        addressType = 1;
-                    } else {
-                        hashBytes.SetNull();
-                        addressType = 0;
-                    }
-
-                    if (fAddressIndex && addressType > 0) {
-                        // record spending activity
-                        addressIndex.push_back(std::make_pair(CAddressIndexKey(addressType, hashBytes, pindex->nHeight, i, txhash, j, true), prevout.nValue * -1));
-
-                        // remove address from unspent index
-                        addressUnspentIndex.push_back(std::make_pair(CAddressUnspentKey(addressType, hashBytes, input.prevout.hash, input.prevout.n), CAddressUnspentValue()));
-                    }
-
-                    if (fSpentIndex) {
-                        // add the spent index to determine the txid and input that spent an output
-                        // and to find the amount and address from an input
-                        spentIndex.push_back(std::make_pair(CSpentIndexKey(input.prevout.hash, input.prevout.n), CSpentIndexValue(txhash, j, pindex->nHeight, prevout.nValue, addressType, hashBytes)));
-                    }
-                }
-
-            }
-
         }
 
-        // GetTransactionSigOpCount counts 2 types of sigops:
-        // * legacy (always)
-        // * p2sh (when P2SH enabled in flags and excludes coinbase)
-        nSigOps += GetTransactionSigOpCount(tx, view, flags);
+        nSigOps += precheck.nSigOps;
         if (nSigOps > MaxBlockSigOps(fDIP0001Active_context))
             return state.DoS(100, error("ConnectBlock(): too many sigops"),
                              REJECT_INVALID, "bad-blk-sigops");
@@ -2247,38 +2470,9 @@ bool CChainState::ConnectBlock(const CBlock& block, CValidationState& state, CBl
             }
         }
 
-        if (fAddressIndex) {
-            for (unsigned int k = 0; k < tx.vout.size(); k++) {
-                const CTxOut &out = tx.vout[k];
-
-                if (out.scriptPubKey.IsPayToScriptHash()) {
-                    std::vector<unsigned char> hashBytes(out.scriptPubKey.begin()+2, out.scriptPubKey.begin()+22);
-
-                    // record receiving activity
-                    addressIndex.push_back(std::make_pair(CAddressIndexKey(2, uint160(hashBytes), pindex->nHeight, i, txhash, k, false), out.nValue));
-
-                    // record unspent output
-                    addressUnspentIndex.push_back(std::make_pair(CAddressUnspentKey(2, uint160(hashBytes), txhash, k), CAddressUnspentValue(out.nValue, out.scriptPubKey, pindex->nHeight)));
-
-                } else if (out.scriptPubKey.IsPayToPublicKeyHash()) {
-                    std::vector<unsigned char> hashBytes(out.scriptPubKey.begin()+3, out.scriptPubKey.begin()+23);
-
-                    // record receiving activity
-                    addressIndex.push_back(std::make_pair(CAddressIndexKey(1, uint160(hashBytes), pindex->nHeight, i, txhash, k, false), out.nValue));
-
-                    // record unspent output
-                    addressUnspentIndex.push_back(std::make_pair(CAddressUnspentKey(1, uint160(hashBytes), txhash, k), CAddressUnspentValue(out.nValue, out.scriptPubKey, pindex->nHeight)));
-
-                } else if (out.scriptPubKey.IsPayToPublicKey()) {
-                    uint160 hashBytes(Hash160(out.scriptPubKey.begin()+1, out.scriptPubKey.end()-1));
-                    addressIndex.push_back(std::make_pair(CAddressIndexKey(1, hashBytes, pindex->nHeight, i, txhash, k, false), out.nValue));
-                    addressUnspentIndex.push_back(std::make_pair(CAddressUnspentKey(1, hashBytes, txhash, k), CAddressUnspentValue(out.nValue, out.scriptPubKey, pindex->nHeight)));
-                } else {
-                    continue;
-                }
-
-            }
-        }
+        addressIndex.insert(addressIndex.end(), precheck.addressIndex.begin(), precheck.addressIndex.end());
+        addressUnspentIndex.insert(addressUnspentIndex.end(), precheck.addressUnspentIndex.begin(), precheck.addressUnspentIndex.end());
+        spentIndex.insert(spentIndex.end(), precheck.spentIndex.begin(), precheck.spentIndex.end());
 
         CTxUndo undoDummy;
         if (i > 0) {
@@ -2390,6 +2584,28 @@ bool CChainState::ConnectBlock(const CBlock& block, CValidationState& state, CBl
     // add this block to the view's block chain
     view.SetBestBlock(pindex->GetBlockHash());
 
+    if (utxo_stats && utxo_stats->hashBlock == hashPrevBlock) {
+        // the undo data holds exactly the coins spent by this block
+        for (size_t i = 0; i < block.vtx.size(); i++) {
+            const CTransaction& tx = *block.vtx[i];
+            if (i > 0) {
+                const CTxUndo& txundo = blockundo.vtxundo[i - 1];
+                for (size_t j = 0; j < tx.vin.size(); j++) {
+                    utxo_stats->RemoveCoin(tx.vin[j].prevout, txundo.vprevout[j]);
+                }
+            }
+            for (size_t o = 0; o < tx.vout.size(); o++) {
+                if (!tx.vout[o].scriptPubKey.IsUnspendable()) {
+                    utxo_stats->AddCoin(COutPoint(tx.GetHash(), o), Coin(tx.vout[o], pindex->nHeight, tx.IsCoinBase(), tx.IsCoinStake()));
+                }
+            }
+        }
+        utxo_stats->hashBlock = pindex->GetBlockHash();
+    }
+
+    // a reorg or an index catching up will most likely ask for this undo data next
+    g_block_cache.AddUndo(pindex->GetBlockHash(), std::make_shared<const CBlockUndo>(std::move(blockundo)));
+
     int64_t nTime6 = GetTimeMicros(); nTimeIndex += nTime6 - nTime5;
     LogPrint(BCLog::BENCHMARK, "    - Index writing: %.2fms [%.2fs (%.2fms/blk)]\n", MILLI * (nTime6 - nTime5), nTimeIndex * MICRO, nTimeIndex * MILLI / nBlocksTotal);
 
@@ -2558,7 +2774,9 @@ bool CChainState::FlushStateToDisk(
             if (!CheckDiskSpace(GetDataDir(), 48 * 2 * 2 * CoinsTip().GetCacheSize())) {
                 return AbortNode(state, "Disk space is too low!", _("Disk space is too low!"));
             }
-            // Flush the chainstate (which may refer to block index entries).
+            // Flush the chainstate (which may refer to block index entries),
+            // storing the UTXO set statistics atomically with it.
+            CoinsDB().SetUTXOStats(m_utxo_stats);
             if (!CoinsTip().Flush())
                 return AbortNode(state, "Failed to write to coin database");
             if (!evoDb->CommitRootTransaction()) {
@@ -2693,7 +2911,7 @@ bool CChainState::DisconnectTip(CValidationState& state, const CChainParams& cha
 
         CCoinsViewCache view(&CoinsTip());
         assert(view.GetBestBlock() == pindexDelete->GetBlockHash());
-        if (DisconnectBlock(block, pindexDelete, view) != DISCONNECT_OK)
+        if (DisconnectBlock(block, pindexDelete, view, &m_utxo_stats) != DISCONNECT_OK)
             return error("DisconnectTip(): DisconnectBlock %s failed", pindexDelete->GetBlockHash().ToString());
         bool flushed = view.Flush();
         assert(flushed);
@@ -2808,10 +3026,9 @@ bool CChainState::ConnectTip(CValidationState& state, const CChainParams& chainp
     int64_t nTime1 = GetTimeMicros();
     std::shared_ptr<const CBlock> pthisBlock;
     if (!pblock) {
-        std::shared_ptr<CBlock> pblockNew = std::make_shared<CBlock>();
-        if (!ReadBlockFromDisk(*pblockNew, pindexNew, chainparams.GetConsensus()))
+        pthisBlock = ReadSharedBlockFromDisk(pindexNew, chainparams.GetConsensus());
+        if (!pthisBlock)
             return AbortNode(state, "Failed to read block");
-        pthisBlock = pblockNew;
     } else {
         pthisBlock = pblock;
     }
@@ -2824,7 +3041,7 @@ bool CChainState::ConnectTip(CValidationState& state, const CChainParams& chainp
         auto dbTx = evoDb->BeginTransaction();
 
         CCoinsViewCache view(&CoinsTip());
-        bool rv = ConnectBlock(blockConnecting, state, pindexNew, view, chainparams);
+        bool rv = ConnectBlock(blockConnecting, state, pindexNew, view, chainparams, false, &m_utxo_stats);
         GetMainSignals().BlockChecked(blockConnecting, state);
         if (!rv) {
             if (state.IsInvalid())
@@ -2859,6 +3076,12 @@ bool CChainState::ConnectTip(CValidationState& state, const CChainParams& chainp
     boost::posix_time::time_duration diff = finish - start;
     statsClient.timing("ConnectTip_ms", diff.total_milliseconds(), 1.0f);
 
+    // Share the connected block with everyone who is about to read it back (chainlocks, ZMQ, indexes, peers).
+    // Only cache it if it carries the same flags ReadBlockFromDisk would set.
+    if (pblock && (!blockConnecting.IsProofOfStakeTX() || (blockConnecting.nFlags & CBlockIndex::BLOCK_PROOF_OF_STAKE))) {
+        g_block_cache.AddBlock(pindexNew->GetBlockHash(), pthisBlock);
+    }
+
     connectTrace.BlockConnected(pindexNew, std::move(pthisBlock));
     return true;
 }
@@ -2986,6 +3209,9 @@ bool CChainState::ActivateBestChainStep(CValidationState& state, const CChainPar
         }
         nHeight = nTargetHeight;
 
+        // PirateCash: recover the block signers of the whole batch in parallel ahead of ConnectBlock
+        PrecheckBlockSigners(vpindexToConnect);
+
         // Connect new blocks.
         for (CBlockIndex *pindexConnect : reverse_iterate(vpindexToConnect)) {
             if (!ConnectTip(state, chainparams, pindexConnect, pindexConnect == pindexMostWork ? pblock : std::shared_ptr<const CBlock>(), connectTrace, disconnectpool)) {
@@ -3529,13 +3755,13 @@ void ResetBlockFailureFlags(CBlockIndex *pindex) {
     return ::ChainstateActive().ResetBlockFailureFlags(pindex);
 }
 
-CBlockIndex* BlockManager::AddToBlockIndex(const CBlockHeader& block, enum BlockStatus nStatus)
+CBlockIndex* BlockManager::AddToBlockIndex(const CBlockHeader& block, enum BlockStatus nStatus, const uint256* phash)
 {
     assert(!(nStatus & BLOCK_FAILED_MASK)); // no failed blocks allowed
     AssertLockHeld(cs_main);
 
     // Check for duplicate
-    uint256 hash = block.GetHash();
+    uint256 hash = phash != nullptr ? *phash : block.GetHash();
     BlockMap::iterator it = m_block_index.find(hash);
     if (it != m_block_index.end())
         return it->second;
@@ -3700,17 +3926,17 @@ static bool FindUndoPos(CValidationState &state, int nFile, FlatFilePos &pos, un
     return true;
 }
 
-static bool CheckBlockHeader(const CBlockHeader& block, CValidationState& state, const Consensus::Params& consensusParams, bool fCheckProof)
+static bool CheckBlockHeader(const CBlockHeader& block, CValidationState& state, const Consensus::Params& consensusParams, bool fCheckProof, const CBlockHeaderPrecheck* precheck = nullptr)
 {
     // NOTE: left here for original behavior, modern check is in the CheckBlock()
     // Check proof of work matches claimed amount
-    if (fCheckProof && !CheckProofOfWork(block.GetPoWHash(), block.nBits, consensusParams) && block.GetBlockTime() != 1541202300)
+    if (fCheckProof && !CheckProofOfWork(precheck != nullptr && !precheck->hashPoW.IsNull() ? precheck->hashPoW : block.GetPoWHash(), block.nBits, consensusParams) && block.GetBlockTime() != 1541202300)
         return state.DoS(50, false, REJECT_INVALID, "high-hash", false, "proof of work failed");
 
     // Check DevNet
     if (!consensusParams.hashDevnetGenesisBlock.IsNull() &&
             block.hashPrevBlock == consensusParams.hashGenesisBlock &&
-            block.GetHash() != consensusParams.hashDevnetGenesisBlock) {
+            (precheck != nullptr ? precheck->hash : block.GetHash()) != consensusParams.hashDevnetGenesisBlock) {
         return state.DoS(100, error("CheckBlockHeader(): wrong devnet genesis"),
                          REJECT_INVALID, "devnet-genesis");
     }
@@ -3718,7 +3944,7 @@ static bool CheckBlockHeader(const CBlockHeader& block, CValidationState& state,
     return true;
 }
 
-bool CheckBlock(const CBlock& block, CValidationState& state, const Consensus::Params& consensusParams, bool fCheckProof, bool fCheckMerkleRoot)
+bool CheckBlock(const CBlock& block, CValidationState& state, const Consensus::Params& consensusParams, bool fCheckProof, bool fCheckMerkleRoot, const CKeyID* signer)
 {
     // These are checks that are independent of context.
 
@@ -3771,7 +3997,7 @@ bool CheckBlock(const CBlock& block, CValidationState& state, const Consensus::P
 
     if (block.IsProofOfStakeV2()) {
         // CoinStake is a subset of CoinBase in PirateCash
-        if (fCheckProof && !block.HasStake())
+        if (fCheckProof && !(signer ? block.HasStake(*signer) : block.HasStake()))
             return state.DoS(100, false, REJECT_INVALID, "bad-PoS-stake", false, "stake contraints failed");
     }
 
@@ -3826,7 +4052,7 @@ static CBlockIndex* GetLastCheckpoint(const CCheckpointData& data) EXCLUSIVE_LOC
  *  in ConnectBlock().
  *  Note that -reindex-chainstate skips the validation that happens here!
  */
-static bool ContextualCheckBlockHeader(const CBlockHeader& block, CValidationState& state, const CChainParams& params, const CBlockIndex* pindexPrev, int64_t nAdjustedTime, bool fCheckProof) EXCLUSIVE_LOCKS_REQUIRED(cs_main)
+static bool ContextualCheckBlockHeader(const CBlockHeader& block, CValidationState& state, const CChainParams& params, const CBlockIndex* pindexPrev, int64_t nAdjustedTime, bool fCheckProof, const CBlockHeaderPrecheck* precheck = nullptr) EXCLUSIVE_LOCKS_REQUIRED(cs_main)
 {
     assert(pindexPrev != nullptr);
     const int nHeight = pindexPrev->nHeight + 1;
@@ -3880,7 +4106,7 @@ static bool ContextualCheckBlockHeader(const CBlockHeader& block, CValidationSta
             return state.Invalid(false, REJECT_OBSOLETE, strprintf("bad-version(0x%08x)", block.nVersion),
                                  strprintf("rejected nVersion=0x%08x block", block.nVersion));
 
-    if (fCheckProof && !CheckProof(state, block, consensusParams)) {
+    if (fCheckProof && !CheckProof(state, block, consensusParams, precheck)) {
         return false;
     }
 
@@ -3954,11 +4180,11 @@ static bool ContextualCheckBlock(const CBlock& block, CValidationState& state, c
     return true;
 }
 
-bool BlockManager::AcceptBlockHeader(const CBlockHeader& block, CValidationState& state, const CChainParams& chainparams, CBlockIndex** ppindex)
+bool BlockManager::AcceptBlockHeader(const CBlockHeader& block, CValidationState& state, const CChainParams& chainparams, CBlockIndex** ppindex, const CBlockHeaderPrecheck* precheck)
 {
     AssertLockHeld(cs_main);
     // Check for duplicate
-    uint256 hash = block.GetHash();
+    uint256 hash = precheck != nullptr ? precheck->hash : block.GetHash();
     BlockMap::iterator miSelf = m_block_index.find(hash);
     CBlockIndex *pindex = nullptr;
 
@@ -3976,7 +4202,7 @@ bool BlockManager::AcceptBlockHeader(const CBlockHeader& block, CValidationState
             return true;
         }
 
-        if (!CheckBlockHeader(block, state, chainparams.GetConsensus(), !((block.nFlags & CBlockIndex::BLOCK_PROOF_OF_STAKE)||(block.IsProofOfStakeV2()))))
+        if (!CheckBlockHeader(block, state, chainparams.GetConsensus(), !((block.nFlags & CBlockIndex::BLOCK_PROOF_OF_STAKE)||(block.IsProofOfStakeV2())), precheck))
             return error("%s: Consensus::CheckBlockHeader: %s, %s", __func__, hash.ToString(), FormatStateMessage(state));
 
         // Get prev block index
@@ -3994,7 +4220,7 @@ bool BlockManager::AcceptBlockHeader(const CBlockHeader& block, CValidationState
             // it's ok-ish, the other node is probably missing the latest chainlock
             return state.DoS(10, error("%s: prev block %s conflicts with chainlock", __func__, block.hashPrevBlock.ToString()), REJECT_INVALID, "bad-prevblk-chainlock");
 
-        if (!ContextualCheckBlockHeader(block, state, chainparams, pindexPrev, GetAdjustedTime(), true)) {
+        if (!ContextualCheckBlockHeader(block, state, chainparams, pindexPrev, GetAdjustedTime(), true, precheck)) {
             if (!state.IsTransientError()) {
                 error("%s: Consensus::ContextualCheckBlockHeader: %s, %s", __func__, hash.ToString(), FormatStateMessage(state));
             }
@@ -4041,13 +4267,18 @@ bool BlockManager::AcceptBlockHeader(const CBlockHeader& block, CValidationState
 
         if (llmq::chainLocksHandler->HasConflictingChainLock(pindexPrev->nHeight + 1, hash)) {
             if (pindex == nullptr) {
-                AddToBlockIndex(block, BLOCK_CONFLICT_CHAINLOCK);
+                AddToBlockIndex(block, BLOCK_CONFLICT_CHAINLOCK, &hash);
             }
             return state.DoS(10, error("%s: header %s conflicts with chainlock", __func__, hash.ToString()), REJECT_INVALID, "bad-chainlock");
         }
     }
-    if (pindex == nullptr)
-        pindex = AddToBlockIndex(block);
+    if (pindex == nullptr) {
+        pindex = AddToBlockIndex(block, BLOCK_VALID_TREE, &hash);
+        // PirateCash: the signer was recovered by CheckProofOfStake, keep it for ConnectBlock
+        if (block.IsProofOfStakeV2() && block.posPubKey.IsValid()) {
+            pindex->posSignerID = block.posPubKey.GetID();
+        }
+    }
 
     if (ppindex)
         *ppindex = pindex;
@@ -4058,22 +4289,172 @@ bool BlockManager::AcceptBlockHeader(const CBlockHeader& block, CValidationState
     return true;
 }
 
+namespace {
+/** Context free checks of one header of a batch, see PrecheckBlockHeaders */
+class CBlockHeaderCheck
+{
+private:
+    const CBlockHeader* pheader{nullptr};
+    CBlockHeaderPrecheck* pprecheck{nullptr};
+
+public:
+    CBlockHeaderCheck() = default;
+    CBlockHeaderCheck(const CBlockHeader& header, CBlockHeaderPrecheck& precheck) : pheader(&header), pprecheck(&precheck) {}
+
+    bool operator()()
+    {
+        const CBlockHeader& header = *pheader;
+        if (pprecheck->hash.IsNull()) {
+            pprecheck->hash = header.GetHash();
+        }
+        if (header.IsProofOfStakeV2()) {
+            if (!header.vchBlockSig.empty()) {
+                pprecheck->signer.RecoverCompact(pprecheck->hash, header.vchBlockSig);
+            }
+        } else if (!(header.nFlags & CBlockIndex::BLOCK_PROOF_OF_STAKE)) {
+            // legacy block hashes are the scrypt hashes already
+            pprecheck->hashPoW = header.nVersion < 4 ? pprecheck->hash : header.GetPoWHash();
+        }
+        // Failures are detected when the results are used by AcceptBlockHeader
+        return true;
+    }
+
+    void swap(CBlockHeaderCheck& check)
+    {
+        std::swap(pheader, check.pheader);
+        std::swap(pprecheck, check.pprecheck);
+    }
+};
+} // namespace
+
+static CCheckQueue<CBlockHeaderCheck> headercheckqueue(16);
+
+void StartHeaderCheckWorkerThreads(int threads_num)
+{
+    headercheckqueue.StartWorkerThreads(threads_num, "headerch");
+}
+
+void StopHeaderCheckWorkerThreads()
+{
+    headercheckqueue.StopWorkerThreads();
+}
+
+static void RunBlockHeaderChecks(const std::deque<CBlockHeader>& headers, std::deque<CBlockHeaderPrecheck>& prechecks, size_t nBegin, size_t nEnd)
+{
+    std::vector<CBlockHeaderCheck> vChecks;
+    vChecks.reserve(nEnd - nBegin);
+    for (size_t i = nBegin; i < nEnd; i++) {
+        vChecks.emplace_back(headers[i], prechecks[i]);
+    }
+    CCheckQueueControl<CBlockHeaderCheck> control(&headercheckqueue);
+    control.Add(vChecks);
+    control.Wait();
+}
+
+static std::deque<CBlockHeaderPrecheck> RunBlockHeaderChecks(const std::deque<CBlockHeader>& headers)
+{
+    std::deque<CBlockHeaderPrecheck> prechecks(headers.size());
+    RunBlockHeaderChecks(headers, prechecks, 0, headers.size());
+    return prechecks;
+}
+
+std::deque<CBlockHeaderPrecheck> PrecheckBlockHeaders(const std::deque<CBlockHeader>& headers)
+{
+    std::deque<CBlockHeaderPrecheck> prechecks(headers.size());
+    PrecheckBlockHeaders(headers, prechecks, 0, headers.size());
+    return prechecks;
+}
+
+void PrecheckBlockHeaders(const std::deque<CBlockHeader>& headers, std::deque<CBlockHeaderPrecheck>& prechecks, size_t nBegin, size_t nEnd)
+{
+    AssertLockNotHeld(cs_main);
+    assert(prechecks.size() == headers.size() && nBegin <= nEnd && nEnd <= headers.size());
+    if (nBegin == nEnd) {
+        return;
+    }
+    int64_t nTimeStart = GetTimeMicros();
+
+    RunBlockHeaderChecks(headers, prechecks, nBegin, nEnd);
+
+    LogPrint(BCLog::BENCHMARK, "    - Precheck %u headers: %.2fms\n", nEnd - nBegin, (GetTimeMicros() - nTimeStart) * MILLI);
+}
+
+void PrecheckBlockSigners(const std::vector<CBlockIndex*>& vpindex)
+{
+    AssertLockHeld(cs_main);
+    int64_t nTimeStart = GetTimeMicros();
+
+    std::deque<CBlockHeader> headers;
+    std::vector<CBlockIndex*> vpindexPending;
+    for (CBlockIndex* pindex : vpindex) {
+        if (pindex->IsProofOfStakeV2() && pindex->posSignerID.IsNull() && !pindex->vchBlockSig.empty()) {
+            headers.push_back(pindex->GetBlockHeader());
+            vpindexPending.push_back(pindex);
+        }
+    }
+    // A single block is recovered by CheckBlock just as fast
+    if (vpindexPending.size() < 2) {
+        return;
+    }
+
+    // The checks don't need cs_main, so waiting for the queue while holding it can't deadlock
+    const std::deque<CBlockHeaderPrecheck> prechecks = RunBlockHeaderChecks(headers);
+    for (size_t i = 0; i < vpindexPending.size(); i++) {
+        if (prechecks[i].signer.IsValid() && prechecks[i].hash == vpindexPending[i]->GetBlockHash()) {
+            vpindexPending[i]->posSignerID = prechecks[i].signer.GetID();
+        }
+    }
+
+    LogPrint(BCLog::BENCHMARK, "    - Precheck %u block signers: %.2fms\n", vpindexPending.size(), (GetTimeMicros() - nTimeStart) * MILLI);
+}
+
+/** Interval of the header sync speed reports in microseconds */
+static const int64_t HEADER_SYNC_REPORT_INTERVAL = 10 * 1000000;
+static int64_t nHeaderSyncReportTime GUARDED_BY(cs_main) = 0;
+static uint64_t nHeaderSyncCount GUARDED_BY(cs_main) = 0;
+
+/** Log the number of new headers per second while the best header is far behind */
+static void ReportHeaderSyncSpeed(size_t nNewHeaders) EXCLUSIVE_LOCKS_REQUIRED(cs_main)
+{
+    const int64_t nNow = GetTimeMicros();
+    nHeaderSyncCount += nNewHeaders;
+    if (nHeaderSyncReportTime == 0) {
+        nHeaderSyncReportTime = nNow;
+    }
+    if (nNow - nHeaderSyncReportTime < HEADER_SYNC_REPORT_INTERVAL) {
+        return;
+    }
+
+    if (nHeaderSyncCount > 0 && pindexBestHeader != nullptr && pindexBestHeader->GetBlockTime() < GetAdjustedTime() - nMaxTipAge) {
+        const double dHeadersPerSecond = nHeaderSyncCount / ((nNow - nHeaderSyncReportTime) * MICRO);
+        LogPrintf("Synchronizing block headers, height: %d, %.1f headers/s\n", pindexBestHeader->nHeight, dHeadersPerSecond);
+        statsClient.gauge("blocks.headers.PerSecond", dHeadersPerSecond, 1.0f);
+    }
+    nHeaderSyncReportTime = nNow;
+    nHeaderSyncCount = 0;
+}
+
 // Exposed wrapper for AcceptBlockHeader
-bool ProcessNewBlockHeaders(std::deque<CBlockHeader>& headers, CValidationState& state, const CChainParams& chainparams, const CBlockIndex** ppindex, CBlockHeader *first_invalid, int burst_limit)
+bool ProcessNewBlockHeaders(std::deque<CBlockHeader>& headers, std::deque<CBlockHeaderPrecheck>& prechecks, CValidationState& state, const CChainParams& chainparams, const CBlockIndex** ppindex, CBlockHeader *first_invalid, int burst_limit)
 {
+    assert(prechecks.size() == headers.size());
     if (first_invalid != nullptr) first_invalid->SetNull();
     {
         LOCK(cs_main);
+        const size_t nBlockIndexSize = g_blockman.m_block_index.size();
+        bool fAccepted = true;
         while (!headers.empty()) {
             CBlockIndex *pindex = nullptr; // Use a temp pindex instead of ppindex to avoid a const_cast
-            bool accepted = g_blockman.AcceptBlockHeader(headers.front(), state, chainparams, &pindex);
+            bool accepted = g_blockman.AcceptBlockHeader(headers.front(), state, chainparams, &pindex, &prechecks.front());
             ::ChainstateActive().CheckBlockIndex(chainparams.GetConsensus());
 
             if (!accepted) {
-                return false;
+                fAccepted = false;
+                break;
             }
 
             headers.pop_front();
+            prechecks.pop_front();
 
             if (ppindex) {
                 *ppindex = pindex;
@@ -4083,11 +4464,30 @@ bool ProcessNewBlockHeaders(std::deque<CBlockHeader>& headers, CValidationState&
                 break;
             }
         }
+        ReportHeaderSyncSpeed(g_blockman.m_block_index.size() - nBlockIndexSize);
+        if (!fAccepted) {
+            return false;
+        }
     }
     NotifyHeaderTip();
     return true;
 }
 
+bool ProcessNewBlockHeaders(std::deque<CBlockHeader>& headers, CValidationState& state, const CChainParams& chainparams, const CBlockIndex** ppindex, CBlockHeader *first_invalid, int burst_limit)
+{
+    // Only the headers which are going to be processed are prechecked, the rest stays in headers
+    std::deque<CBlockHeader> batch;
+    while (!headers.empty() && batch.size() < (size_t)std::max(burst_limit, 1)) {
+        batch.emplace_back(std::move(headers.front()));
+        headers.pop_front();
+    }
+    std::deque<CBlockHeaderPrecheck> prechecks = PrecheckBlockHeaders(batch);
+    const bool ret = ProcessNewBlockHeaders(batch, prechecks, state, chainparams, ppindex, first_invalid, burst_limit);
+    // put back what was not processed
+    headers.insert(headers.begin(), std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+    return ret;
+}
+
 /** Store block on disk. If dbp is non-nullptr, the file is known to already reside on disk */
 static FlatFilePos SaveBlockToDisk(const CBlock& block, int nHeight, const CChainParams& chainparams, const FlatFilePos* dbp) {
     unsigned int nBlockSize = ::GetSerializeSize(block, SER_DISK, CLIENT_VERSION);
@@ -4644,6 +5044,25 @@ bool CChainState::LoadChainTip(const CChainParams& chainparams)
     return true;
 }
 
+bool CChainState::LoadUTXOStats()
+{
+    AssertLockHeld(cs_main);
+    if (CoinsDB().ReadUTXOStats(m_utxo_stats)) {
+        return true;
+    }
+
+    // Databases written by older versions, or rolled forward by ReplayBlocks(), have
+    // no statistics stored. Compute them once, they are kept up to date from then on.
+    LogPrintf("Computing UTXO set statistics...\n");
+    int64_t nStart = GetTimeMillis();
+    if (!ComputeUTXOStats(&CoinsDB(), m_utxo_stats)) {
+        m_utxo_stats = CUTXOStats();
+        return false;
+    }
+    LogPrintf("Computed UTXO set statistics for %d outputs in %dms\n", m_utxo_stats.nTransactionOutputs, GetTimeMillis() - nStart);
+    return true;
+}
+
 CVerifyDB::CVerifyDB()
 {
     uiInterface.ShowProgress(_("Verifying blocks...").translated, 0, false);
@@ -5310,7 +5729,166 @@ int VersionBitsTipStateSinceHeight(const Consensus::Params& params, Consensus::D
     return VersionBitsStateSinceHeight(::ChainActive().Tip(), params, pos, versionbitscache);
 }
 
-static const uint64_t MEMPOOL_DUMP_VERSION = 1;
+/** mempool.dat without per-entry fee/size/sigop data */
+static const uint64_t MEMPOOL_DUMP_VERSION_NO_ENTRY_DATA = 1;
+static const uint64_t MEMPOOL_DUMP_VERSION = 2;
+/** Number of transactions whose scripts are pre-validated in one script-check queue run */
+static const size_t MEMPOOL_LOAD_BATCH_SIZE = 1000;
+
+namespace {
+/** A transaction read back from mempool.dat */
+struct MempoolLoadEntry
+{
+    CTransactionRef tx;
+    int64_t nTime;
+    int64_t nFeeDelta;
+
+    /** Entry data stored with the dump. Only a hint: the transaction is fully revalidated on load. */
+    bool fHaveEntryData{false};
+    CAmount nFee{0};
+    uint64_t nTxSize{0};
+    uint32_t nSigOpCount{0};
+};
+} // namespace
+
+/**
+ * Order loaded transactions so that in-file parents always come before their
+ * children. Dumps are written in depth order already, so this normally keeps
+ * the file order, but it does not rely on it.
+ */
+static std::vector<MempoolLoadEntry> SortMempoolLoadEntries(std::vector<MempoolLoadEntry>&& entries)
+{
+    std::unordered_map<uint256, size_t, StaticSaltedHasher> mapIndex;
+    mapIndex.reserve(entries.size());
+    for (size_t i = 0; i < entries.size(); i++) {
+        mapIndex.emplace(entries[i].tx->GetHash(), i);
+    }
+
+    std::vector<size_t> vParentCount(entries.size(), 0);
+    std::vector<std::vector<size_t>> vChildren(entries.size());
+    for (size_t i = 0; i < entries.size(); i++) {
+        std::set<size_t> setParents;
+        for (const auto& txin : entries[i].tx->vin) {
+            auto it = mapIndex.find(txin.prevout.hash);
+            if (it != mapIndex.end() && it->second != i) {
+                setParents.emplace(it->second);
+            }
+        }
+        vParentCount[i] = setParents.size();
+        for (size_t parent : setParents) {
+            vChildren[parent].emplace_back(i);
+        }
+    }
+
+    std::vector<size_t> vOrder;
+    vOrder.reserve(entries.size());
+    for (size_t i = 0; i < entries.size(); i++) {
+        if (vParentCount[i] == 0) {
+            vOrder.emplace_back(i);
+        }
+    }
+    for (size_t pos = 0; pos < vOrder.size(); pos++) {
+        for (size_t child : vChildren[vOrder[pos]]) {
+            if (--vParentCount[child] == 0) {
+                vOrder.emplace_back(child);
+            }
+        }
+    }
+
+    std::vector<MempoolLoadEntry> ret;
+    ret.reserve(entries.size());
+    for (size_t i : vOrder) {
+        ret.emplace_back(std::move(entries[i]));
+    }
+    // Entries involved in a dependency cycle (only possible with a corrupted
+    // file) are appended in file order and will simply fail validation.
+    for (size_t i = 0; i < entries.size(); i++) {
+        if (vParentCount[i] != 0) {
+            ret.emplace_back(std::move(entries[i]));
+        }
+    }
+    return ret;
+}
+
+/**
+ * Run the script checks of a batch of loaded transactions on the script-check
+ * worker threads. This only warms the signature and script execution caches,
+ * the transactions are still accepted one by one through
+ * AcceptToMemoryPoolWithTime afterwards, which then skips most of the
+ * expensive work. Transactions whose inputs can't be found are left alone.
+ */
+static void PrevalidateMempoolLoadBatch(const CTxMemPool& pool, std::vector<MempoolLoadEntry>::const_iterator begin, std::vector<MempoolLoadEntry>::const_iterator end)
+{
+    const size_t nBatch = std::distance(begin, end);
+    std::vector<PrecomputedTransactionData> txsdata(nBatch);
+    std::vector<CScriptCheck> vChecks;
+    std::vector<const CTransaction*> vChecked;
+    vChecked.reserve(nBatch);
+
+    {
+        // Outputs created by earlier transactions of this load, which are not in the UTXO set yet
+        std::map<COutPoint, CTxOut> mapLoadedOutputs;
+
+        LOCK2(cs_main, pool.cs);
+        const CCoinsViewCache& coinsTip = ::ChainstateActive().CoinsTip();
+        size_t i = 0;
+        for (auto it = begin; it != end; ++it, ++i) {
+            const CTransaction& tx = *it->tx;
+            std::vector<CTxOut> vSpent;
+            vSpent.reserve(tx.vin.size());
+            for (const auto& txin : tx.vin) {
+                auto itLoaded = mapLoadedOutputs.find(txin.prevout);
+                if (itLoaded != mapLoadedOutputs.end()) {
+                    vSpent.emplace_back(itLoaded->second);
+                    continue;
+                }
+                const CTransactionRef txFrom = pool.get(txin.prevout.hash);
+                if (txFrom && txin.prevout.n < txFrom->vout.size()) {
+                    vSpent.emplace_back(txFrom->vout[txin.prevout.n]);
+                    continue;
+                }
+                const Coin& coin = coinsTip.AccessCoin(txin.prevout);
+                if (coin.IsSpent()) {
+                    break;
+                }
+                vSpent.emplace_back(coin.out);
+            }
+            for (size_t n = 0; n < tx.vout.size(); n++) {
+                mapLoadedOutputs.emplace(COutPoint(tx.GetHash(), n), tx.vout[n]);
+            }
+            if (vSpent.size() != tx.vin.size()) {
+                // Missing inputs, leave it to AcceptToMemoryPool to reject it
+                continue;
+            }
+
+            txsdata[i].Init(tx, {});
+            for (unsigned int n = 0; n < tx.vin.size(); n++) {
+                vChecks.emplace_back(vSpent[n], tx, n, STANDARD_SCRIPT_VERIFY_FLAGS, true /* cacheStore */, &txsdata[i]);
+            }
+            vChecked.emplace_back(&tx);
+        }
+    }
+
+    // Don't hold cs_main while waiting for the checks, ConnectBlock takes
+    // cs_main before the check queue control. The control holds the queue
+    // until it is destroyed, so it has to go out of scope before we take
+    // cs_main below.
+    {
+        CCheckQueueControl<CScriptCheck> control(&scriptcheckqueue);
+        control.Add(vChecks);
+        if (!control.Wait()) {
+            // At least one script failed. The signatures which were verified
+            // are cached anyway, AcceptToMemoryPool will find out which
+            // transaction is to blame.
+            return;
+        }
+    }
+
+    LOCK(cs_main);
+    for (const CTransaction* ptx : vChecked) {
+        g_scriptExecutionCache.insert(GetScriptExecutionCacheEntry(*ptx, STANDARD_SCRIPT_VERIFY_FLAGS));
+    }
+}
 
 bool LoadMempool(CTxMemPool& pool)
 {
@@ -5327,65 +5905,111 @@ bool LoadMempool(CTxMemPool& pool)
     int64_t expired = 0;
     int64_t failed = 0;
     int64_t already_there = 0;
+    int64_t skipped = 0;
     int64_t nNow = GetTime();
+    int64_t nStart = GetTimeMicros();
+
+    std::vector<MempoolLoadEntry> entries;
+    std::map<uint256, CAmount> mapDeltas;
 
     try {
         uint64_t version;
         file >> version;
-        if (version != MEMPOOL_DUMP_VERSION) {
+        if (version != MEMPOOL_DUMP_VERSION && version != MEMPOOL_DUMP_VERSION_NO_ENTRY_DATA) {
             return false;
         }
         uint64_t num;
         file >> num;
         while (num) {
             --num;
-            CTransactionRef tx;
-            int64_t nTime;
-            int64_t nFeeDelta;
-            file >> tx;
-            file >> nTime;
-            file >> nFeeDelta;
-
-            CAmount amountdelta = nFeeDelta;
+            MempoolLoadEntry entry;
+            file >> entry.tx;
+            file >> entry.nTime;
+            file >> entry.nFeeDelta;
+            if (version >= MEMPOOL_DUMP_VERSION) {
+                file >> entry.nFee;
+                file >> entry.nTxSize;
+                file >> entry.nSigOpCount;
+                entry.fHaveEntryData = true;
+            }
+
+            CAmount amountdelta = entry.nFeeDelta;
             if (amountdelta) {
-                pool.PrioritiseTransaction(tx->GetHash(), amountdelta);
+                pool.PrioritiseTransaction(entry.tx->GetHash(), amountdelta);
             }
-            CValidationState state;
-            if (nTime + nExpiryTimeout > nNow) {
-                LOCK(cs_main);
-                AcceptToMemoryPoolWithTime(chainparams, pool, state, tx, nullptr /* pfMissingInputs */, nTime,
-                                           false /* bypass_limits */, 0 /* nAbsurdFee */, false /* test_accept */);
-                if (state.IsValid()) {
-                    ++count;
-                } else {
-                    // mempool may contain the transaction already, e.g. from
-                    // wallet(s) having loaded it while we were processing
-                    // mempool transactions; consider these as valid, instead of
-                    // failed, but mark them as 'already there'
-                    if (pool.exists(tx->GetHash())) {
-                        ++already_there;
-                    } else {
-                        ++failed;
-                    }
-                }
+            if (entry.nTime + nExpiryTimeout > nNow) {
+                entries.emplace_back(std::move(entry));
             } else {
                 ++expired;
             }
-            if (ShutdownRequested())
-                return false;
         }
-        std::map<uint256, CAmount> mapDeltas;
         file >> mapDeltas;
-
-        for (const auto& i : mapDeltas) {
-            pool.PrioritiseTransaction(i.first, i.second);
-        }
     } catch (const std::exception& e) {
         LogPrintf("Failed to deserialize mempool data on disk: %s. Continuing anyway.\n", e.what());
         return false;
     }
 
-    LogPrintf("Imported mempool transactions from disk: %i succeeded, %i failed, %i expired, %i already there\n", count, failed, expired, already_there);
+    entries = SortMempoolLoadEntries(std::move(entries));
+
+    // The stored entry data lets us drop transactions which can't pass the
+    // policy checks before spending any time on their scripts. Fee, size and
+    // sigops only depend on the transaction itself, so they are still valid.
+    entries.erase(std::remove_if(entries.begin(), entries.end(), [&](const MempoolLoadEntry& entry) {
+        if (!entry.fHaveEntryData) {
+            return false;
+        }
+        CAmount nModifiedFee = entry.nFee;
+        pool.ApplyDelta(entry.tx->GetHash(), nModifiedFee);
+        if (entry.nSigOpCount > MAX_STANDARD_TX_SIGOPS || nModifiedFee < ::minRelayTxFee.GetFee(entry.nTxSize)) {
+            ++skipped;
+            return true;
+        }
+        return false;
+    }), entries.end());
+
+    int64_t nLoaded = GetTimeMicros();
+    LogPrint(BCLog::MEMPOOL, "Validating %i mempool transactions from disk\n", entries.size());
+
+    for (size_t nBatchStart = 0; nBatchStart < entries.size(); nBatchStart += MEMPOOL_LOAD_BATCH_SIZE) {
+        const auto itBegin = entries.cbegin() + nBatchStart;
+        const auto itEnd = entries.cbegin() + std::min(nBatchStart + MEMPOOL_LOAD_BATCH_SIZE, entries.size());
+
+        if (g_parallel_script_checks) {
+            PrevalidateMempoolLoadBatch(pool, itBegin, itEnd);
+        }
+
+        for (auto it = itBegin; it != itEnd; ++it) {
+            CValidationState state;
+            LOCK(cs_main);
+            AcceptToMemoryPoolWithTime(chainparams, pool, state, it->tx, nullptr /* pfMissingInputs */, it->nTime,
+                                       false /* bypass_limits */, 0 /* nAbsurdFee */, false /* test_accept */);
+            if (state.IsValid()) {
+                ++count;
+            } else {
+                // mempool may contain the transaction already, e.g. from
+                // wallet(s) having loaded it while we were processing
+                // mempool transactions; consider these as valid, instead of
+                // failed, but mark them as 'already there'
+                if (pool.exists(it->tx->GetHash())) {
+                    ++already_there;
+                } else {
+                    ++failed;
+                }
+            }
+        }
+        if (ShutdownRequested()) {
+            LogPrintf("Mempool import interrupted after %i of %i transactions\n", std::distance(entries.cbegin(), itEnd), entries.size());
+            return false;
+        }
+    }
+
+    for (const auto& i : mapDeltas) {
+        pool.PrioritiseTransaction(i.first, i.second);
+    }
+
+    int64_t nDone = GetTimeMicros();
+    LogPrintf("Imported mempool transactions from disk: %i succeeded, %i failed, %i expired, %i already there, %i skipped by policy\n", count, failed, expired, already_there, skipped);
+    LogPrint(BCLog::MEMPOOL, "Imported mempool: %gs to read, %gs to validate\n", (nLoaded - nStart) * MICRO, (nDone - nLoaded) * MICRO);
     return true;
 }
 
@@ -5425,6 +6049,9 @@ bool DumpMempool(const CTxMemPool& pool)
             file << *(i.tx);
             file << (int64_t)i.nTime;
             file << (int64_t)i.nFeeDelta;
+            file << i.nFee;
+            file << (uint64_t)i.nTxSize;
+            file << (uint32_t)i.nSigOpCount;
             mapDeltas.erase(i.tx->GetHash());
         }
 
@@ -5468,9 +6095,10 @@ bool CheckProof(CValidationState &state, const CBlockIndex &index, const Consens
 }
 
 /** Check PoW or PoS based on actual block **/
-bool CheckProof(CValidationState &state, const CBlockHeader &block, const Consensus::Params& params) {
+bool CheckProof(CValidationState &state, const CBlockHeader &block, const Consensus::Params& params, const CBlockHeaderPrecheck* precheck) {
     if (!((block.nFlags & CBlockIndex::BLOCK_PROOF_OF_STAKE)||block.IsProofOfStakeV2())) {
-        if (!CheckProofOfWork(block.GetPoWHash(), block.nBits, params) && block.GetBlockTime() != 1541202300) {
+        const uint256 hashPoW = precheck != nullptr && !precheck->hashPoW.IsNull() ? precheck->hashPoW : block.GetPoWHash();
+        if (!CheckProofOfWork(hashPoW, block.nBits, params) && block.GetBlockTime() != 1541202300) {
             return state.DoS(100, false, REJECT_INVALID, "bad-pow-proof", false, "block proof mismatch");
         }
 
@@ -5481,7 +6109,8 @@ bool CheckProof(CValidationState &state, const CBlockHeader &block, const Consen
     if (block.IsProofOfStakeV2())
     {
         uint256 hashProofOfStake = uint256();
-        return CheckProofOfStake(state, block, hashProofOfStake, params);
+        // a signer which couldn't be recovered, or wasn't prechecked at all, is recovered here again
+        return CheckProofOfStake(state, block, hashProofOfStake, params, precheck != nullptr && precheck->signer.IsValid() ? &precheck->signer : nullptr);
     }
     // TODO Add CheckProof for old PirateCash PoSv1, right now we're cheking checkpoints and it's enough but the better to check outdated PoS
     return true;
@@ -13,6 +13,7 @@
 
 #include <amount.h>
 #include <coins.h>
+#include <consensus/validation.h>
 #include <crypto/common.h> // for ReadLE64
 #include <fs.h>
 #include <policy/feerate.h>
@@ -219,6 +220,61 @@ bool ProcessNewBlock(const CChainParams& chainparams, const std::shared_ptr<cons
  */
 bool ProcessNewBlockHeaders(std::deque<CBlockHeader>& headers, CValidationState& state, const CChainParams& chainparams, const CBlockIndex** ppindex=nullptr, CBlockHeader *first_invalid=nullptr, int burst_limit=MAX_HEADERS_RESULTS) LOCKS_EXCLUDED(cs_main);
 
+/** Results of the context free checks of a block header which don't need cs_main, see PrecheckBlockHeaders */
+struct CBlockHeaderPrecheck
+{
+    uint256 hash;
+    //! scrypt hash to check against the target, only set for proof of work headers
+    uint256 hashPoW;
+    //! key recovered from vchBlockSig, only set for proof of stake v2 headers
+    CPubKey signer;
+};
+
+/**
+ * Hash a batch of headers, including the scrypt hashes of proof of work headers, and
+ * recover the block signers of proof of stake headers on the header checking worker
+ * threads. Must not be called with cs_main held.
+ */
+std::deque<CBlockHeaderPrecheck> PrecheckBlockHeaders(const std::deque<CBlockHeader>& headers);
+
+/**
+ * Same as above for the headers in [nBegin, nEnd) only, with prechecks holding one entry per header.
+ * Hashes which are already set are reused, the entries outside of the range are left alone.
+ */
+void PrecheckBlockHeaders(const std::deque<CBlockHeader>& headers, std::deque<CBlockHeaderPrecheck>& prechecks, size_t nBegin, size_t nEnd);
+
+/** Same as above, with the results of PrecheckBlockHeaders for each header. They are consumed together with the headers. */
+bool ProcessNewBlockHeaders(std::deque<CBlockHeader>& headers, std::deque<CBlockHeaderPrecheck>& prechecks, CValidationState& state, const CChainParams& chainparams, const CBlockIndex** ppindex=nullptr, CBlockHeader *first_invalid=nullptr, int burst_limit=MAX_HEADERS_RESULTS) LOCKS_EXCLUDED(cs_main);
+
+/**
+ * Recover the block signers of the proof of stake v2 blocks of a batch which are not
+ * known yet on the header checking worker threads and cache them in CBlockIndex::posSignerID.
+ */
+void PrecheckBlockSigners(const std::vector<CBlockIndex*>& vpindex) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+
+/** Results of the input checks of one transaction of a block, see PrecheckBlockInputs */
+struct CTxInputsPrecheck
+{
+    //! result of Consensus::CheckTxInputs, not set for the coinbase
+    bool fInputsValid{true};
+    CValidationState state;
+    CAmount nFee{0};
+    bool fSequenceLocksValid{true};
+    unsigned int nSigOps{0};
+    //! address and spent index entries of the inputs and outputs, only filled if the indexes are enabled
+    std::vector<std::pair<CAddressIndexKey, CAmount> > addressIndex;
+    std::vector<std::pair<CAddressUnspentKey, CAddressUnspentValue> > addressUnspentIndex;
+    std::vector<std::pair<CSpentIndexKey, CSpentIndexValue> > spentIndex;
+};
+
+/**
+ * First phase of ConnectBlock: resolve the coins spent by every transaction of the block
+ * and run the input, BIP68 and sigop checks and the index extraction of all transactions.
+ * Coins created earlier in the same block are taken from the block itself, so the view
+ * is only read. Runs on the input checking worker threads if fParallel is set.
+ */
+std::vector<CTxInputsPrecheck> PrecheckBlockInputs(const CBlock& block, const CCoinsViewCache& view, const CBlockIndex& index, unsigned int flags, int nLockTimeFlags, bool fParallel);
+
 /** Open a block file (blk?????.dat) */
 FILE* OpenBlockFile(const FlatFilePos &pos, bool fReadOnly = false);
 /** Translation to a filesystem path */
@@ -236,6 +292,16 @@ void UnloadBlockIndex();
 void StartScriptCheckWorkerThreads(int threads_num);
 /** Stop all of the script checking worker threads */
 void StopScriptCheckWorkerThreads();
+/** Run script checks on the script checking worker threads, returns false if any of them failed. Must not be called with cs_main held. */
+bool RunScriptChecks(std::vector<CScriptCheck>& vChecks);
+/** Run instances of header checking worker threads */
+void StartHeaderCheckWorkerThreads(int threads_num);
+/** Stop all of the header checking worker threads */
+void StopHeaderCheckWorkerThreads();
+/** Run instances of transaction input checking worker threads */
+void StartTxInputsCheckWorkerThreads(int threads_num);
+/** Stop all of the transaction input checking worker threads */
+void StopTxInputsCheckWorkerThreads();
 /** Retrieve a transaction (from memory pool, or from disk, if possible) */
 bool GetTransaction(const uint256& hash, CTransactionRef& tx, const Consensus::Params& params, uint256& hashBlock, const CBlockIndex* const blockIndex = nullptr);
 /**
@@ -335,7 +401,7 @@ private:
     PrecomputedTransactionData *txdata;
 
 public:
-    CScriptCheck(): ptxTo(nullptr), nIn(0), nFlags(0), cacheStore(false), error(SCRIPT_ERR_UNKNOWN_ERROR) {}
+    CScriptCheck(): ptxTo(nullptr), nIn(0), nFlags(0), cacheStore(false), error(SCRIPT_ERR_UNKNOWN_ERROR), txdata(nullptr) {}
     CScriptCheck(const CTxOut& outIn, const CTransaction& txToIn, unsigned int nInIn, unsigned int nFlagsIn, bool cacheIn, PrecomputedTransactionData* txdataIn) :
         m_tx_out(outIn), ptxTo(&txToIn), nIn(nInIn), nFlags(nFlagsIn), cacheStore(cacheIn), error(SCRIPT_ERR_UNKNOWN_ERROR), txdata(txdataIn) { }
 
@@ -368,13 +434,15 @@ void InitScriptExecutionCache();
 /** Functions for disk access for blocks */
 bool ReadBlockFromDisk(CBlock& block, const FlatFilePos& pos, const Consensus::Params& consensusParams);
 bool ReadBlockFromDisk(CBlock& block, const CBlockIndex* pindex, const Consensus::Params& consensusParams);
+/** Like ReadBlockFromDisk but hands out the cached block itself, returns nullptr on failure */
+std::shared_ptr<const CBlock> ReadSharedBlockFromDisk(const CBlockIndex* pindex, const Consensus::Params& consensusParams);
 
 bool UndoReadFromDisk(CBlockUndo& blockundo, const CBlockIndex* pindex);
 
 /** Functions for validating blocks and updating the block tree */
 
-/** Context-independent validity checks */
-bool CheckBlock(const CBlock& block, CValidationState& state, const Consensus::Params& consensusParams, bool fCheckProof = true, bool fCheckMerkleRoot = true);
+/** Context-independent validity checks, signer is the already recovered block signer if known */
+bool CheckBlock(const CBlock& block, CValidationState& state, const Consensus::Params& consensusParams, bool fCheckProof = true, bool fCheckMerkleRoot = true, const CKeyID* signer = nullptr);
 
 /** Check a block is completely valid from start to finish (only works on top of our current best block) */
 bool TestBlockValidity(CValidationState& state, const CChainParams& chainparams, const CBlock& block, CBlockIndex* pindexPrev, bool fChecfCheckProofkPOW = true, bool fCheckMerkleRoot = true) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
@@ -467,19 +535,21 @@ public:
     /** Clear all data members. */
     void Unload() EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
-    CBlockIndex* AddToBlockIndex(const CBlockHeader& block, enum BlockStatus nStatus = BLOCK_VALID_TREE) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+    CBlockIndex* AddToBlockIndex(const CBlockHeader& block, enum BlockStatus nStatus = BLOCK_VALID_TREE, const uint256* phash = nullptr) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
     /** Create a new block index entry for a given block hash */
     CBlockIndex* InsertBlockIndex(const uint256& hash) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
     /**
      * If a block header hasn't already been seen, call CheckBlockHeader on it, ensure
      * that it doesn't descend from an invalid block, and then add it to m_block_index.
+     * If precheck is set, the hashes and the block signer are taken from it.
      */
     bool AcceptBlockHeader(
         const CBlockHeader& block,
         CValidationState& state,
         const CChainParams& chainparams,
-        CBlockIndex** ppindex) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+        CBlockIndex** ppindex,
+        const CBlockHeaderPrecheck* precheck = nullptr) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 };
 
 /**
@@ -615,6 +685,10 @@ public:
      */
     std::set<CBlockIndex*, CBlockIndexWorkComparator> setBlockIndexCandidates;
 
+    //! Statistics about the UTXO set at the tip of m_chain, updated by
+    //! ConnectTip() and DisconnectTip(). hashBlock is null while unknown.
+    CUTXOStats m_utxo_stats GUARDED_BY(cs_main);
+
     //! @returns A reference to the in-memory cache of the UTXO set.
     CCoinsViewCache& CoinsTip() EXCLUSIVE_LOCKS_REQUIRED(cs_main)
     {
@@ -684,8 +758,9 @@ public:
     bool AcceptBlock(const std::shared_ptr<const CBlock>& pblock, CValidationState& state, const CChainParams& chainparams, CBlockIndex** ppindex, bool fRequested, const FlatFilePos* dbp, bool* fNewBlock) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
     // Block (dis)connection on a given view:
-    DisconnectResult DisconnectBlock(const CBlock& block, const CBlockIndex* pindex, CCoinsViewCache& view) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
-    bool ConnectBlock(const CBlock& block, CValidationState& state, CBlockIndex* pindex, CCoinsViewCache& view, const CChainParams& chainparams, bool fJustCheck = false) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+    // If utxo_stats is valid for the view's best block, it is updated along with the view.
+    DisconnectResult DisconnectBlock(const CBlock& block, const CBlockIndex* pindex, CCoinsViewCache& view, CUTXOStats* utxo_stats = nullptr) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+    bool ConnectBlock(const CBlock& block, CValidationState& state, CBlockIndex* pindex, CCoinsViewCache& view, const CChainParams& chainparams, bool fJustCheck = false, CUTXOStats* utxo_stats = nullptr) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
     // Apply the effects of a block disconnection on the UTXO set.
     bool DisconnectTip(CValidationState& state, const CChainParams& chainparams, DisconnectedBlockTransactions* disconnectpool) EXCLUSIVE_LOCKS_REQUIRED(cs_main, ::mempool.cs);
@@ -718,6 +793,9 @@ public:
     /** Update the chain tip based on database information, i.e. CoinsTip()'s best block. */
     bool LoadChainTip(const CChainParams& chainparams) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
+    /** Load m_utxo_stats from the coins database, computing them from scratch if they weren't stored. */
+    bool LoadUTXOStats() EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+
     //! Dictates whether we need to flush the cache to disk or not.
     //!
     //! @return the state of the size of the coins cache.
@@ -826,7 +904,7 @@ bool IsPoSV2EnforcedHeight(int nFirstPoSv2Block);
 bool IsPowActiveHeight(int nBlockHeight);
 
 bool CheckProof(CValidationState& state, const CBlockIndex &pindex, const Consensus::Params& params);
-bool CheckProof(CValidationState& state, const CBlockHeader &block, const Consensus::Params& params);
+bool CheckProof(CValidationState& state, const CBlockHeader &block, const Consensus::Params& params, const CBlockHeaderPrecheck* precheck = nullptr);
 
 //! Check whether the block associated with this index entry is pruned or not.
 inline bool IsBlockPruned(const CBlockIndex* pblockindex)
@@ -6,8 +6,12 @@
 
 #include <crypto/aes.h>
 #include <crypto/sha512.h>
+#include <ctpl_stl.h>
 #include <util/system.h>
+#include <util/time.h>
 
+#include <atomic>
+#include <future>
 #include <vector>
 
 int CCrypter::BytesToKeySHA512AES(const std::vector<unsigned char>& chSalt, const SecureString& strKeyData, int count, unsigned char *key,unsigned char *iv) const
@@ -239,6 +243,48 @@ bool CCryptoKeyStore::Lock(bool fAllowMixing)
     return true;
 }
 
+void CCryptoKeyStore::CheckCryptedKeysParallel(const CKeyingMaterial& vMasterKeyIn, bool& keyPass, bool& keyFail) const
+{
+    const int64_t nStart = GetTimeMillis();
+
+    std::vector<const std::pair<CPubKey, std::vector<unsigned char>>*> vKeys;
+    vKeys.reserve(mapCryptedKeys.size());
+    for (const auto& p : mapCryptedKeys) {
+        vKeys.emplace_back(&p.second);
+    }
+
+    const int nThreads = std::max(1, std::min(GetNumCores(), MAX_UNLOCK_CHECK_THREADS));
+    std::atomic<bool> fAnyPass{false};
+    std::atomic<bool> fAnyFail{false};
+    auto checkRange = [&](size_t nBegin, size_t nEnd) {
+        for (size_t i = nBegin; i < nEnd && !fAnyFail; i++) {
+            CKey key;
+            if (!DecryptKey(vMasterKeyIn, vKeys[i]->second, vKeys[i]->first, key)) {
+                fAnyFail = true;
+                return;
+            }
+            fAnyPass = true;
+        }
+    };
+
+    // Every thread gets a contiguous range of keys and stops as soon as any thread found a key which does not decrypt
+    ctpl::thread_pool workerPool(nThreads);
+    RenameThreadPool(workerPool, "unlockcheck");
+    std::vector<std::future<void>> futures;
+    const size_t nChunkSize = (vKeys.size() + nThreads - 1) / nThreads;
+    for (size_t i = 0; i < vKeys.size(); i += nChunkSize) {
+        const size_t nEnd = std::min(i + nChunkSize, vKeys.size());
+        futures.emplace_back(workerPool.push([&checkRange, i, nEnd](int threadId) { checkRange(i, nEnd); }));
+    }
+    for (auto& f : futures) {
+        f.get();
+    }
+
+    keyPass = fAnyPass;
+    keyFail = fAnyFail;
+    LogPrintf("%s: checked %u encrypted keys in %dms using %d threads\n", __func__, vKeys.size(), GetTimeMillis() - nStart, nThreads);
+}
+
 bool CCryptoKeyStore::Unlock(const CKeyingMaterial& vMasterKeyIn, bool fForMixingOnly, bool accept_no_keys)
 {
     {
@@ -248,20 +294,24 @@ bool CCryptoKeyStore::Unlock(const CKeyingMaterial& vMasterKeyIn, bool fForMixin
 
         bool keyPass = mapCryptedKeys.empty(); // Always pass when there are no encrypted keys
         bool keyFail = false;
-        CryptedKeyMap::const_iterator mi = mapCryptedKeys.begin();
-        for (; mi != mapCryptedKeys.end(); ++mi)
-        {
-            const CPubKey &vchPubKey = (*mi).second.first;
-            const std::vector<unsigned char> &vchCryptedSecret = (*mi).second.second;
-            CKey key;
-            if (!DecryptKey(vMasterKeyIn, vchCryptedSecret, vchPubKey, key))
+        if (!fDecryptionThoroughlyChecked && mapCryptedKeys.size() >= UNLOCK_PARALLEL_CHECK_MIN_KEYS) {
+            CheckCryptedKeysParallel(vMasterKeyIn, keyPass, keyFail);
+        } else {
+            CryptedKeyMap::const_iterator mi = mapCryptedKeys.begin();
+            for (; mi != mapCryptedKeys.end(); ++mi)
             {
-                keyFail = true;
-                break;
+                const CPubKey &vchPubKey = (*mi).second.first;
+                const std::vector<unsigned char> &vchCryptedSecret = (*mi).second.second;
+                CKey key;
+                if (!DecryptKey(vMasterKeyIn, vchCryptedSecret, vchPubKey, key))
+                {
+                    keyFail = true;
+                    break;
+                }
+                keyPass = true;
+                if (fDecryptionThoroughlyChecked)
+                    break;
             }
-            keyPass = true;
-            if (fDecryptionThoroughlyChecked)
-                break;
         }
         if (keyPass && keyFail)
         {
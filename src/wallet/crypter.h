@@ -14,6 +14,11 @@ const unsigned int WALLET_CRYPTO_KEY_SIZE = 32;
 const unsigned int WALLET_CRYPTO_SALT_SIZE = 8;
 const unsigned int WALLET_CRYPTO_IV_SIZE = 16;
 
+//! Number of encrypted keys from which the first unlock checks them on multiple threads
+const size_t UNLOCK_PARALLEL_CHECK_MIN_KEYS = 1000;
+//! Maximum number of threads used to check the encrypted keys
+const int MAX_UNLOCK_CHECK_THREADS = 8;
+
 /**
  * Private key encryption is done based on a CMasterKey,
  * which holds a salt and random encryption key.
@@ -140,6 +145,8 @@ protected:
     bool SetCryptedHDChain(const CHDChain& chain);
 
     bool Unlock(const CKeyingMaterial& vMasterKeyIn, bool fForMixingOnly = false, bool accept_no_keys = false);
+    //! Decrypt and verify all encrypted keys, split across multiple threads
+    void CheckCryptedKeysParallel(const CKeyingMaterial& vMasterKeyIn, bool& keyPass, bool& keyFail) const EXCLUSIVE_LOCKS_REQUIRED(cs_KeyStore);
     CryptedKeyMap mapCryptedKeys GUARDED_BY(cs_KeyStore);
 
 public:
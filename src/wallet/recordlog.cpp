@@ -0,0 +1,823 @@
+// Copyright (c) 2026 The PirateCash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <wallet/recordlog.h>
+
+#include <clientversion.h>
+#include <crypto/common.h>
+#include <hash.h>
+#include <logging.h>
+#include <util/system.h>
+#include <util/translation.h>
+
+#include <cstring>
+#include <set>
+
+namespace {
+//! File header: 8 bytes of magic followed by the format version
+const char RECORDLOG_MAGIC[8] = {'P', 'I', 'R', 'W', 'A', 'L', 'O', 'G'};
+constexpr uint32_t RECORDLOG_VERSION = 1;
+constexpr size_t RECORDLOG_HEADER_SIZE = sizeof(RECORDLOG_MAGIC) + sizeof(uint32_t);
+
+//! Each frame is [payload size][payload][checksum of payload]
+constexpr size_t FRAME_OVERHEAD = 2 * sizeof(uint32_t);
+constexpr uint32_t MAX_FRAME_PAYLOAD_SIZE = 1024 * 1024 * 1024;
+//! Frames written during compaction are split at roughly this size
+constexpr size_t COMPACT_FRAME_SIZE = 1024 * 1024;
+//! Don't bother compacting files smaller than this
+constexpr uint64_t COMPACT_MIN_FILE_SIZE = 4 * 1024 * 1024;
+
+enum RecordType : uint8_t {
+    RECORD_PUT = 1,
+    RECORD_ERASE = 2,
+};
+
+using Record = std::pair<CSerializeData, std::optional<CSerializeData>>;
+
+Mutex cs_recordlogs;
+std::set<std::string> g_loaded_recordlogs GUARDED_BY(cs_recordlogs); //!< Wallet paths of all RecordLogDatabase instances
+
+uint32_t FrameChecksum(const CSerializeData& payload)
+{
+    uint256 hash = Hash(payload.begin(), payload.end());
+    return ReadLE32(hash.begin());
+}
+
+//! Serialize records into a frame payload. vecValueOffsets receives the offset of each value inside the payload.
+void BuildPayload(const std::vector<Record>& records, CSerializeData& payload, std::vector<size_t>& vecValueOffsets)
+{
+    CDataStream ss(SER_DISK, CLIENT_VERSION);
+    vecValueOffsets.clear();
+    for (const auto& record : records) {
+        ss << (uint8_t)(record.second ? RECORD_PUT : RECORD_ERASE);
+        WriteCompactSize(ss, record.first.size());
+        ss.write(record.first.data(), record.first.size());
+        if (record.second) {
+            WriteCompactSize(ss, record.second->size());
+            vecValueOffsets.emplace_back(ss.size());
+            ss.write(record.second->data(), record.second->size());
+        } else {
+            vecValueOffsets.emplace_back(0);
+        }
+    }
+    ss.GetAndClear(payload);
+}
+} // namespace
+
+bool IsRecordLogFile(const fs::path& path)
+{
+    if (!fs::is_regular_file(path)) return false;
+
+    fsbridge::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+
+    char magic[sizeof(RECORDLOG_MAGIC)];
+    file.read(magic, sizeof(magic));
+    return file.good() && memcmp(magic, RECORDLOG_MAGIC, sizeof(magic)) == 0;
+}
+
+bool IsRecordLogWalletPath(const fs::path& wallet_path)
+{
+    return fs::is_directory(wallet_path) && fs::exists(wallet_path / RECORDLOG_FILENAME);
+}
+
+bool IsRecordLogWalletLoaded(const fs::path& wallet_path)
+{
+    LOCK(cs_recordlogs);
+    return g_loaded_recordlogs.count(wallet_path.string()) != 0;
+}
+
+//
+// RecordLogDatabase
+//
+
+RecordLogDatabase::RecordLogDatabase(const fs::path& wallet_path) :
+    WalletDatabase(), m_dir_path(wallet_path), m_data_path(wallet_path / RECORDLOG_FILENAME)
+{
+    m_file_path = m_data_path.string();
+    LOCK(cs_recordlogs);
+    auto inserted = g_loaded_recordlogs.emplace(m_dir_path.string());
+    assert(inserted.second);
+}
+
+RecordLogDatabase::~RecordLogDatabase()
+{
+    {
+        LOCK(cs_log);
+        if (m_file) {
+            SyncFile();
+            CloseFile();
+        }
+    }
+    LOCK(cs_recordlogs);
+    g_loaded_recordlogs.erase(m_dir_path.string());
+}
+
+bool RecordLogDatabase::OpenFile(bool fCreate, std::string& strError)
+{
+    if (m_file) {
+        return true;
+    }
+
+    if (fCreate) {
+        TryCreateDirectories(m_dir_path);
+    }
+    if (!LockDirectory(m_dir_path, ".walletlock")) {
+        strError = strprintf("Cannot obtain a lock on wallet directory %s. Another instance of bitcoin may be using it.", m_dir_path.string());
+        return false;
+    }
+
+    bool fExists = fs::exists(m_data_path);
+    if (!fExists && !fCreate) {
+        UnlockDirectory(m_dir_path, ".walletlock");
+        strError = strprintf("Wallet file %s does not exist", m_data_path.string());
+        return false;
+    }
+
+    m_file = fsbridge::fopen(m_data_path, "a+b");
+    if (!m_file) {
+        UnlockDirectory(m_dir_path, ".walletlock");
+        strError = strprintf("Can't open wallet file %s", m_data_path.string());
+        return false;
+    }
+
+    m_index.clear();
+    m_live_bytes = 0;
+    m_file_size = 0;
+    m_dirty = false;
+
+    if (!fExists || fs::file_size(m_data_path) == 0) {
+        unsigned char header[RECORDLOG_HEADER_SIZE];
+        memcpy(header, RECORDLOG_MAGIC, sizeof(RECORDLOG_MAGIC));
+        WriteLE32(header + sizeof(RECORDLOG_MAGIC), RECORDLOG_VERSION);
+        if (fwrite(header, 1, sizeof(header), m_file) != sizeof(header) || fflush(m_file) != 0 || !FileCommit(m_file)) {
+            CloseFile();
+            strError = strprintf("Can't write to wallet file %s", m_data_path.string());
+            return false;
+        }
+        m_file_size = sizeof(header);
+        return true;
+    }
+
+    if (!ScanFile(strError)) {
+        CloseFile();
+        return false;
+    }
+    return true;
+}
+
+void RecordLogDatabase::CloseFile()
+{
+    if (!m_file) {
+        return;
+    }
+    fclose(m_file);
+    m_file = nullptr;
+    m_index.clear();
+    m_live_bytes = 0;
+    m_file_size = 0;
+    m_dirty = false;
+    UnlockDirectory(m_dir_path, ".walletlock");
+}
+
+bool RecordLogDatabase::ScanFile(std::string& strError)
+{
+    int64_t nStart = GetTimeMillis();
+    const uint64_t nFileSize = fs::file_size(m_data_path);
+
+    if (fseek(m_file, 0, SEEK_SET) != 0) {
+        strError = strprintf("Can't read wallet file %s", m_data_path.string());
+        return false;
+    }
+
+    unsigned char header[RECORDLOG_HEADER_SIZE];
+    if (fread(header, 1, sizeof(header), m_file) != sizeof(header) || memcmp(header, RECORDLOG_MAGIC, sizeof(RECORDLOG_MAGIC)) != 0) {
+        strError = strprintf("%s is not a wallet record log", m_data_path.string());
+        return false;
+    }
+    if (ReadLE32(header + sizeof(RECORDLOG_MAGIC)) > RECORDLOG_VERSION) {
+        strError = strprintf("%s was written by a newer version", m_data_path.string());
+        return false;
+    }
+
+    uint64_t nPos = RECORDLOG_HEADER_SIZE;
+    size_t nFrames = 0;
+    CSerializeData payload;
+    while (nPos < nFileSize) {
+        // Every append writes a single frame, so an interrupted write leaves a partial frame which reaches up to the
+        // end of the file. Only such a tail is discarded, as is a complete frame with a bad checksum if it's the last
+        // one. Anything else is corruption.
+        unsigned char buf[sizeof(uint32_t)];
+        if (nFileSize - nPos < FRAME_OVERHEAD) {
+            break;
+        }
+        if (fread(buf, 1, sizeof(buf), m_file) != sizeof(buf)) {
+            strError = strprintf("Error reading wallet file %s", m_data_path.string());
+            return false;
+        }
+        const uint32_t nPayloadSize = ReadLE32(buf);
+        if (nPayloadSize > MAX_FRAME_PAYLOAD_SIZE) {
+            // never written by AppendRecords, so this can't be a torn append
+            strError = strprintf("%s corrupt at position %d: frame too large", m_data_path.string(), nPos);
+            return false;
+        }
+        if (nFileSize - nPos - FRAME_OVERHEAD < nPayloadSize) {
+            break;
+        }
+        payload.resize(nPayloadSize);
+        if (fread(payload.data(), 1, nPayloadSize, m_file) != nPayloadSize || fread(buf, 1, sizeof(buf), m_file) != sizeof(buf)) {
+            strError = strprintf("Error reading wallet file %s", m_data_path.string());
+            return false;
+        }
+        const uint64_t nFrameEnd = nPos + FRAME_OVERHEAD + nPayloadSize;
+        if (FrameChecksum(payload) != ReadLE32(buf)) {
+            if (nFrameEnd == nFileSize) {
+                break;
+            }
+            strError = strprintf("%s corrupt, bad checksum at position %d", m_data_path.string(), nPos);
+            return false;
+        }
+
+        try {
+            CDataStream ss(payload.begin(), payload.end(), SER_DISK, CLIENT_VERSION);
+            while (!ss.empty()) {
+                uint8_t nType;
+                ss >> nType;
+                CSerializeData key(ReadCompactSize(ss));
+                ss.read(key.data(), key.size());
+                auto it = m_index.find(key);
+                if (it != m_index.end()) {
+                    m_live_bytes -= it->first.size() + it->second.nSize;
+                }
+                if (nType == RECORD_PUT) {
+                    const uint64_t nSize = ReadCompactSize(ss);
+                    if (nSize > ss.size()) {
+                        throw std::ios_base::failure("value out of bounds");
+                    }
+                    const uint64_t nValuePos = nPos + sizeof(uint32_t) + (nPayloadSize - ss.size());
+                    ss.ignore(nSize);
+                    if (it == m_index.end()) {
+                        it = m_index.emplace(std::move(key), IndexEntry{}).first;
+                    }
+                    it->second = IndexEntry{nValuePos, (uint32_t)nSize};
+                    m_live_bytes += it->first.size() + nSize;
+                } else if (nType == RECORD_ERASE) {
+                    if (it != m_index.end()) {
+                        m_index.erase(it);
+                    }
+                } else {
+                    throw std::ios_base::failure("unknown record type");
+                }
+            }
+        } catch (const std::exception& e) {
+            strError = strprintf("%s corrupt at position %d: %s", m_data_path.string(), nPos, e.what());
+            return false;
+        }
+
+        nPos = nFrameEnd;
+        nFrames++;
+    }
+
+    if (nPos < nFileSize) {
+        LogPrintf("RecordLogDatabase: Discarding %d bytes of an incomplete write at the end of %s\n", nFileSize - nPos, m_data_path.string());
+        if (!TruncateFile(m_file, nPos) || !FileCommit(m_file)) {
+            strError = strprintf("Can't truncate wallet file %s", m_data_path.string());
+            return false;
+        }
+    }
+    m_file_size = nPos;
+
+    LogPrint(BCLog::WALLETDB, "RecordLogDatabase: Scanned %s, %d frames, %d keys, %d/%d live bytes, %dms\n",
+        m_data_path.string(), nFrames, m_index.size(), m_live_bytes, m_file_size, GetTimeMillis() - nStart);
+    return true;
+}
+
+bool RecordLogDatabase::SyncFile()
+{
+    if (!m_file || !m_dirty) {
+        return true;
+    }
+    if (!FileCommit(m_file)) {
+        return false;
+    }
+    m_dirty = false;
+    return true;
+}
+
+bool RecordLogDatabase::ShouldCompact() const
+{
+    // Compact when at least half of the file consists of superseded records
+    return m_file && m_file_size >= COMPACT_MIN_FILE_SIZE && m_live_bytes * 2 < m_file_size;
+}
+
+bool RecordLogDatabase::AppendRecords(const std::vector<Record>& records)
+{
+    if (!m_file) {
+        return false;
+    }
+    if (records.empty()) {
+        return true;
+    }
+
+    CSerializeData payload;
+    std::vector<size_t> vecValueOffsets;
+    BuildPayload(records, payload, vecValueOffsets);
+    if (payload.size() > MAX_FRAME_PAYLOAD_SIZE) {
+        return false;
+    }
+
+    unsigned char header[sizeof(uint32_t)];
+    unsigned char checksum[sizeof(uint32_t)];
+    WriteLE32(header, payload.size());
+    WriteLE32(checksum, FrameChecksum(payload));
+
+    // The file is opened in append mode, but switching from reading to writing still requires a seek
+    bool fOk = fseek(m_file, 0, SEEK_END) == 0 &&
+               fwrite(header, 1, sizeof(header), m_file) == sizeof(header) &&
+               fwrite(payload.data(), 1, payload.size(), m_file) == payload.size() &&
+               fwrite(checksum, 1, sizeof(checksum), m_file) == sizeof(checksum) &&
+               fflush(m_file) == 0;
+    if (!fOk) {
+        LogPrintf("RecordLogDatabase: Error writing to %s\n", m_data_path.string());
+        // don't leave a partial frame behind, later frames would make it look like corruption
+        TruncateFile(m_file, m_file_size);
+        return false;
+    }
+
+    const uint64_t nPayloadPos = m_file_size + sizeof(uint32_t);
+    for (size_t i = 0; i < records.size(); i++) {
+        const auto& record = records[i];
+        auto it = m_index.find(record.first);
+        if (it != m_index.end()) {
+            m_live_bytes -= it->first.size() + it->second.nSize;
+        }
+        if (record.second) {
+            if (it == m_index.end()) {
+                it = m_index.emplace(record.first, IndexEntry{}).first;
+            }
+            it->second = IndexEntry{nPayloadPos + vecValueOffsets[i], (uint32_t)record.second->size()};
+            m_live_bytes += it->first.size() + it->second.nSize;
+        } else if (it != m_index.end()) {
+            m_index.erase(it);
+        }
+    }
+    m_file_size += FRAME_OVERHEAD + payload.size();
+    m_dirty = true;
+    return true;
+}
+
+bool RecordLogDatabase::ReadValue(const IndexEntry& entry, CDataStream& value) const
+{
+    CSerializeData buf(entry.nSize);
+    if (fseek(m_file, entry.nPos, SEEK_SET) != 0 || fread(buf.data(), 1, buf.size(), m_file) != buf.size()) {
+        LogPrintf("RecordLogDatabase: Error reading from %s\n", m_data_path.string());
+        return false;
+    }
+    value.write(buf.data(), buf.size());
+    return true;
+}
+
+bool RecordLogDatabase::Compact(const char* pszSkip, bool fUpdateVersion)
+{
+    int64_t nStart = GetTimeMillis();
+    const fs::path tmp_path = m_dir_path / (RECORDLOG_FILENAME + ".compact");
+    const uint64_t nOldSize = m_file_size;
+
+    FILE* file = fsbridge::fopen(tmp_path, "wb");
+    if (!file) {
+        LogPrintf("RecordLogDatabase::Compact: Can't create %s\n", tmp_path.string());
+        return false;
+    }
+
+    unsigned char header[RECORDLOG_HEADER_SIZE];
+    memcpy(header, RECORDLOG_MAGIC, sizeof(RECORDLOG_MAGIC));
+    WriteLE32(header + sizeof(RECORDLOG_MAGIC), RECORDLOG_VERSION);
+    bool fOk = fwrite(header, 1, sizeof(header), file) == sizeof(header);
+
+    std::map<CSerializeData, IndexEntry> newIndex;
+    uint64_t nNewSize = sizeof(header);
+    uint64_t nNewLiveBytes = 0;
+
+    std::vector<Record> records;
+    size_t nFrameBytes = 0;
+    auto writeFrame = [&]() {
+        CSerializeData payload;
+        std::vector<size_t> vecValueOffsets;
+        BuildPayload(records, payload, vecValueOffsets);
+        unsigned char buf[sizeof(uint32_t)];
+        WriteLE32(buf, payload.size());
+        fOk = fOk && fwrite(buf, 1, sizeof(buf), file) == sizeof(buf);
+        fOk = fOk && fwrite(payload.data(), 1, payload.size(), file) == payload.size();
+        WriteLE32(buf, FrameChecksum(payload));
+        fOk = fOk && fwrite(buf, 1, sizeof(buf), file) == sizeof(buf);
+        for (size_t i = 0; i < records.size(); i++) {
+            const uint32_t nSize = records[i].second->size();
+            nNewLiveBytes += records[i].first.size() + nSize;
+            newIndex.emplace(std::move(records[i].first), IndexEntry{nNewSize + sizeof(uint32_t) + vecValueOffsets[i], nSize});
+        }
+        nNewSize += FRAME_OVERHEAD + payload.size();
+        records.clear();
+        nFrameBytes = 0;
+    };
+
+    for (const auto& p : m_index) {
+        if (!fOk) break;
+        const auto& key = p.first;
+        if (pszSkip && strncmp(key.data(), pszSkip, std::min(key.size(), strlen(pszSkip))) == 0) {
+            continue;
+        }
+        CDataStream ssValue(SER_DISK, CLIENT_VERSION);
+        if (fUpdateVersion && key.size() == 8 && memcmp(key.data(), "\x07version", 8) == 0) {
+            ssValue << CLIENT_VERSION;
+        } else if (!ReadValue(p.second, ssValue)) {
+            fOk = false;
+            break;
+        }
+        nFrameBytes += key.size() + ssValue.size();
+        records.emplace_back(key, CSerializeData(ssValue.begin(), ssValue.end()));
+        if (nFrameBytes >= COMPACT_FRAME_SIZE) {
+            writeFrame();
+        }
+    }
+    if (fOk && !records.empty()) {
+        writeFrame();
+    }
+
+    fOk = fOk && fflush(file) == 0 && FileCommit(file);
+    fclose(file);
+    if (!fOk) {
+        LogPrintf("RecordLogDatabase::Compact: Failed to write %s\n", tmp_path.string());
+        fs::remove(tmp_path);
+        return false;
+    }
+
+    // Replace the data file. The old file must be closed first for this to work on Windows, keep the directory
+    // locked while doing so.
+    fclose(m_file);
+    m_file = nullptr;
+    if (!RenameOver(tmp_path, m_data_path)) {
+        LogPrintf("RecordLogDatabase::Compact: Failed to rename %s\n", tmp_path.string());
+        fs::remove(tmp_path);
+        m_file = fsbridge::fopen(m_data_path, "a+b");
+        return false;
+    }
+    m_file = fsbridge::fopen(m_data_path, "a+b");
+    if (!m_file) {
+        throw std::runtime_error(strprintf("RecordLogDatabase: Can't reopen %s after compaction", m_data_path.string()));
+    }
+    m_index = std::move(newIndex);
+    m_file_size = nNewSize;
+    m_live_bytes = nNewLiveBytes;
+    m_dirty = false;
+
+    LogPrint(BCLog::WALLETDB, "RecordLogDatabase::Compact: %s compacted from %d to %d bytes, %dms\n",
+        m_data_path.string(), nOldSize, nNewSize, GetTimeMillis() - nStart);
+    return true;
+}
+
+void RecordLogDatabase::Open(const char* mode)
+{
+    LOCK(cs_log);
+    std::string strError;
+    if (!OpenFile(strchr(mode, 'c') != nullptr, strError)) {
+        throw std::runtime_error(strprintf("RecordLogDatabase: %s", strError));
+    }
+}
+
+void RecordLogDatabase::AddRef()
+{
+    ++m_refcount;
+}
+
+void RecordLogDatabase::RemoveRef()
+{
+    --m_refcount;
+}
+
+bool RecordLogDatabase::Rewrite(const char* pszSkip)
+{
+    LOCK(cs_log);
+    if (!m_file) {
+        std::string strError;
+        if (!OpenFile(false, strError)) {
+            LogPrintf("RecordLogDatabase::Rewrite: %s\n", strError);
+            return false;
+        }
+    }
+    LogPrintf("RecordLogDatabase::Rewrite: Rewriting %s...\n", m_data_path.string());
+    return Compact(pszSkip, true);
+}
+
+bool RecordLogDatabase::Backup(const std::string& strDest) const
+{
+    // Every frame is flushed to the OS when it's written, so the copy sees all of them even if they are not synced yet
+    LOCK(cs_log);
+    fs::path pathDest(strDest);
+    if (fs::is_directory(pathDest))
+        pathDest /= RECORDLOG_FILENAME;
+
+    try {
+        if (fs::exists(pathDest) && fs::equivalent(m_data_path, pathDest)) {
+            LogPrintf("cannot backup to wallet source file %s\n", pathDest.string());
+            return false;
+        }
+
+        fs::copy_file(m_data_path, pathDest, fs::copy_option::overwrite_if_exists);
+        LogPrintf("copied %s to %s\n", m_data_path.string(), pathDest.string());
+        return true;
+    } catch (const fs::filesystem_error& e) {
+        LogPrintf("error copying %s to %s - %s\n", m_data_path.string(), pathDest.string(), fsbridge::get_filesystem_error_message(e));
+        return false;
+    }
+}
+
+void RecordLogDatabase::Flush()
+{
+    LOCK(cs_log);
+    SyncFile();
+}
+
+void RecordLogDatabase::Close()
+{
+    LOCK(cs_log);
+    if (!m_file) {
+        return;
+    }
+    SyncFile();
+    if (m_refcount == 0 && ShouldCompact()) {
+        Compact(nullptr, false);
+    }
+    CloseFile();
+}
+
+bool RecordLogDatabase::PeriodicFlush()
+{
+    // Don't flush if we can't acquire the lock or if the database is in use
+    TRY_LOCK(cs_log, lockLog);
+    if (!lockLog || m_refcount > 0) return false;
+
+    if (!m_dirty && !ShouldCompact()) return false;
+
+    LogPrint(BCLog::WALLETDB, "Flushing %s\n", m_data_path.string());
+    int64_t nStart = GetTimeMillis();
+
+    if (!SyncFile()) return false;
+    if (ShouldCompact()) {
+        Compact(nullptr, false);
+    }
+
+    LogPrint(BCLog::WALLETDB, "Flushed %s %dms\n", m_data_path.string(), GetTimeMillis() - nStart);
+    return true;
+}
+
+void RecordLogDatabase::IncrementUpdateCounter()
+{
+    ++nUpdateCounter;
+}
+
+bool RecordLogDatabase::Verify(bilingual_str& errorStr)
+{
+    LogPrintf("Using wallet %s\n", m_data_path.string());
+
+    if (!fs::exists(m_data_path)) {
+        // also return true if files does not exists
+        return true;
+    }
+
+    LOCK(cs_log);
+    std::string strError;
+    if (!OpenFile(false, strError)) {
+        errorStr = strprintf(_("Error loading wallet %s: %s"), m_data_path.string(), strError);
+        return false;
+    }
+    return true;
+}
+
+std::unique_ptr<DatabaseBatch> RecordLogDatabase::MakeBatch(const char* mode, bool flush_on_close)
+{
+    return MakeUnique<RecordLogBatch>(*this, mode, flush_on_close);
+}
+
+//
+// RecordLogBatch
+//
+
+RecordLogBatch::RecordLogBatch(RecordLogDatabase& database, const char* pszMode, bool fFlushOnCloseIn) :
+    m_database(database)
+{
+    fReadOnly = (!strchr(pszMode, '+') && !strchr(pszMode, 'w'));
+    fFlushOnClose = fFlushOnCloseIn;
+    bool fCreate = strchr(pszMode, 'c') != nullptr;
+
+    {
+        LOCK(m_database.cs_log);
+        if (!m_database.m_file) {
+            std::string strError;
+            if (!m_database.OpenFile(fCreate, strError)) {
+                throw std::runtime_error(strprintf("RecordLogBatch: %s", strError));
+            }
+            if (fCreate && m_database.m_index.empty()) {
+                CDataStream ssKey(SER_DISK, CLIENT_VERSION);
+                ssKey << std::string("version");
+                CDataStream ssValue(SER_DISK, CLIENT_VERSION);
+                ssValue << CLIENT_VERSION;
+                m_database.AppendRecords({{CSerializeData(ssKey.begin(), ssKey.end()), CSerializeData(ssValue.begin(), ssValue.end())}});
+            }
+        }
+    }
+    m_database.AddRef();
+    m_open = true;
+}
+
+void RecordLogBatch::Flush()
+{
+    if (m_txn_active)
+        return;
+    if (!fReadOnly)
+        m_database.Flush();
+}
+
+void RecordLogBatch::Close()
+{
+    if (!m_open)
+        return;
+    TxnAbort();
+    CloseCursor();
+
+    if (fFlushOnClose)
+        Flush();
+
+    m_open = false;
+    m_database.RemoveRef();
+}
+
+bool RecordLogBatch::ReadKey(CDataStream&& key, CDataStream& value)
+{
+    if (!m_open)
+        return false;
+
+    CSerializeData k(key.begin(), key.end());
+    if (m_txn_active) {
+        auto it = m_txn_view.find(k);
+        if (it != m_txn_view.end()) {
+            if (!it->second) return false;
+            value.write(it->second->data(), it->second->size());
+            return true;
+        }
+    }
+
+    LOCK(m_database.cs_log);
+    if (!m_database.m_file)
+        return false;
+    auto it = m_database.m_index.find(k);
+    if (it == m_database.m_index.end())
+        return false;
+    return m_database.ReadValue(it->second, value);
+}
+
+bool RecordLogBatch::WriteKey(CDataStream&& key, CDataStream&& value, bool overwrite)
+{
+    if (!m_open)
+        return false;
+    if (fReadOnly)
+        assert(!"Write called on database in read-only mode");
+
+    CSerializeData k(key.begin(), key.end());
+    if (!overwrite && HasKey(std::move(key)))
+        return false;
+
+    Record record{std::move(k), CSerializeData(value.begin(), value.end())};
+    if (m_txn_active) {
+        m_txn_view[record.first] = record.second;
+        m_txn_records.emplace_back(std::move(record));
+        return true;
+    }
+
+    LOCK(m_database.cs_log);
+    return m_database.AppendRecords({record});
+}
+
+bool RecordLogBatch::EraseKey(CDataStream&& key)
+{
+    if (!m_open)
+        return false;
+    if (fReadOnly)
+        assert(!"Erase called on database in read-only mode");
+
+    Record record{CSerializeData(key.begin(), key.end()), std::nullopt};
+    if (m_txn_active) {
+        m_txn_view[record.first] = std::nullopt;
+        m_txn_records.emplace_back(std::move(record));
+        return true;
+    }
+
+    LOCK(m_database.cs_log);
+    if (m_database.m_index.count(record.first) == 0) {
+        // nothing to erase, don't grow the log
+        return true;
+    }
+    return m_database.AppendRecords({record});
+}
+
+bool RecordLogBatch::HasKey(CDataStream&& key)
+{
+    if (!m_open)
+        return false;
+
+    CSerializeData k(key.begin(), key.end());
+    if (m_txn_active) {
+        auto it = m_txn_view.find(k);
+        if (it != m_txn_view.end()) {
+            return it->second.has_value();
+        }
+    }
+
+    LOCK(m_database.cs_log);
+    return m_database.m_index.count(k) != 0;
+}
+
+bool RecordLogBatch::StartCursor()
+{
+    assert(!m_cursor_active);
+    if (!m_open)
+        return false;
+
+    LOCK(m_database.cs_log);
+    if (!m_database.m_file)
+        return false;
+    m_cursor_keys.clear();
+    m_cursor_keys.reserve(m_database.m_index.size());
+    for (const auto& p : m_database.m_index) {
+        m_cursor_keys.emplace_back(p.first);
+    }
+    m_cursor_pos = 0;
+    m_cursor_active = true;
+    return true;
+}
+
+bool RecordLogBatch::ReadAtCursor(CDataStream& ssKey, CDataStream& ssValue, bool& complete)
+{
+    complete = false;
+    if (!m_cursor_active) return false;
+
+    LOCK(m_database.cs_log);
+    while (m_cursor_pos < m_cursor_keys.size()) {
+        const auto& key = m_cursor_keys[m_cursor_pos++];
+        auto it = m_database.m_index.find(key);
+        if (it == m_database.m_index.end()) {
+            // erased after the cursor was started
+            continue;
+        }
+
+        // Convert to streams
+        ssKey.SetType(SER_DISK);
+        ssKey.clear();
+        ssKey.write(key.data(), key.size());
+        ssValue.SetType(SER_DISK);
+        ssValue.clear();
+        return m_database.ReadValue(it->second, ssValue);
+    }
+    complete = true;
+    return false;
+}
+
+void RecordLogBatch::CloseCursor()
+{
+    m_cursor_keys.clear();
+    m_cursor_pos = 0;
+    m_cursor_active = false;
+}
+
+bool RecordLogBatch::TxnBegin()
+{
+    if (!m_open || m_txn_active)
+        return false;
+    m_txn_active = true;
+    return true;
+}
+
+bool RecordLogBatch::TxnCommit()
+{
+    if (!m_open || !m_txn_active)
+        return false;
+    bool ret;
+    {
+        LOCK(m_database.cs_log);
+        ret = m_database.AppendRecords(m_txn_records);
+    }
+    m_txn_records.clear();
+    m_txn_view.clear();
+    m_txn_active = false;
+    return ret;
+}
+
+bool RecordLogBatch::TxnAbort()
+{
+    if (!m_open || !m_txn_active)
+        return false;
+    m_txn_records.clear();
+    m_txn_view.clear();
+    m_txn_active = false;
+    return true;
+}
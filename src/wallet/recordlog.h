@@ -0,0 +1,153 @@
+// Copyright (c) 2026 The PirateCash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_WALLET_RECORDLOG_H
+#define BITCOIN_WALLET_RECORDLOG_H
+
+#include <fs.h>
+#include <streams.h>
+#include <sync.h>
+#include <wallet/db.h>
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+struct bilingual_str;
+
+/** Name of the data file of a record log wallet inside the wallet directory */
+static const std::string RECORDLOG_FILENAME = "walletlog.dat";
+/** Supported values of -walletformat */
+static const std::string WALLET_FORMAT_BDB = "bdb";
+static const std::string WALLET_FORMAT_RECORDLOG = "log";
+static const std::string DEFAULT_WALLET_FORMAT = WALLET_FORMAT_BDB;
+
+/** Return whether wallet_path is a wallet directory holding a record log wallet */
+bool IsRecordLogWalletPath(const fs::path& wallet_path);
+/** Return whether a record log wallet database is currently loaded. */
+bool IsRecordLogWalletLoaded(const fs::path& wallet_path);
+/** Return whether the file starts with the record log magic */
+bool IsRecordLogFile(const fs::path& path);
+
+class RecordLogBatch;
+
+/**
+ * Append-only wallet database.
+ *
+ * The data file is a header followed by a sequence of frames. Each frame holds one or more put/erase records and is
+ * protected by a checksum, a transaction is written as a single frame so it's applied completely or not at all. An
+ * in-memory index maps each live key to the position of its value in the file. Loading the wallet is a single
+ * sequential scan of the file, and writes never modify existing data. Superseded records are dropped by compacting
+ * the file when they make up most of it.
+ **/
+class RecordLogDatabase : public WalletDatabase
+{
+    friend class RecordLogBatch;
+
+public:
+    //! Position of a value inside the data file
+    struct IndexEntry {
+        uint64_t nPos;
+        uint32_t nSize;
+    };
+
+    RecordLogDatabase() = delete;
+    /** Create DB handle for the wallet directory wallet_path */
+    explicit RecordLogDatabase(const fs::path& wallet_path);
+    ~RecordLogDatabase() override;
+
+    /** Open the data file, creating it if mode contains 'c' */
+    void Open(const char* mode) override;
+
+    void AddRef() override;
+    void RemoveRef() override;
+
+    /** Compact the data file, dropping all keys starting with pszSkip if non-zero */
+    bool Rewrite(const char* pszSkip=nullptr) override;
+
+    bool Backup(const std::string& strDest) const override;
+
+    /** Sync the data file to disk */
+    void Flush() override;
+    /** Sync, compact if worthwhile and close the data file */
+    void Close() override;
+    /** Sync and possibly compact the data file if it is not in use (TRY_LOCK) */
+    bool PeriodicFlush() override;
+
+    void IncrementUpdateCounter() override;
+
+    void ReloadDbEnv() override {}
+
+    /** Verifies the data file by scanning it completely */
+    bool Verify(bilingual_str& error) override;
+
+    std::unique_ptr<DatabaseBatch> MakeBatch(const char* mode = "r+", bool flush_on_close = true) override;
+
+private:
+    const fs::path m_dir_path;
+    const fs::path m_data_path;
+
+    mutable Mutex cs_log;
+    FILE* m_file GUARDED_BY(cs_log){nullptr};
+    std::map<CSerializeData, IndexEntry> m_index GUARDED_BY(cs_log);
+    //! Size of the data file and the number of bytes in it which are still referenced by the index
+    uint64_t m_file_size GUARDED_BY(cs_log){0};
+    uint64_t m_live_bytes GUARDED_BY(cs_log){0};
+    //! Whether there were writes since the last sync
+    bool m_dirty GUARDED_BY(cs_log){false};
+
+    bool OpenFile(bool fCreate, std::string& strError) EXCLUSIVE_LOCKS_REQUIRED(cs_log);
+    void CloseFile() EXCLUSIVE_LOCKS_REQUIRED(cs_log);
+    bool ScanFile(std::string& strError) EXCLUSIVE_LOCKS_REQUIRED(cs_log);
+    bool SyncFile() EXCLUSIVE_LOCKS_REQUIRED(cs_log);
+    bool ShouldCompact() const EXCLUSIVE_LOCKS_REQUIRED(cs_log);
+    bool Compact(const char* pszSkip, bool fUpdateVersion) EXCLUSIVE_LOCKS_REQUIRED(cs_log);
+
+    //! Append one frame of records. A nullopt value erases the key.
+    bool AppendRecords(const std::vector<std::pair<CSerializeData, std::optional<CSerializeData>>>& records) EXCLUSIVE_LOCKS_REQUIRED(cs_log);
+    bool ReadValue(const IndexEntry& entry, CDataStream& value) const EXCLUSIVE_LOCKS_REQUIRED(cs_log);
+};
+
+/** RAII class that provides access to a RecordLogDatabase */
+class RecordLogBatch : public DatabaseBatch
+{
+private:
+    RecordLogDatabase& m_database;
+    bool fReadOnly;
+    bool fFlushOnClose;
+    bool m_open{false};
+
+    //! Records written inside the active transaction, in order, and the latest value of each of them for reads
+    bool m_txn_active{false};
+    std::vector<std::pair<CSerializeData, std::optional<CSerializeData>>> m_txn_records;
+    std::map<CSerializeData, std::optional<CSerializeData>> m_txn_view;
+
+    //! Keys to visit, taken when the cursor was started
+    std::vector<CSerializeData> m_cursor_keys;
+    size_t m_cursor_pos{0};
+    bool m_cursor_active{false};
+
+    bool ReadKey(CDataStream&& key, CDataStream& value) override;
+    bool WriteKey(CDataStream&& key, CDataStream&& value, bool overwrite = true) override;
+    bool EraseKey(CDataStream&& key) override;
+    bool HasKey(CDataStream&& key) override;
+
+public:
+    explicit RecordLogBatch(RecordLogDatabase& database, const char* pszMode = "r+", bool fFlushOnCloseIn=true);
+    ~RecordLogBatch() override { Close(); }
+
+    void Flush() override;
+    void Close() override;
+
+    bool StartCursor() override;
+    bool ReadAtCursor(CDataStream& ssKey, CDataStream& ssValue, bool& complete) override;
+    void CloseCursor() override;
+    bool TxnBegin() override;
+    bool TxnCommit() override;
+    bool TxnAbort() override;
+};
+
+#endif // BITCOIN_WALLET_RECORDLOG_H
@@ -15,6 +15,7 @@
 #include <node/transaction.h>
 #include <policy/feerate.h>
 #include <policy/fees.h>
+#include <rpc/jsonstream.h>
 #include <rpc/mining.h>
 #include <rpc/rawtransaction_util.h>
 #include <rpc/server.h>
@@ -32,6 +33,7 @@
 #include <validation.h>
 #include <wallet/coincontrol.h>
 #include <wallet/psbtwallet.h>
+#include <wallet/recordlog.h>
 #include <wallet/rpcwallet.h>
 #include <wallet/wallet.h>
 #include <wallet/walletdb.h>
@@ -1509,10 +1511,15 @@ static UniValue listtransactions(const JSONRPCRequest& request)
     if ((nFrom + nCount) > (int)ret.size())
         nCount = ret.size() - nFrom;
 
-    const std::vector<UniValue>& txs = ret.getValues();
-    UniValue result{UniValue::VARR};
-    result.push_backV({ txs.rend() - nFrom - nCount, txs.rend() - nFrom }); // Return oldest to newest
-    return result;
+    return StreamRPCResult(request, [&](JSONStreamWriter& writer) {
+        const std::vector<UniValue>& txs = ret.getValues();
+        writer.BeginArray();
+        // Return oldest to newest
+        for (auto it = txs.rend() - nFrom - nCount; it != txs.rend() - nFrom; ++it) {
+            writer.Value(*it);
+        }
+        writer.EndArray();
+    });
 }
 
 static UniValue listsinceblock(const JSONRPCRequest& request)
@@ -2771,9 +2778,9 @@ static UniValue loadwallet(const JSONRPCRequest& request)
     if (!location.Exists()) {
         throw JSONRPCError(RPC_WALLET_NOT_FOUND, "Wallet " + location.GetName() + " not found.");
     } else if (fs::is_directory(location.GetPath())) {
-        // The given filename is a directory. Check that there's a wallet.dat file.
+        // The given filename is a directory. Check that there's a wallet.dat or a record log file.
         fs::path wallet_dat_file = location.GetPath() / "wallet.dat";
-        if (fs::symlink_status(wallet_dat_file).type() == fs::file_not_found) {
+        if (fs::symlink_status(wallet_dat_file).type() == fs::file_not_found && !IsRecordLogWalletPath(location.GetPath())) {
             throw JSONRPCError(RPC_WALLET_NOT_FOUND, "Directory " + location.GetName() + " does not contain a wallet.dat file.");
         }
     }
@@ -0,0 +1,200 @@
+// Copyright (c) 2026 The PirateCash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <clientversion.h>
+#include <fs.h>
+#include <test/util/setup_common.h>
+#include <util/translation.h>
+#include <wallet/recordlog.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <string>
+
+BOOST_FIXTURE_TEST_SUITE(recordlog_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(recordlog_read_write)
+{
+    const fs::path wallet_path = GetDataDir() / "recordlog_rw";
+    {
+        RecordLogDatabase db(wallet_path);
+        BOOST_CHECK(IsRecordLogWalletLoaded(wallet_path));
+        auto batch = db.MakeBatch("cr+");
+        BOOST_CHECK(batch->Write(std::string("a"), 1));
+        BOOST_CHECK(batch->Write(std::string("b"), 2));
+        BOOST_CHECK(!batch->Write(std::string("b"), 3, false));
+        BOOST_CHECK(batch->Write(std::string("b"), 4));
+        BOOST_CHECK(batch->Erase(std::string("a")));
+
+        // transactions are only visible after commit, and aborted ones are dropped
+        BOOST_CHECK(batch->TxnBegin());
+        BOOST_CHECK(batch->Write(std::string("c"), 5));
+        BOOST_CHECK(batch->TxnAbort());
+        BOOST_CHECK(!batch->Exists(std::string("c")));
+        BOOST_CHECK(batch->TxnBegin());
+        BOOST_CHECK(batch->Write(std::string("d"), 6));
+        int value = 0;
+        BOOST_CHECK(batch->Read(std::string("d"), value));
+        BOOST_CHECK_EQUAL(value, 6);
+        BOOST_CHECK(batch->TxnCommit());
+    }
+    BOOST_CHECK(!IsRecordLogWalletLoaded(wallet_path));
+    BOOST_CHECK(IsRecordLogWalletPath(wallet_path));
+    BOOST_CHECK(IsRecordLogFile(wallet_path / RECORDLOG_FILENAME));
+
+    // everything is recovered by scanning the file
+    RecordLogDatabase db(wallet_path);
+    bilingual_str error;
+    BOOST_CHECK(db.Verify(error));
+    auto batch = db.MakeBatch("r");
+    int value = 0;
+    BOOST_CHECK(!batch->Exists(std::string("a")));
+    BOOST_CHECK(batch->Read(std::string("b"), value));
+    BOOST_CHECK_EQUAL(value, 4);
+    BOOST_CHECK(!batch->Exists(std::string("c")));
+    BOOST_CHECK(batch->Read(std::string("d"), value));
+    BOOST_CHECK_EQUAL(value, 6);
+    BOOST_CHECK(batch->Exists(std::string("version")));
+
+    // cursor visits all live keys in key order
+    BOOST_CHECK(batch->StartCursor());
+    std::vector<std::string> keys;
+    while (true) {
+        CDataStream ssKey(SER_DISK, CLIENT_VERSION);
+        CDataStream ssValue(SER_DISK, CLIENT_VERSION);
+        bool complete;
+        bool ret = batch->ReadAtCursor(ssKey, ssValue, complete);
+        if (complete) break;
+        BOOST_CHECK(ret);
+        std::string key;
+        ssKey >> key;
+        keys.emplace_back(key);
+    }
+    batch->CloseCursor();
+    BOOST_CHECK(keys == std::vector<std::string>({"b", "d", "version"}));
+}
+
+BOOST_AUTO_TEST_CASE(recordlog_torn_write)
+{
+    const fs::path wallet_path = GetDataDir() / "recordlog_torn";
+    {
+        RecordLogDatabase db(wallet_path);
+        auto batch = db.MakeBatch("cr+");
+        BOOST_CHECK(batch->Write(std::string("a"), 1));
+    }
+
+    // simulate a write which was interrupted half way through a frame
+    const fs::path file_path = wallet_path / RECORDLOG_FILENAME;
+    const uint64_t size = fs::file_size(file_path);
+    FILE* file = fsbridge::fopen(file_path, "ab");
+    const unsigned char partial[] = {0x20, 0x00, 0x00, 0x00, 0x01, 0x02};
+    fwrite(partial, 1, sizeof(partial), file);
+    fclose(file);
+
+    RecordLogDatabase db(wallet_path);
+    bilingual_str error;
+    BOOST_CHECK(db.Verify(error));
+    BOOST_CHECK_EQUAL(fs::file_size(file_path), size);
+    auto batch = db.MakeBatch("r+");
+    int value = 0;
+    BOOST_CHECK(batch->Read(std::string("a"), value));
+    BOOST_CHECK_EQUAL(value, 1);
+    BOOST_CHECK(batch->Write(std::string("b"), 2));
+}
+
+BOOST_AUTO_TEST_CASE(recordlog_corrupt_length)
+{
+    const fs::path wallet_path = GetDataDir() / "recordlog_corrupt";
+    const fs::path file_path = wallet_path / RECORDLOG_FILENAME;
+    uint64_t frame_pos;
+    {
+        RecordLogDatabase db(wallet_path);
+        auto batch = db.MakeBatch("cr+");
+        BOOST_CHECK(batch->Write(std::string("a"), 1));
+        frame_pos = fs::file_size(file_path);
+        BOOST_CHECK(batch->Write(std::string("b"), 2));
+        BOOST_CHECK(batch->Write(std::string("c"), 3));
+    }
+    const uint64_t size = fs::file_size(file_path);
+
+    // a length which no append can have written is corruption, even though the frame runs past the end of the file
+    FILE* file = fsbridge::fopen(file_path, "rb+");
+    const unsigned char length[] = {0xff, 0xff, 0xff, 0xff};
+    fseek(file, frame_pos, SEEK_SET);
+    fwrite(length, 1, sizeof(length), file);
+    fclose(file);
+
+    {
+        RecordLogDatabase db(wallet_path);
+        bilingual_str error;
+        BOOST_CHECK(!db.Verify(error));
+        BOOST_CHECK(error.original.find("corrupt at position") != std::string::npos);
+    }
+    // the records behind the bad frame are left alone
+    BOOST_CHECK_EQUAL(fs::file_size(file_path), size);
+}
+
+BOOST_AUTO_TEST_CASE(recordlog_corrupt_tail)
+{
+    const fs::path wallet_path = GetDataDir() / "recordlog_corrupt_tail";
+    const fs::path file_path = wallet_path / RECORDLOG_FILENAME;
+    {
+        RecordLogDatabase db(wallet_path);
+        auto batch = db.MakeBatch("cr+");
+        BOOST_CHECK(batch->Write(std::string("a"), 1));
+    }
+    const uint64_t size = fs::file_size(file_path);
+
+    // an oversized length at the end of the file isn't a torn append either
+    FILE* file = fsbridge::fopen(file_path, "ab");
+    const unsigned char oversized[] = {0xff, 0xff, 0xff, 0xff, 0x01, 0x02, 0x03, 0x04, 0x05};
+    fwrite(oversized, 1, sizeof(oversized), file);
+    fclose(file);
+    {
+        RecordLogDatabase db(wallet_path);
+        bilingual_str error;
+        BOOST_CHECK(!db.Verify(error));
+    }
+    BOOST_CHECK_EQUAL(fs::file_size(file_path), size + sizeof(oversized));
+
+    // while a tail too short to even hold a frame header is discarded
+    fs::resize_file(file_path, size);
+    file = fsbridge::fopen(file_path, "ab");
+    const unsigned char partial[] = {0x20, 0x00, 0x00};
+    fwrite(partial, 1, sizeof(partial), file);
+    fclose(file);
+
+    RecordLogDatabase db(wallet_path);
+    bilingual_str error;
+    BOOST_CHECK(db.Verify(error));
+    BOOST_CHECK_EQUAL(fs::file_size(file_path), size);
+}
+
+BOOST_AUTO_TEST_CASE(recordlog_rewrite)
+{
+    const fs::path wallet_path = GetDataDir() / "recordlog_rewrite";
+    const fs::path file_path = wallet_path / RECORDLOG_FILENAME;
+    RecordLogDatabase db(wallet_path);
+    {
+        auto batch = db.MakeBatch("cr+");
+        for (int i = 0; i < 100; i++) {
+            BOOST_CHECK(batch->Write(std::make_pair(std::string("pool"), i), i));
+            BOOST_CHECK(batch->Write(std::string("counter"), i));
+        }
+    }
+    const uint64_t size = fs::file_size(file_path);
+
+    // superseded values and skipped keys are dropped
+    BOOST_CHECK(db.Rewrite("\x04pool"));
+    BOOST_CHECK(fs::file_size(file_path) < size);
+
+    auto batch = db.MakeBatch("r");
+    int value = 0;
+    BOOST_CHECK(batch->Read(std::string("counter"), value));
+    BOOST_CHECK_EQUAL(value, 99);
+    BOOST_CHECK(!batch->Exists(std::make_pair(std::string("pool"), 0)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -17,7 +17,9 @@
 #include <util/translation.h>
 #include <validation.h>
 #include <wallet/coincontrol.h>
+#include <wallet/recordlog.h>
 #include <wallet/test/wallet_test_fixture.h>
+#include <wallet/walletdb.h>
 
 #include <boost/test/unit_test.hpp>
 #include <univalue.h>
@@ -967,4 +969,87 @@ BOOST_FIXTURE_TEST_CASE(wallet_disableprivkeys, TestChain100Setup)
     BOOST_CHECK(!wallet->GetKeyFromPool(pubkey, false));
 }
 
+BOOST_FIXTURE_TEST_CASE(wallet_load_parallel, TestChain100Setup)
+{
+    const fs::path wallet_path = GetDataDir() / "wallet_load_parallel";
+    std::vector<CKey> keys(WALLET_LOAD_BATCH_SIZE * 2 + 1);
+    {
+        RecordLogDatabase db(wallet_path);
+        WalletBatch batch(db, "cr+");
+        BOOST_CHECK(batch.TxnBegin());
+        for (CKey& key : keys) {
+            key.MakeNewKey(true);
+            BOOST_CHECK(batch.WriteKey(key.GetPubKey(), key.GetPrivKey(), CKeyMetadata(GetTime())));
+        }
+        BOOST_CHECK(batch.TxnCommit());
+    }
+
+    // full batches of records are decoded on worker threads, the rest on the loading thread
+    auto chain = interfaces::MakeChain();
+    std::shared_ptr<CWallet> wallet = std::make_shared<CWallet>(*chain, WalletLocation(), std::make_unique<RecordLogDatabase>(wallet_path));
+    BOOST_CHECK(WalletBatch(wallet->GetDBHandle()).LoadWallet(wallet.get()) == DBErrors::LOAD_OK);
+    bool fAllKeys = true;
+    for (const CKey& key : keys) {
+        CKey keyOut;
+        fAllKeys &= wallet->GetKey(key.GetPubKey().GetID(), keyOut) && keyOut == key;
+    }
+    BOOST_CHECK(fAllKeys);
+}
+
+BOOST_FIXTURE_TEST_CASE(wallet_unlock_parallel_check, TestChain100Setup)
+{
+    auto chain = interfaces::MakeChain();
+    std::shared_ptr<CWallet> wallet = std::make_shared<CWallet>(*chain, WalletLocation(), CreateDummyWalletDatabase());
+    wallet->SetMinVersion(FEATURE_LATEST);
+    std::vector<CKey> keys(UNLOCK_PARALLEL_CHECK_MIN_KEYS);
+    for (CKey& key : keys) {
+        key.MakeNewKey(true);
+        AddKey(*wallet, key);
+    }
+
+    // the unlock right after encrypting checks all keys on multiple threads
+    const SecureString passphrase = "passphrase";
+    BOOST_CHECK(wallet->EncryptWallet(passphrase));
+    BOOST_CHECK(wallet->IsLocked());
+    BOOST_CHECK(!wallet->Unlock(SecureString("wrong passphrase")));
+    BOOST_CHECK(wallet->Unlock(passphrase));
+    bool fAllKeys = true;
+    for (const CKey& key : keys) {
+        CKey keyOut;
+        fAllKeys &= wallet->GetKey(key.GetPubKey().GetID(), keyOut) && keyOut == key;
+    }
+    BOOST_CHECK(fAllKeys);
+}
+
+BOOST_FIXTURE_TEST_CASE(wallet_derive_keys_batched, TestChain100Setup)
+{
+    auto chain = interfaces::MakeChain();
+    std::shared_ptr<CWallet> wallet = std::make_shared<CWallet>(*chain, WalletLocation(), CreateDummyWalletDatabase());
+    wallet->SetMinVersion(FEATURE_LATEST);
+    LOCK(wallet->cs_wallet);
+    wallet->GenerateNewHDChain("", "");
+
+    CHDChain hdChain;
+    BOOST_CHECK(wallet->GetHDChain(hdChain));
+    CHDAccount acc;
+    BOOST_CHECK(hdChain.GetAccount(0, acc));
+    const uint32_t nFirstIndex = acc.nExternalChainCounter;
+
+    // enough keys to be derived on multiple threads, all must match the ones derived one at a time
+    WalletBatch batch(wallet->GetDBHandle());
+    const auto vPubKeys = wallet->DeriveNewChildKeys(batch, 0, false, KEYPOOL_PARALLEL_DERIVE_MIN_KEYS + 1);
+    BOOST_CHECK_EQUAL(vPubKeys.size(), KEYPOOL_PARALLEL_DERIVE_MIN_KEYS + 1);
+    for (uint32_t i = 0; i < vPubKeys.size(); i++) {
+        CExtKey extKey;
+        CKeyMetadata metadata;
+        hdChain.DeriveChildExtKey(0, false, nFirstIndex + i, extKey, metadata);
+        BOOST_CHECK(extKey.key.GetPubKey() == vPubKeys[i]);
+        BOOST_CHECK(wallet->mapKeyMetadata.at(vPubKeys[i].GetID()).key_origin.path == metadata.key_origin.path);
+    }
+
+    BOOST_CHECK(wallet->GetHDChain(hdChain));
+    BOOST_CHECK(hdChain.GetAccount(0, acc));
+    BOOST_CHECK_EQUAL(acc.nExternalChainCounter, nFirstIndex + vPubKeys.size());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
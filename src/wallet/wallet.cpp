@@ -15,6 +15,7 @@
 #include <consensus/consensus.h>
 #include <consensus/validation.h>
 #include <crypto/common.h>
+#include <ctpl_stl.h>
 #include <fs.h>
 #include <interfaces/chain.h>
 #include <interfaces/wallet.h>
@@ -43,6 +44,7 @@
 #include <wallet/coincontrol.h>
 #include <wallet/coinselection.h>
 #include <wallet/fees.h>
+#include <wallet/recordlog.h>
 #include <warnings.h>
 
 #include <coinjoin/client.h>
@@ -429,6 +431,113 @@ void CWallet::DeriveNewChildKey(WalletBatch &batch, CKeyMetadata& metadata, CKey
         throw std::runtime_error(std::string(__func__) + ": AddHDPubKey failed");
 }
 
+std::vector<CPubKey> CWallet::DeriveNewChildKeys(WalletBatch &batch, uint32_t nAccountIndex, bool fInternal, uint32_t nCount)
+{
+    AssertLockHeld(cs_wallet);
+
+    CHDChain hdChainTmp;
+    if (!GetHDChain(hdChainTmp)) {
+        throw std::runtime_error(std::string(__func__) + ": GetHDChain failed");
+    }
+
+    if (!DecryptHDChain(hdChainTmp))
+        throw std::runtime_error(std::string(__func__) + ": DecryptHDChain failed");
+    // make sure seed matches this chain
+    if (hdChainTmp.GetID() != hdChainTmp.GetSeedHash())
+        throw std::runtime_error(std::string(__func__) + ": Wrong HD chain!");
+
+    CHDAccount acc;
+    if (!hdChainTmp.GetAccount(nAccountIndex, acc))
+        throw std::runtime_error(std::string(__func__) + ": Wrong HD account!");
+
+    // all new keys share the same parent, only derive it once
+    CExtKey changeKey;
+    CKeyID masterId;
+    hdChainTmp.DeriveChangeExtKey(nAccountIndex, fInternal, changeKey, masterId);
+
+    const int64_t nCreationTime = GetTime();
+    const int nThreads = std::max(1, std::min(GetNumCores(), MAX_KEYPOOL_DERIVE_THREADS));
+    std::unique_ptr<ctpl::thread_pool> workerPool;
+
+    std::vector<CPubKey> vPubKeys;
+    vPubKeys.reserve(nCount);
+    uint32_t nChildIndex = fInternal ? acc.nInternalChainCounter : acc.nExternalChainCounter;
+    while (vPubKeys.size() < nCount) {
+        // derive the missing keys at the next indexes, keys already known to the wallet are skipped below and
+        // replaced in the next round
+        const uint32_t nMissing = nCount - vPubKeys.size();
+        std::vector<CExtPubKey> vExtPubKeys(nMissing);
+        std::vector<CKeyMetadata> vMetadata(nMissing, CKeyMetadata(nCreationTime));
+        auto deriveRange = [&](uint32_t nBegin, uint32_t nEnd) {
+            for (uint32_t i = nBegin; i < nEnd; i++) {
+                CExtKey childKey;
+                CHDChain::DeriveChildExtKey(changeKey, masterId, nAccountIndex, fInternal, nChildIndex + i, childKey, vMetadata[i]);
+                vExtPubKeys[i] = childKey.Neuter();
+                assert(childKey.key.VerifyPubKey(vExtPubKeys[i].pubkey));
+            }
+        };
+
+        if (nThreads > 1 && nMissing >= KEYPOOL_PARALLEL_DERIVE_MIN_KEYS) {
+            if (!workerPool) {
+                workerPool = std::make_unique<ctpl::thread_pool>(nThreads);
+                RenameThreadPool(*workerPool, "keyderive");
+            }
+            std::vector<std::future<void>> futures;
+            const uint32_t nChunkSize = (nMissing + nThreads - 1) / nThreads;
+            for (uint32_t i = 0; i < nMissing; i += nChunkSize) {
+                const uint32_t nEnd = std::min(i + nChunkSize, nMissing);
+                futures.emplace_back(workerPool->push([&deriveRange, i, nEnd](int threadId) { deriveRange(i, nEnd); }));
+            }
+            for (auto& f : futures) {
+                f.get();
+            }
+        } else {
+            deriveRange(0, nMissing);
+        }
+
+        for (uint32_t i = 0; i < nMissing; i++) {
+            const CPubKey& pubkey = vExtPubKeys[i].pubkey;
+            if (HaveKey(pubkey.GetID())) {
+                continue;
+            }
+
+            // store metadata
+            mapKeyMetadata[pubkey.GetID()] = vMetadata[i];
+            UpdateTimeFirstKey(nCreationTime);
+
+            if (!AddHDPubKey(batch, vExtPubKeys[i], fInternal))
+                throw std::runtime_error(std::string(__func__) + ": AddHDPubKey failed");
+            vPubKeys.emplace_back(pubkey);
+        }
+        nChildIndex += nMissing;
+    }
+
+    // update the chain model in the database once for all keys
+    CHDChain hdChainCurrent;
+    GetHDChain(hdChainCurrent);
+
+    if (fInternal) {
+        acc.nInternalChainCounter = nChildIndex;
+    }
+    else {
+        acc.nExternalChainCounter = nChildIndex;
+    }
+
+    if (!hdChainCurrent.SetAccount(nAccountIndex, acc))
+        throw std::runtime_error(std::string(__func__) + ": SetAccount failed");
+
+    if (IsCrypted()) {
+        if (!SetCryptedHDChain(batch, hdChainCurrent, false))
+            throw std::runtime_error(std::string(__func__) + ": SetCryptedHDChain failed");
+    }
+    else {
+        if (!SetHDChain(batch, hdChainCurrent, false))
+            throw std::runtime_error(std::string(__func__) + ": SetHDChain failed");
+    }
+
+    return vPubKeys;
+}
+
 bool CWallet::GetPubKey(const CKeyID &address, CPubKey& vchPubKeyOut) const
 {
     LOCK(cs_wallet);
@@ -4798,27 +4907,40 @@ bool CWallet::TopUpKeyPool(unsigned int kpSize)
         } else {
             nTargetSize *= 2;
         }
-        bool fInternal = false;
         WalletBatch batch(*database);
-        for (int64_t i = missingInternal + missingExternal; i--;)
-        {
-            if (i < missingInternal) {
-                fInternal = true;
-            }
+        if (IsHDEnabled()) {
+            // external keys first, then internal ones, each in batches which only derive the chain key once
+            for (const bool fInternal : {false, true}) {
+                int64_t nMissing = fInternal ? missingInternal : missingExternal;
+                while (nMissing > 0) {
+                    const uint32_t nCount = std::min<int64_t>(nMissing, KEYPOOL_DERIVE_BATCH_SIZE);
+                    // TODO: implement keypools for all accounts?
+                    for (const CPubKey& pubkey : DeriveNewChildKeys(batch, 0, fInternal, nCount)) {
+                        AddKeypoolPubkeyWithDB(pubkey, fInternal, batch);
+                    }
+                    nMissing -= nCount;
 
-            // TODO: implement keypools for all accounts?
-            CPubKey pubkey(GenerateNewKey(batch, 0, fInternal));
-            AddKeypoolPubkeyWithDB(pubkey, fInternal, batch);
+                    double dProgress = 100.f * m_max_keypool_index / (nTargetSize + 1);
+                    std::string strMsg = strprintf(_("Loading wallet... (%3.2f %%)").translated, dProgress);
+                    uiInterface.InitMessage(strMsg);
+                }
+            }
+        } else {
+            for (int64_t i = missingExternal; i--;)
+            {
+                CPubKey pubkey(GenerateNewKey(batch, 0, false));
+                AddKeypoolPubkeyWithDB(pubkey, false, batch);
 
-            if (missingInternal + missingExternal > 0) {
-                WalletLogPrintf("keypool added %d keys (%d internal), size=%u (%u internal)\n",
-                          missingInternal + missingExternal, missingInternal,
-                          setInternalKeyPool.size() + setExternalKeyPool.size(), setInternalKeyPool.size());
+                double dProgress = 100.f * m_max_keypool_index / (nTargetSize + 1);
+                std::string strMsg = strprintf(_("Loading wallet... (%3.2f %%)").translated, dProgress);
+                uiInterface.InitMessage(strMsg);
             }
+        }
 
-            double dProgress = 100.f * m_max_keypool_index / (nTargetSize + 1);
-            std::string strMsg = strprintf(_("Loading wallet... (%3.2f %%)").translated, dProgress);
-            uiInterface.InitMessage(strMsg);
+        if (missingInternal + missingExternal > 0) {
+            WalletLogPrintf("keypool added %d keys (%d internal), size=%u (%u internal)\n",
+                      missingInternal + missingExternal, missingInternal,
+                      setInternalKeyPool.size() + setExternalKeyPool.size(), setInternalKeyPool.size());
         }
     }
     NotifyCanGetAddressesChanged();
@@ -5940,9 +6062,14 @@ bool CWallet::AutoBackupWallet(const fs::path& wallet_path, bilingual_str& error
         }
     } else {
         // ... strWalletName file
-        std::string strSourceFile;
-        std::shared_ptr<BerkeleyEnvironment> env = GetWalletEnv(wallet_path, strSourceFile);
-        fs::path sourceFile = env->Directory() / strSourceFile;
+        fs::path sourceFile;
+        if (IsRecordLogWalletPath(wallet_path)) {
+            sourceFile = wallet_path / RECORDLOG_FILENAME;
+        } else {
+            std::string strSourceFile;
+            std::shared_ptr<BerkeleyEnvironment> env = GetWalletEnv(wallet_path, strSourceFile);
+            sourceFile = env->Directory() / strSourceFile;
+        }
         fs::path backupFile = backupsDir / (strWalletName + dateTimeStr);
         sourceFile.make_preferred();
         backupFile.make_preferred();
@@ -66,6 +66,12 @@ enum class WalletCreationStatus {
 WalletCreationStatus CreateWallet(interfaces::Chain& chain, const SecureString& passphrase, uint64_t wallet_creation_flags, const std::string& name, bilingual_str& error, std::vector<bilingual_str>& warnings, std::shared_ptr<CWallet>& result);
 
 static const unsigned int DEFAULT_KEYPOOL_SIZE = 1000;
+//! Number of HD keys TopUpKeyPool derives at once
+static const unsigned int KEYPOOL_DERIVE_BATCH_SIZE = 1000;
+//! Minimum number of HD keys for which derivation is split across threads
+static const unsigned int KEYPOOL_PARALLEL_DERIVE_MIN_KEYS = 100;
+//! Maximum number of threads used to derive HD keys
+static const int MAX_KEYPOOL_DERIVE_THREADS = 8;
 //! -paytxfee default
 constexpr CAmount DEFAULT_PAY_TX_FEE = 0;
 //! -fallbackfee default
@@ -935,6 +941,8 @@ public:
      * Generate a new key
      */
     CPubKey GenerateNewKey(WalletBatch& batch, uint32_t nAccountIndex, bool fInternal /*= false*/) EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
+    /* HD derive nCount new child keys at once, the chain key is derived only once and the children in parallel */
+    std::vector<CPubKey> DeriveNewChildKeys(WalletBatch& batch, uint32_t nAccountIndex, bool fInternal, uint32_t nCount) EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
     //! HaveKey implementation that also checks the mapHdPubKeys
     bool HaveKey(const CKeyID &address) const override;
     //! GetPubKey implementation that also checks the mapHdPubKeys
@@ -8,6 +8,7 @@
 
 #include <consensus/tx_check.h>
 #include <consensus/validation.h>
+#include <ctpl_stl.h>
 #include <key_io.h>
 #include <fs.h>
 #include <governance/object.h>
@@ -17,10 +18,12 @@
 #include <sync.h>
 #include <util/system.h>
 #include <util/time.h>
+#include <wallet/recordlog.h>
 #include <wallet/wallet.h>
 #include <validation.h>
 
 #include <atomic>
+#include <future>
 #include <string>
 
 namespace DBKeys {
@@ -221,19 +224,172 @@ public:
     }
 };
 
-static bool
-ReadKeyValue(CWallet* pwallet, CDataStream& ssKey, CDataStream& ssValue,
-             CWalletScanState &wss, std::string& strType, std::string& strErr, const KeyFilterFn& filter_fn = nullptr) EXCLUSIVE_LOCKS_REQUIRED(pwallet->cs_wallet)
+/**
+ * A wallet record read from the database. Transactions and plaintext keys are decoded and checked by DecodeRecord()
+ * before ReadKeyValue() applies them to the wallet. This does not depend on wallet state and is the expensive part of
+ * loading such records, so LoadWallet() does it for many records in parallel.
+ */
+struct CWalletLoadRecord {
+    CDataStream ssKey{SER_DISK, CLIENT_VERSION};
+    CDataStream ssValue{SER_DISK, CLIENT_VERSION};
+    std::string strType;
+    std::string strErr;
+    bool fDecoded{false};
+    bool fFiltered{false};
+    bool fOk{false};
+
+    // DBKeys::TX
+    std::unique_ptr<CWalletTx> wtx;
+    bool fTxUpgraded{false};
+
+    // DBKeys::KEY and DBKeys::OLD_KEY
+    CPubKey vchPubKey;
+    CKey key;
+};
+
+static bool DecodeTxRecord(CWalletLoadRecord& rec)
+{
+    uint256 hash;
+    rec.ssKey >> hash;
+    rec.wtx = std::make_unique<CWalletTx>(nullptr /* pwallet */, MakeTransactionRef());
+    CWalletTx& wtx = *rec.wtx;
+    rec.ssValue >> wtx;
+    CValidationState state;
+    if (!(CheckTransaction(*wtx.tx, state) && (wtx.GetHash() == hash) && state.IsValid()))
+        return false;
+
+    // Undo serialize changes in 31600
+    if (31404 <= wtx.fTimeReceivedIsTxTime && wtx.fTimeReceivedIsTxTime <= 31703)
+    {
+        if (!rec.ssValue.empty())
+        {
+            char fTmp;
+            char fUnused;
+            std::string unused_string;
+            rec.ssValue >> fTmp >> fUnused >> unused_string;
+            rec.strErr = strprintf("LoadWallet() upgrading tx ver=%d %d %s",
+                                   wtx.fTimeReceivedIsTxTime, fTmp, hash.ToString());
+            wtx.fTimeReceivedIsTxTime = fTmp;
+        }
+        else
+        {
+            rec.strErr = strprintf("LoadWallet() repairing tx ver=%d %s", wtx.fTimeReceivedIsTxTime, hash.ToString());
+            wtx.fTimeReceivedIsTxTime = 0;
+        }
+        rec.fTxUpgraded = true;
+    }
+    return true;
+}
+
+static bool DecodeKeyRecord(CWalletLoadRecord& rec)
+{
+    rec.ssKey >> rec.vchPubKey;
+    if (!rec.vchPubKey.IsValid())
+    {
+        rec.strErr = "Error reading wallet database: CPubKey corrupt";
+        return false;
+    }
+    CPrivKey pkey;
+    uint256 hash;
+
+    if (rec.strType == DBKeys::KEY) {
+        rec.ssValue >> pkey;
+    } else {
+    	// TODO: Back compatibility for PirateCash wallet (need remove after fork 1f61b27399c815ea89ebc7b379283921815a800c )
+        CWalletKey wkey;
+        rec.ssValue >> wkey;
+        pkey = wkey.vchPrivKey;
+    }
+
+    // Old wallets store keys as DBKeys::KEY [pubkey] => [privkey]
+    // ... which was slow for wallets with lots of keys, because the public key is re-derived from the private key
+    // using EC operations as a checksum.
+    // Newer wallets store keys as DBKeys::KEY [pubkey] => [privkey][hash(pubkey,privkey)], which is much faster while
+    // remaining backwards-compatible.
+    try
+    {
+        rec.ssValue >> hash;
+    }
+    catch (...) {}
+
+    bool fSkipCheck = false;
+
+    if (!hash.IsNull())
+    {
+        // hash pubkey/privkey to accelerate wallet load
+        std::vector<unsigned char> vchKey;
+        vchKey.reserve(rec.vchPubKey.size() + pkey.size());
+        vchKey.insert(vchKey.end(), rec.vchPubKey.begin(), rec.vchPubKey.end());
+        vchKey.insert(vchKey.end(), pkey.begin(), pkey.end());
+
+        if (Hash(vchKey.begin(), vchKey.end()) != hash)
+        {
+            rec.strErr = "Error reading wallet database: CPubKey/CPrivKey corrupt";
+            return false;
+        }
+
+        fSkipCheck = true;
+    }
+
+    if (!rec.key.Load(pkey, rec.vchPubKey, fSkipCheck))
+    {
+        rec.strErr = "Error reading wallet database: CPrivKey corrupt";
+        return false;
+    }
+    return true;
+}
+
+/** Read the record type and decode the record if it's a transaction or a plaintext key. Safe to call from any thread. */
+static void DecodeRecord(CWalletLoadRecord& rec, const KeyFilterFn& filter_fn = nullptr)
 {
+    rec.fDecoded = true;
     try {
         // Unserialize
         // Taking advantage of the fact that pair serialization
         // is just the two items serialized one after the other
-        ssKey >> strType;
+        rec.ssKey >> rec.strType;
         // If we have a filter, check if this matches the filter
-        if (filter_fn && !filter_fn(strType)) {
-            return true;
+        if (filter_fn && !filter_fn(rec.strType)) {
+            rec.fFiltered = true;
+            return;
+        }
+        if (rec.strType == DBKeys::TX) {
+            rec.fOk = DecodeTxRecord(rec);
+        } else if (rec.strType == DBKeys::KEY || rec.strType == DBKeys::OLD_KEY) {
+            rec.fOk = DecodeKeyRecord(rec);
+        } else {
+            rec.fOk = true;
         }
+    } catch (const std::exception& e) {
+        if (rec.strErr.empty()) {
+            rec.strErr = e.what();
+        }
+    } catch (...) {
+        if (rec.strErr.empty()) {
+            rec.strErr = "Caught unknown exception in ReadKeyValue";
+        }
+    }
+}
+
+static bool
+ReadKeyValue(CWallet* pwallet, CWalletLoadRecord& rec,
+             CWalletScanState &wss, std::string& strType, std::string& strErr, const KeyFilterFn& filter_fn = nullptr) EXCLUSIVE_LOCKS_REQUIRED(pwallet->cs_wallet)
+{
+    if (!rec.fDecoded) {
+        DecodeRecord(rec, filter_fn);
+    }
+    strType = rec.strType;
+    strErr = rec.strErr;
+    if (rec.fFiltered) {
+        return true;
+    }
+    if (!rec.fOk) {
+        return false;
+    }
+
+    CDataStream& ssKey = rec.ssKey;
+    CDataStream& ssValue = rec.ssValue;
+    try {
         if (strType == DBKeys::NAME) {
             std::string strAddress;
             ssKey >> strAddress;
@@ -243,39 +399,13 @@ ReadKeyValue(CWallet* pwallet, CDataStream& ssKey, CDataStream& ssValue,
             ssKey >> strAddress;
             ssValue >> pwallet->mapAddressBook[DecodeDestination(strAddress)].purpose;
         } else if (strType == DBKeys::TX) {
-            uint256 hash;
-            ssKey >> hash;
-            CWalletTx wtx(nullptr /* pwallet */, MakeTransactionRef());
-            ssValue >> wtx;
-            CValidationState state;
-            if (!(CheckTransaction(*wtx.tx, state) && (wtx.GetHash() == hash) && state.IsValid()))
-                return false;
+            if (rec.fTxUpgraded)
+                wss.vWalletUpgrade.push_back(rec.wtx->GetHash());
 
-            // Undo serialize changes in 31600
-            if (31404 <= wtx.fTimeReceivedIsTxTime && wtx.fTimeReceivedIsTxTime <= 31703)
-            {
-                if (!ssValue.empty())
-                {
-                    char fTmp;
-                    char fUnused;
-                    std::string unused_string;
-                    ssValue >> fTmp >> fUnused >> unused_string;
-                    strErr = strprintf("LoadWallet() upgrading tx ver=%d %d %s",
-                                       wtx.fTimeReceivedIsTxTime, fTmp, hash.ToString());
-                    wtx.fTimeReceivedIsTxTime = fTmp;
-                }
-                else
-                {
-                    strErr = strprintf("LoadWallet() repairing tx ver=%d %s", wtx.fTimeReceivedIsTxTime, hash.ToString());
-                    wtx.fTimeReceivedIsTxTime = 0;
-                }
-                wss.vWalletUpgrade.push_back(hash);
-            }
-
-            if (wtx.nOrderPos == -1)
+            if (rec.wtx->nOrderPos == -1)
                 wss.fAnyUnordered = true;
 
-            pwallet->LoadToWallet(wtx);
+            pwallet->LoadToWallet(*rec.wtx);
         } else if (strType == DBKeys::WATCHS) {
             wss.nWatchKeys++;
             CScript script;
@@ -285,63 +415,10 @@ ReadKeyValue(CWallet* pwallet, CDataStream& ssKey, CDataStream& ssValue,
             if (fYes == '1')
                 pwallet->LoadWatchOnly(script);
         } else if (strType == DBKeys::KEY || strType == DBKeys::OLD_KEY) {
-            CPubKey vchPubKey;
-            ssKey >> vchPubKey;
-            if (!vchPubKey.IsValid())
-            {
-                strErr = "Error reading wallet database: CPubKey corrupt";
-                return false;
-            }
-            CKey key;
-            CPrivKey pkey;
-            uint256 hash;
-
             if (strType == DBKeys::KEY) {
                 wss.nKeys++;
-                ssValue >> pkey;
-            } else {
-        	// TODO: Back compatibility for PirateCash wallet (need remove after fork 1f61b27399c815ea89ebc7b379283921815a800c )
-                CWalletKey wkey;
-                ssValue >> wkey;
-                pkey = wkey.vchPrivKey;
-            }
-
-            // Old wallets store keys as DBKeys::KEY [pubkey] => [privkey]
-            // ... which was slow for wallets with lots of keys, because the public key is re-derived from the private key
-            // using EC operations as a checksum.
-            // Newer wallets store keys as DBKeys::KEY [pubkey] => [privkey][hash(pubkey,privkey)], which is much faster while
-            // remaining backwards-compatible.
-            try
-            {
-                ssValue >> hash;
             }
-            catch (...) {}
-
-            bool fSkipCheck = false;
-
-            if (!hash.IsNull())
-            {
-                // hash pubkey/privkey to accelerate wallet load
-                std::vector<unsigned char> vchKey;
-                vchKey.reserve(vchPubKey.size() + pkey.size());
-                vchKey.insert(vchKey.end(), vchPubKey.begin(), vchPubKey.end());
-                vchKey.insert(vchKey.end(), pkey.begin(), pkey.end());
-
-                if (Hash(vchKey.begin(), vchKey.end()) != hash)
-                {
-                    strErr = "Error reading wallet database: CPubKey/CPrivKey corrupt";
-                    return false;
-                }
-
-                fSkipCheck = true;
-            }
-
-            if (!key.Load(pkey, vchPubKey, fSkipCheck))
-            {
-                strErr = "Error reading wallet database: CPrivKey corrupt";
-                return false;
-            }
-            if (!pwallet->LoadKey(key, vchPubKey))
+            if (!pwallet->LoadKey(rec.key, rec.vchPubKey))
             {
                 strErr = "Error reading wallet database: LoadKey failed";
                 return false;
@@ -501,8 +578,11 @@ ReadKeyValue(CWallet* pwallet, CDataStream& ssKey, CDataStream& ssValue,
 bool ReadKeyValue(CWallet* pwallet, CDataStream& ssKey, CDataStream& ssValue, std::string& strType, std::string& strErr, const KeyFilterFn& filter_fn)
 {
     CWalletScanState dummy_wss;
+    CWalletLoadRecord rec;
+    rec.ssKey = ssKey;
+    rec.ssValue = ssValue;
     LOCK(pwallet->cs_wallet);
-    return ReadKeyValue(pwallet, ssKey, ssValue, dummy_wss, strType, strErr, filter_fn);
+    return ReadKeyValue(pwallet, rec, dummy_wss, strType, strErr, filter_fn);
 }
 
 bool WalletBatch::IsKeyType(const std::string& strType)
@@ -536,14 +616,71 @@ DBErrors WalletBatch::LoadWallet(CWallet* pwallet)
             return DBErrors::CORRUPT;
         }
 
+        const int64_t nStart = GetTimeMillis();
+        const int nThreads = std::max(1, std::min(GetNumCores(), MAX_WALLET_LOAD_THREADS));
+        std::unique_ptr<ctpl::thread_pool> workerPool;
+        std::vector<CWalletLoadRecord> vRecords;
+        vRecords.reserve(WALLET_LOAD_BATCH_SIZE);
+        size_t nRecords = 0;
+
+        // Records are read in batches. Transactions and plaintext keys of a batch are decoded on worker threads, then
+        // all records of the batch are applied to the wallet in the order in which they were read.
+        auto processBatch = [&]() EXCLUSIVE_LOCKS_REQUIRED(pwallet->cs_wallet) {
+            if (nThreads > 1 && vRecords.size() == WALLET_LOAD_BATCH_SIZE) {
+                if (!workerPool) {
+                    workerPool = std::make_unique<ctpl::thread_pool>(nThreads);
+                    RenameThreadPool(*workerPool, "walletload");
+                }
+                std::vector<std::future<void>> futures;
+                const size_t nChunkSize = (vRecords.size() + nThreads - 1) / nThreads;
+                for (size_t i = 0; i < vRecords.size(); i += nChunkSize) {
+                    const size_t nEnd = std::min(i + nChunkSize, vRecords.size());
+                    futures.emplace_back(workerPool->push([&vRecords, i, nEnd](int threadId) {
+                        for (size_t j = i; j < nEnd; j++) {
+                            DecodeRecord(vRecords[j]);
+                        }
+                    }));
+                }
+                for (auto& f : futures) {
+                    f.get();
+                }
+            }
+
+            for (auto& rec : vRecords) {
+                // Try to be tolerant of single corrupt records:
+                std::string strType, strErr;
+                if (!ReadKeyValue(pwallet, rec, wss, strType, strErr))
+                {
+                    // losing keys is considered a catastrophic error, anything else
+                    // we assume the user can live with:
+                    if (IsKeyType(strType) || strType == DBKeys::DEFAULTKEY) {
+                        result = DBErrors::CORRUPT;
+                    } else if (strType == DBKeys::FLAGS) {
+                        // reading the wallet flags can only fail if unknown flags are present
+                        result = DBErrors::TOO_NEW;
+                    } else {
+                        // Leave other errors alone, if we try to fix them we might make things worse.
+                        fNoncriticalErrors = true; // ... but do warn the user there is something wrong.
+                        if (strType == DBKeys::TX)
+                            // Rescan if there is a bad transaction record:
+                            gArgs.SoftSetBoolArg("-rescan", true);
+                    }
+                }
+                if (!strErr.empty())
+                    pwallet->WalletLogPrintf("%s\n", strErr);
+            }
+            nRecords += vRecords.size();
+            vRecords.clear();
+        };
+
         while (true)
         {
             // Read next record
-            CDataStream ssKey(SER_DISK, CLIENT_VERSION);
-            CDataStream ssValue(SER_DISK, CLIENT_VERSION);
+            CWalletLoadRecord& rec = vRecords.emplace_back();
             bool complete;
-            bool ret = m_batch->ReadAtCursor(ssKey, ssValue, complete);
+            bool ret = m_batch->ReadAtCursor(rec.ssKey, rec.ssValue, complete);
             if (complete) {
+                vRecords.pop_back();
                 break;
             }
             else if (!ret)
@@ -553,28 +690,14 @@ DBErrors WalletBatch::LoadWallet(CWallet* pwallet)
                 return DBErrors::CORRUPT;
             }
 
-            // Try to be tolerant of single corrupt records:
-            std::string strType, strErr;
-            if (!ReadKeyValue(pwallet, ssKey, ssValue, wss, strType, strErr))
-            {
-                // losing keys is considered a catastrophic error, anything else
-                // we assume the user can live with:
-                if (IsKeyType(strType) || strType == DBKeys::DEFAULTKEY) {
-                    result = DBErrors::CORRUPT;
-                } else if (strType == DBKeys::FLAGS) {
-                    // reading the wallet flags can only fail if unknown flags are present
-                    result = DBErrors::TOO_NEW;
-                } else {
-                    // Leave other errors alone, if we try to fix them we might make things worse.
-                    fNoncriticalErrors = true; // ... but do warn the user there is something wrong.
-                    if (strType == DBKeys::TX)
-                        // Rescan if there is a bad transaction record:
-                        gArgs.SoftSetBoolArg("-rescan", true);
-                }
+            if (vRecords.size() == WALLET_LOAD_BATCH_SIZE) {
+                processBatch();
             }
-            if (!strErr.empty())
-                pwallet->WalletLogPrintf("%s\n", strErr);
         }
+        processBatch();
+
+        pwallet->WalletLogPrintf("Loaded %u wallet records in %dms using %d threads\n",
+            nRecords, GetTimeMillis() - nStart, workerPool ? nThreads : 1);
 
         // Store initial external keypool size since we mostly use external keys in mixing
         pwallet->nKeysLeftSinceAutoBackup = pwallet->KeypoolCountExternalKeys();
@@ -825,12 +948,17 @@ bool WalletBatch::TxnAbort()
 
 bool IsWalletLoaded(const fs::path& wallet_path)
 {
-    return IsBDBWalletLoaded(wallet_path);
+    return IsBDBWalletLoaded(wallet_path) || IsRecordLogWalletLoaded(wallet_path);
 }
 
 /** Return object for accessing database at specified path. */
 std::unique_ptr<WalletDatabase> CreateWalletDatabase(const fs::path& path)
 {
+    // Existing wallets keep their format, new ones are created in the format selected by -walletformat
+    if (IsRecordLogWalletPath(path) ||
+        (!fs::exists(WalletDataFilePath(path)) && !fs::is_regular_file(path) && gArgs.GetArg("-walletformat", DEFAULT_WALLET_FORMAT) == WALLET_FORMAT_RECORDLOG)) {
+        return MakeUnique<RecordLogDatabase>(path);
+    }
     std::string filename;
     return MakeUnique<BerkeleyDatabase>(GetWalletEnv(path, filename), std::move(filename));
 }
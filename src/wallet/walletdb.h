@@ -29,6 +29,10 @@
  */
 
 static const bool DEFAULT_FLUSHWALLET = true;
+//! Number of records LoadWallet reads before decoding them in parallel
+static const size_t WALLET_LOAD_BATCH_SIZE = 1000;
+//! Maximum number of threads LoadWallet uses to decode records
+static const int MAX_WALLET_LOAD_THREADS = 8;
 
 struct CBlockLocator;
 class CGovernanceObject;
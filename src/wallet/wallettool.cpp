@@ -6,8 +6,11 @@
 #include <interfaces/chain.h>
 #include <util/translation.h>
 #include <util/system.h>
+#include <wallet/bdb.h>
+#include <wallet/recordlog.h>
 #include <wallet/salvage.h>
 #include <wallet/wallet.h>
+#include <wallet/walletdb.h>
 #include <wallet/walletutil.h>
 
 namespace WalletTool {
@@ -107,6 +110,98 @@ static void WalletShowInfo(CWallet* wallet_instance)
     tfm::format(std::cout, "Address Book: %zu\n", wallet_instance->mapAddressBook.size());
 }
 
+//! Number of records copied per transaction by MigrateWallet
+static const size_t MIGRATE_BATCH_SIZE = 1000;
+
+static bool MigrateWallet(const std::string& name, const fs::path& path, const std::string& format)
+{
+    if (format != WALLET_FORMAT_BDB && format != WALLET_FORMAT_RECORDLOG) {
+        tfm::format(std::cerr, "Error: Unknown wallet format %s\n", format);
+        return false;
+    }
+    if (!fs::is_directory(path)) {
+        tfm::format(std::cerr, "Error: Only wallets stored in their own directory can be migrated\n");
+        return false;
+    }
+
+    const bool from_recordlog = IsRecordLogWalletPath(path);
+    const fs::path source_file = from_recordlog ? path / RECORDLOG_FILENAME : WalletDataFilePath(path);
+    const fs::path target_file = format == WALLET_FORMAT_RECORDLOG ? path / RECORDLOG_FILENAME : WalletDataFilePath(path);
+    if ((format == WALLET_FORMAT_RECORDLOG) == from_recordlog) {
+        tfm::format(std::cerr, "Error: %s is already in format %s\n", name, format);
+        return false;
+    }
+    if (fs::exists(target_file)) {
+        tfm::format(std::cerr, "Error: %s exists already\n", target_file.string());
+        return false;
+    }
+    const fs::path backup_file = source_file.string() + ".bak";
+    if (fs::exists(backup_file)) {
+        tfm::format(std::cerr, "Error: %s exists already\n", backup_file.string());
+        return false;
+    }
+
+    std::unique_ptr<WalletDatabase> source = CreateWalletDatabase(path);
+    bilingual_str error;
+    if (!source->Verify(error)) {
+        tfm::format(std::cerr, "%s\n", error.original);
+        return false;
+    }
+    std::unique_ptr<WalletDatabase> target;
+    if (format == WALLET_FORMAT_RECORDLOG) {
+        target = MakeUnique<RecordLogDatabase>(path);
+    } else {
+        std::string filename;
+        target = MakeUnique<BerkeleyDatabase>(GetWalletEnv(path, filename), filename);
+    }
+
+    size_t nRecords = 0;
+    bool fSuccess = true;
+    {
+        std::unique_ptr<DatabaseBatch> source_batch = source->MakeBatch("r", false);
+        std::unique_ptr<DatabaseBatch> target_batch = target->MakeBatch("cr+", false);
+        fSuccess = source_batch->StartCursor();
+        while (fSuccess) {
+            CDataStream ssKey(SER_DISK, CLIENT_VERSION);
+            CDataStream ssValue(SER_DISK, CLIENT_VERSION);
+            bool complete;
+            bool ret = source_batch->ReadAtCursor(ssKey, ssValue, complete);
+            if (complete) {
+                break;
+            } else if (!ret) {
+                fSuccess = false;
+                break;
+            }
+            if (nRecords % MIGRATE_BATCH_SIZE == 0) {
+                if (nRecords > 0) fSuccess = target_batch->TxnCommit();
+                fSuccess = fSuccess && target_batch->TxnBegin();
+            }
+            // keys and values are copied verbatim
+            fSuccess = fSuccess && target_batch->Write(Span<const unsigned char>((const unsigned char*)ssKey.data(), ssKey.size()),
+                                                       Span<const unsigned char>((const unsigned char*)ssValue.data(), ssValue.size()));
+            nRecords++;
+        }
+        source_batch->CloseCursor();
+        if (fSuccess && nRecords > 0) {
+            fSuccess = target_batch->TxnCommit();
+        }
+    }
+    target->Close();
+    source->Close();
+    target.reset();
+    source.reset();
+
+    if (!fSuccess) {
+        tfm::format(std::cerr, "Error: Failed to migrate %s, keeping the original database\n", name);
+        fs::remove(target_file);
+        return false;
+    }
+
+    fs::rename(source_file, backup_file);
+    tfm::format(std::cout, "Migrated %d records of %s to format %s, the old database was moved to %s\n", nRecords, name, format, backup_file.string());
+    return true;
+}
+
 bool ExecuteWalletToolFunc(const std::string& command, const std::string& name)
 {
     fs::path path = fs::absolute(name, GetWalletDir());
@@ -117,7 +212,7 @@ bool ExecuteWalletToolFunc(const std::string& command, const std::string& name)
             WalletShowInfo(wallet_instance.get());
             wallet_instance->Close();
         }
-    } else if (command == "info" || command == "salvage") {
+    } else if (command == "info" || command == "salvage" || command == "migrate") {
         if (!fs::exists(path)) {
             tfm::format(std::cerr, "Error: no wallet file at %s\n", name);
             return false;
@@ -141,6 +236,8 @@ bool ExecuteWalletToolFunc(const std::string& command, const std::string& name)
                 }
             }
             return ret;
+        } else if (command == "migrate") {
+            return MigrateWallet(name, path, gArgs.GetArg("-walletformat", DEFAULT_WALLET_FORMAT));
         }
     } else {
         tfm::format(std::cerr, "Invalid command: %s\n", command);
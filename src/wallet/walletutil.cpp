@@ -6,6 +6,7 @@
 
 #include <logging.h>
 #include <util/system.h>
+#include <wallet/recordlog.h>
 
 fs::path GetWalletDir()
 {
@@ -74,6 +75,12 @@ std::vector<fs::path> ListWalletDir()
         if (it->status().type() == fs::directory_file && IsBerkeleyBtree(it->path() / "wallet.dat")) {
             // Found a directory which contains wallet.dat btree file, add it as a wallet.
             paths.emplace_back(path);
+        } else if (it->status().type() == fs::directory_file && IsRecordLogFile(it->path() / RECORDLOG_FILENAME)) {
+            // Found a directory which contains a record log wallet, add it as a wallet.
+            paths.emplace_back(path);
+        } else if (it.level() == 0 && it->path().filename() == RECORDLOG_FILENAME && IsRecordLogFile(it->path())) {
+            // Found top-level record log wallet, add top level directory "" as a wallet.
+            paths.emplace_back();
         } else if (it.level() == 0 && it->symlink_status().type() == fs::regular_file && IsBerkeleyBtree(it->path())) {
             if (it->path().filename() == "wallet.dat") {
                 // Found top-level wallet.dat btree file, add top level directory ""
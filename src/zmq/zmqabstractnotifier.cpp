@@ -4,21 +4,51 @@
 
 #include <zmq/zmqabstractnotifier.h>
 
+#include <chainparams.h>
+#include <streams.h>
+#include <validation.h>
+#include <version.h>
+#include <zmq/zmqutil.h>
+
 #include <cassert>
 
 const int CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM;
 
+std::shared_ptr<const std::vector<unsigned char>> CZMQBlock::GetSerialized() const
+{
+    LOCK(cs);
+    if (fSerialized) {
+        return serialized;
+    }
+    fSerialized = true;
+
+    auto vch = std::make_shared<std::vector<unsigned char>>();
+    CVectorWriter writer(SER_NETWORK, PROTOCOL_VERSION, *vch, 0);
+    if (block) {
+        writer << *block;
+    } else {
+        auto pblock = ReadSharedBlockFromDisk(pindex, Params().GetConsensus());
+        if (!pblock) {
+            zmqError("Can't read block from disk");
+            return nullptr;
+        }
+        writer << *pblock;
+    }
+    serialized = std::move(vch);
+    return serialized;
+}
+
 CZMQAbstractNotifier::~CZMQAbstractNotifier()
 {
     assert(!psocket);
 }
 
-bool CZMQAbstractNotifier::NotifyBlock(const CBlockIndex * /*CBlockIndex*/)
+bool CZMQAbstractNotifier::NotifyBlock(const CZMQBlock& /*block*/)
 {
     return true;
 }
 
-bool CZMQAbstractNotifier::NotifyChainLock(const CBlockIndex * /*CBlockIndex*/, const std::shared_ptr<const llmq::CChainLockSig> & /*clsig*/)
+bool CZMQAbstractNotifier::NotifyChainLock(const CZMQBlock& /*block*/, const std::shared_ptr<const llmq::CChainLockSig> & /*clsig*/)
 {
     return true;
 }
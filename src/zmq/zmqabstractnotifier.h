@@ -5,11 +5,14 @@
 #ifndef BITCOIN_ZMQ_ZMQABSTRACTNOTIFIER_H
 #define BITCOIN_ZMQ_ZMQABSTRACTNOTIFIER_H
 
+#include <sync.h>
 #include <util/memory.h>
 
 #include <memory>
 #include <string>
+#include <vector>
 
+class CBlock;
 class CBlockIndex;
 class CGovernanceObject;
 class CGovernanceVote;
@@ -26,6 +29,29 @@ namespace llmq {
 
 using CZMQNotifierFactory = std::unique_ptr<CZMQAbstractNotifier> (*)();
 
+/**
+ * A block handed to the notifiers. Blocks which were just connected are
+ * published from memory, and the serialization is done once and shared by
+ * all raw publishers.
+ */
+class CZMQBlock
+{
+public:
+    CZMQBlock(const CBlockIndex* pindexIn, std::shared_ptr<const CBlock> blockIn) : pindex(pindexIn), block(std::move(blockIn)) {}
+
+    const CBlockIndex* GetIndex() const { return pindex; }
+    /** The serialized block, nullptr if it isn't in memory and can't be read from disk */
+    std::shared_ptr<const std::vector<unsigned char>> GetSerialized() const;
+
+private:
+    const CBlockIndex* const pindex;
+    const std::shared_ptr<const CBlock> block;
+
+    mutable Mutex cs;
+    mutable std::shared_ptr<const std::vector<unsigned char>> serialized GUARDED_BY(cs);
+    mutable bool fSerialized GUARDED_BY(cs) {false};
+};
+
 class CZMQAbstractNotifier
 {
 public:
@@ -51,11 +77,21 @@ public:
         }
     }
 
+    /** Statistics of the outbound message queue */
+    struct QueueStats
+    {
+        size_t nQueued{0};
+        size_t nQueuePeak{0}; //!< most messages ever queued at once
+        uint64_t nDropped{0}; //!< messages dropped because the queue was at the high water mark
+        uint64_t nSent{0};
+    };
+    virtual QueueStats GetQueueStats() const { return {}; }
+
     virtual bool Initialize(void *pcontext) = 0;
     virtual void Shutdown() = 0;
 
-    virtual bool NotifyBlock(const CBlockIndex *pindex);
-    virtual bool NotifyChainLock(const CBlockIndex *pindex, const std::shared_ptr<const llmq::CChainLockSig>& clsig);
+    virtual bool NotifyBlock(const CZMQBlock& block);
+    virtual bool NotifyChainLock(const CZMQBlock& block, const std::shared_ptr<const llmq::CChainLockSig>& clsig);
     virtual bool NotifyTransaction(const CTransaction &transaction);
     virtual bool NotifyTransactionLock(const CTransactionRef& transaction, const std::shared_ptr<const llmq::CInstantSendLock>& islock);
     virtual bool NotifyGovernanceVote(const std::shared_ptr<const CGovernanceVote>& vote);
@@ -142,20 +142,33 @@ void TryForEachAndRemoveFailed(std::list<std::unique_ptr<CZMQAbstractNotifier>>&
 }
 }
 
+std::shared_ptr<const CZMQBlock> CZMQNotificationInterface::GetBlock(const CBlockIndex* pindex)
+{
+    LOCK(cs_blocks);
+    std::shared_ptr<const CZMQBlock> block;
+    if (!recentBlocks.get(pindex->GetBlockHash(), block) || block->GetIndex() != pindex) {
+        block = std::make_shared<const CZMQBlock>(pindex, nullptr);
+        recentBlocks.insert(pindex->GetBlockHash(), block);
+    }
+    return block;
+}
+
 void CZMQNotificationInterface::UpdatedBlockTip(const CBlockIndex *pindexNew, const CBlockIndex *pindexFork, bool fInitialDownload)
 {
     if (fInitialDownload || pindexNew == pindexFork) // In IBD or blocks were disconnected without any new ones
         return;
 
-    TryForEachAndRemoveFailed(notifiers, [pindexNew](CZMQAbstractNotifier* notifier) {
-        return notifier->NotifyBlock(pindexNew);
+    const auto block = GetBlock(pindexNew);
+    TryForEachAndRemoveFailed(notifiers, [&block](CZMQAbstractNotifier* notifier) {
+        return notifier->NotifyBlock(*block);
     });
 }
 
 void CZMQNotificationInterface::NotifyChainLock(const CBlockIndex *pindex, const std::shared_ptr<const llmq::CChainLockSig>& clsig)
 {
-    TryForEachAndRemoveFailed(notifiers, [pindex, &clsig](CZMQAbstractNotifier* notifier) {
-        return notifier->NotifyChainLock(pindex, clsig);
+    const auto block = GetBlock(pindex);
+    TryForEachAndRemoveFailed(notifiers, [&block, &clsig](CZMQAbstractNotifier* notifier) {
+        return notifier->NotifyChainLock(*block, clsig);
     });
 }
 
@@ -172,6 +185,9 @@ void CZMQNotificationInterface::TransactionAddedToMempool(const CTransactionRef&
 
 void CZMQNotificationInterface::BlockConnected(const std::shared_ptr<const CBlock>& pblock, const CBlockIndex* pindexConnected, const std::vector<CTransactionRef>& vtxConflicted)
 {
+    // UpdatedBlockTip follows, publish the block from memory instead of reading it back from disk
+    WITH_LOCK(cs_blocks, recentBlocks.insert(pindexConnected->GetBlockHash(), std::make_shared<const CZMQBlock>(pindexConnected, pblock)));
+
     for (const CTransactionRef& ptx : pblock->vtx) {
         // Do a normal notify for each transaction added in the block
         TransactionAddedToMempool(ptx, 0);
@@ -5,12 +5,16 @@
 #ifndef BITCOIN_ZMQ_ZMQNOTIFICATIONINTERFACE_H
 #define BITCOIN_ZMQ_ZMQNOTIFICATIONINTERFACE_H
 
+#include <saltedhasher.h>
+#include <sync.h>
+#include <unordered_lru_cache.h>
 #include <validationinterface.h>
 #include <list>
 #include <memory>
 
 class CBlockIndex;
 class CZMQAbstractNotifier;
+class CZMQBlock;
 
 class CZMQNotificationInterface final : public CValidationInterface
 {
@@ -40,8 +44,15 @@ protected:
 private:
     CZMQNotificationInterface();
 
+    /** Returns the recently connected block, or one which has to be read from disk when it is serialized */
+    std::shared_ptr<const CZMQBlock> GetBlock(const CBlockIndex* pindex);
+
     void *pcontext;
     std::list<std::unique_ptr<CZMQAbstractNotifier>> notifiers;
+
+    /** Recently connected blocks, for the tip and chainlock notifications which follow them */
+    Mutex cs_blocks;
+    unordered_lru_cache<uint256, std::shared_ptr<const CZMQBlock>, StaticSaltedHasher, 4> recentBlocks GUARDED_BY(cs_blocks);
 };
 
 extern CZMQNotificationInterface* g_zmq_notification_interface;
@@ -17,15 +17,28 @@
 #include <llmq/instantsend.h>
 #include <llmq/signing.h>
 
+#include <util/threadnames.h>
+
 #include <zmq.h>
 
+#include <algorithm>
+#include <condition_variable>
 #include <cstdarg>
 #include <cstddef>
 #include <map>
 #include <string>
+#include <thread>
 #include <utility>
 
-static std::multimap<std::string, CZMQAbstractPublishNotifier*> mapPublishNotifiers;
+/** Guards mapPublishNotifiers and the sockets, which are used by the zmqpub thread */
+static Mutex cs_publishers;
+static std::multimap<std::string, CZMQAbstractPublishNotifier*> mapPublishNotifiers GUARDED_BY(cs_publishers);
+
+static Mutex cs_publish_wake;
+static std::condition_variable cond_publish_wake;
+static bool fPublishWake GUARDED_BY(cs_publish_wake) {false};
+static bool fPublishStop GUARDED_BY(cs_publish_wake) {false};
+static std::thread threadPublish;
 
 static const char *MSG_HASHBLOCK     = "hashblock";
 static const char *MSG_HASHCHAINLOCK = "hashchainlock";
@@ -89,10 +102,57 @@ static int zmq_send_multipart(void *sock, const void* data, size_t size, ...)
     return 0;
 }
 
+static void ThreadPublish()
+{
+    util::ThreadRename("zmqpub");
+    while (true) {
+        {
+            WAIT_LOCK(cs_publish_wake, lock);
+            cond_publish_wake.wait(lock, []() EXCLUSIVE_LOCKS_REQUIRED(cs_publish_wake) { return fPublishWake || fPublishStop; });
+            // whatever is left is sent by CZMQAbstractPublishNotifier::Shutdown
+            if (fPublishStop) return;
+            fPublishWake = false;
+        }
+        LOCK(cs_publishers);
+        for (const auto& entry : mapPublishNotifiers) {
+            entry.second->SendQueuedMessages();
+        }
+    }
+}
+
+static void WakePublishThread()
+{
+    {
+        LOCK(cs_publish_wake);
+        fPublishWake = true;
+    }
+    cond_publish_wake.notify_one();
+}
+
+static void StartPublishThread() EXCLUSIVE_LOCKS_REQUIRED(cs_publishers)
+{
+    if (threadPublish.joinable()) return;
+    WITH_LOCK(cs_publish_wake, fPublishWake = false; fPublishStop = false);
+    threadPublish = std::thread(ThreadPublish);
+}
+
+static void StopPublishThread() LOCKS_EXCLUDED(cs_publishers)
+{
+    if (!threadPublish.joinable()) return;
+    {
+        LOCK(cs_publish_wake);
+        fPublishStop = true;
+    }
+    cond_publish_wake.notify_one();
+    threadPublish.join();
+}
+
 bool CZMQAbstractPublishNotifier::Initialize(void *pcontext)
 {
     assert(!psocket);
 
+    LOCK(cs_publishers);
+
     // check if address is being used by other publish notifier
     std::multimap<std::string, CZMQAbstractPublishNotifier*>::iterator i = mapPublishNotifiers.find(address);
 
@@ -133,6 +193,7 @@ bool CZMQAbstractPublishNotifier::Initialize(void *pcontext)
 
         // register this notifier for the address, so it can be reused for other publish notifier
         mapPublishNotifiers.insert(std::make_pair(address, this));
+        StartPublishThread();
         return true;
     }
     else
@@ -142,6 +203,7 @@ bool CZMQAbstractPublishNotifier::Initialize(void *pcontext)
 
         psocket = i->second->psocket;
         mapPublishNotifiers.insert(std::make_pair(address, this));
+        StartPublishThread();
 
         return true;
     }
@@ -151,52 +213,115 @@ void CZMQAbstractPublishNotifier::Shutdown()
 {
     assert(psocket);
 
-    int count = mapPublishNotifiers.count(address);
+    bool fLastPublisher;
+    {
+        LOCK(cs_publishers);
+        // don't lose what is still queued
+        SendQueuedMessages();
 
-    // remove this notifier from the list of publishers using this address
-    typedef std::multimap<std::string, CZMQAbstractPublishNotifier*>::iterator iterator;
-    std::pair<iterator, iterator> iterpair = mapPublishNotifiers.equal_range(address);
+        int count = mapPublishNotifiers.count(address);
 
-    for (iterator it = iterpair.first; it != iterpair.second; ++it)
-    {
-        if (it->second==this)
+        // remove this notifier from the list of publishers using this address
+        typedef std::multimap<std::string, CZMQAbstractPublishNotifier*>::iterator iterator;
+        std::pair<iterator, iterator> iterpair = mapPublishNotifiers.equal_range(address);
+
+        for (iterator it = iterpair.first; it != iterpair.second; ++it)
         {
-            mapPublishNotifiers.erase(it);
-            break;
+            if (it->second==this)
+            {
+                mapPublishNotifiers.erase(it);
+                break;
+            }
         }
-    }
 
-    if (count == 1)
-    {
-        LogPrint(BCLog::ZMQ, "zmq: Close socket at address %s\n", address);
-        int linger = 0;
-        zmq_setsockopt(psocket, ZMQ_LINGER, &linger, sizeof(linger));
-        zmq_close(psocket);
+        if (count == 1)
+        {
+            LogPrint(BCLog::ZMQ, "zmq: Close socket at address %s\n", address);
+            int linger = 0;
+            zmq_setsockopt(psocket, ZMQ_LINGER, &linger, sizeof(linger));
+            zmq_close(psocket);
+        }
+
+        psocket = nullptr;
+        fLastPublisher = mapPublishNotifiers.empty();
     }
 
-    psocket = nullptr;
+    if (fLastPublisher) {
+        StopPublishThread();
+    }
 }
 
-bool CZMQAbstractPublishNotifier::SendZmqMessage(const char *command, const void* data, size_t size)
+bool CZMQAbstractPublishNotifier::SendZmqMessage(const char *command, std::shared_ptr<const std::vector<unsigned char>> data)
 {
     assert(psocket);
 
-    /* send three parts, command & data & a LE 4byte sequence number */
-    unsigned char msgseq[sizeof(uint32_t)];
-    WriteLE32(&msgseq[0], nSequence);
-    int rc = zmq_send_multipart(psocket, command, strlen(command), data, size, msgseq, (size_t)sizeof(uint32_t), nullptr);
-    if (rc == -1)
+    // sending happens on the zmqpub thread, a failure is reported with the next message
+    if (fSendFailed) {
         return false;
+    }
 
-    /* increment memory only sequence number after sending */
-    nSequence++;
+    {
+        LOCK(cs_queue);
+        const uint32_t nMessageSequence = nSequence++;
+        if (outbound_message_high_water_mark > 0 && queue.size() >= (size_t)outbound_message_high_water_mark) {
+            nDropped++;
+            LogPrint(BCLog::ZMQ, "zmq: Send queue for %s at %s is full, dropping %s message %u\n", type, address, command, nMessageSequence);
+            return true;
+        }
+        queue.push_back(OutboundMessage{command, std::move(data), nMessageSequence});
+        nQueuePeak = std::max(nQueuePeak, queue.size());
+    }
+    WakePublishThread();
 
     return true;
 }
 
-bool CZMQPublishHashBlockNotifier::NotifyBlock(const CBlockIndex *pindex)
+bool CZMQAbstractPublishNotifier::SendZmqMessage(const char *command, const void* data, size_t size)
 {
-    uint256 hash = pindex->GetBlockHash();
+    const unsigned char* begin = static_cast<const unsigned char*>(data);
+    return SendZmqMessage(command, std::make_shared<const std::vector<unsigned char>>(begin, begin + size));
+}
+
+void CZMQAbstractPublishNotifier::SendQueuedMessages()
+{
+    AssertLockHeld(cs_publishers);
+
+    std::deque<OutboundMessage> messages;
+    WITH_LOCK(cs_queue, messages.swap(queue));
+
+    uint64_t nMessagesSent{0};
+    for (const auto& message : messages) {
+        if (fSendFailed) break;
+
+        /* send three parts, command & data & a LE 4byte sequence number */
+        unsigned char msgseq[sizeof(uint32_t)];
+        WriteLE32(&msgseq[0], message.nSequence);
+        int rc = zmq_send_multipart(psocket, message.command, strlen(message.command), message.data->data(), message.data->size(), msgseq, (size_t)sizeof(uint32_t), nullptr);
+        if (rc == -1) {
+            fSendFailed = true;
+            break;
+        }
+
+        nMessagesSent++;
+    }
+
+    WITH_LOCK(cs_queue, nSent += nMessagesSent);
+}
+
+CZMQAbstractNotifier::QueueStats CZMQAbstractPublishNotifier::GetQueueStats() const
+{
+    LOCK(cs_queue);
+    QueueStats stats;
+    stats.nQueued = queue.size();
+    stats.nQueuePeak = nQueuePeak;
+    stats.nDropped = nDropped;
+    stats.nSent = nSent;
+    return stats;
+}
+
+bool CZMQPublishHashBlockNotifier::NotifyBlock(const CZMQBlock& block)
+{
+    uint256 hash = block.GetIndex()->GetBlockHash();
     LogPrint(BCLog::ZMQ, "zmq: Publish hashblock %s\n", hash.GetHex());
     char data[32];
     for (unsigned int i = 0; i < 32; i++)
@@ -204,9 +329,9 @@ bool CZMQPublishHashBlockNotifier::NotifyBlock(const CBlockIndex *pindex)
     return SendZmqMessage(MSG_HASHBLOCK, data, 32);
 }
 
-bool CZMQPublishHashChainLockNotifier::NotifyChainLock(const CBlockIndex *pindex, const std::shared_ptr<const llmq::CChainLockSig>& clsig)
+bool CZMQPublishHashChainLockNotifier::NotifyChainLock(const CZMQBlock& block, const std::shared_ptr<const llmq::CChainLockSig>& clsig)
 {
-    uint256 hash = pindex->GetBlockHash();
+    uint256 hash = block.GetIndex()->GetBlockHash();
     LogPrint(BCLog::ZMQ, "zmq: Publish hashchainlock %s\n", hash.GetHex());
     char data[32];
     for (unsigned int i = 0; i < 32; i++)
@@ -276,68 +401,43 @@ bool CZMQPublishHashRecoveredSigNotifier::NotifyRecoveredSig(const std::shared_p
     return SendZmqMessage(MSG_HASHRECSIG, data, 32);
 }
 
-bool CZMQPublishRawBlockNotifier::NotifyBlock(const CBlockIndex *pindex)
+bool CZMQPublishRawBlockNotifier::NotifyBlock(const CZMQBlock& block)
 {
-    LogPrint(BCLog::ZMQ, "zmq: Publish rawblock %s\n", pindex->GetBlockHash().GetHex());
+    LogPrint(BCLog::ZMQ, "zmq: Publish rawblock %s\n", block.GetIndex()->GetBlockHash().GetHex());
 
-    const Consensus::Params& consensusParams = Params().GetConsensus();
-    CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
-    {
-        LOCK(cs_main);
-        CBlock block;
-        if(!ReadBlockFromDisk(block, pindex, consensusParams))
-        {
-            zmqError("Can't read block from disk");
-            return false;
-        }
-
-        ss << block;
+    auto data = block.GetSerialized();
+    if (!data) {
+        return false;
     }
 
-    return SendZmqMessage(MSG_RAWBLOCK, &(*ss.begin()), ss.size());
+    return SendZmqMessage(MSG_RAWBLOCK, std::move(data));
 }
 
-bool CZMQPublishRawChainLockNotifier::NotifyChainLock(const CBlockIndex *pindex, const std::shared_ptr<const llmq::CChainLockSig>& clsig)
+bool CZMQPublishRawChainLockNotifier::NotifyChainLock(const CZMQBlock& block, const std::shared_ptr<const llmq::CChainLockSig>& clsig)
 {
-    LogPrint(BCLog::ZMQ, "zmq: Publish rawchainlock %s\n", pindex->GetBlockHash().GetHex());
-
-    const Consensus::Params& consensusParams = Params().GetConsensus();
-    CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
-    {
-        LOCK(cs_main);
-        CBlock block;
-        if(!ReadBlockFromDisk(block, pindex, consensusParams))
-        {
-            zmqError("Can't read block from disk");
-            return false;
-        }
+    LogPrint(BCLog::ZMQ, "zmq: Publish rawchainlock %s\n", block.GetIndex()->GetBlockHash().GetHex());
 
-        ss << block;
+    auto data = block.GetSerialized();
+    if (!data) {
+        return false;
     }
 
-    return SendZmqMessage(MSG_RAWCHAINLOCK, &(*ss.begin()), ss.size());
+    return SendZmqMessage(MSG_RAWCHAINLOCK, std::move(data));
 }
 
-bool CZMQPublishRawChainLockSigNotifier::NotifyChainLock(const CBlockIndex *pindex, const std::shared_ptr<const llmq::CChainLockSig>& clsig)
+bool CZMQPublishRawChainLockSigNotifier::NotifyChainLock(const CZMQBlock& block, const std::shared_ptr<const llmq::CChainLockSig>& clsig)
 {
-    LogPrint(BCLog::ZMQ, "zmq: Publish rawchainlocksig %s\n", pindex->GetBlockHash().GetHex());
+    LogPrint(BCLog::ZMQ, "zmq: Publish rawchainlocksig %s\n", block.GetIndex()->GetBlockHash().GetHex());
 
-    const Consensus::Params& consensusParams = Params().GetConsensus();
-    CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
-    {
-        LOCK(cs_main);
-        CBlock block;
-        if(!ReadBlockFromDisk(block, pindex, consensusParams))
-        {
-            zmqError("Can't read block from disk");
-            return false;
-        }
-
-        ss << block;
-        ss << *clsig;
+    auto blockData = block.GetSerialized();
+    if (!blockData) {
+        return false;
     }
 
-    return SendZmqMessage(MSG_RAWCLSIG, &(*ss.begin()), ss.size());
+    auto data = std::make_shared<std::vector<unsigned char>>(*blockData);
+    CVectorWriter(SER_NETWORK, PROTOCOL_VERSION, *data, data->size()) << *clsig;
+
+    return SendZmqMessage(MSG_RAWCLSIG, std::move(data));
 }
 
 bool CZMQPublishRawTransactionNotifier::NotifyTransaction(const CTransaction &transaction)
@@ -7,25 +7,53 @@
 
 #include <zmq/zmqabstractnotifier.h>
 
+#include <atomic>
+#include <deque>
+
 class CBlockIndex;
 class CGovernanceVote;
 class CGovernanceObject;
 
+/**
+ * Messages are queued per publisher and sent by the "zmqpub" thread, so that
+ * slow sends don't hold up the validation interface queue. The queue of a
+ * publisher is bounded by its high water mark, messages which don't fit are
+ * dropped and counted.
+ */
 class CZMQAbstractPublishNotifier : public CZMQAbstractNotifier
 {
 private:
-    uint32_t nSequence {0U}; //!< upcounting per message sequence number
-
-public:
-
-    /* send zmq multipart message
+    struct OutboundMessage
+    {
+        const char* command;
+        std::shared_ptr<const std::vector<unsigned char>> data;
+        uint32_t nSequence;
+    };
+
+    mutable Mutex cs_queue;
+    //! upcounting per message sequence number, also taken by dropped messages so subscribers see the gap
+    uint32_t nSequence GUARDED_BY(cs_queue) {0U};
+    std::deque<OutboundMessage> queue GUARDED_BY(cs_queue);
+    size_t nQueuePeak GUARDED_BY(cs_queue) {0};
+    uint64_t nDropped GUARDED_BY(cs_queue) {0};
+    uint64_t nSent GUARDED_BY(cs_queue) {0};
+    std::atomic<bool> fSendFailed {false};
+
+public:
+    /* queue zmq multipart message
        parts:
           * command
           * data
           * message sequence number
+       returns false if an earlier message of this publisher couldn't be sent
     */
+    bool SendZmqMessage(const char *command, std::shared_ptr<const std::vector<unsigned char>> data);
     bool SendZmqMessage(const char *command, const void* data, size_t size);
 
+    /** Send all queued messages, only called from the zmqpub thread */
+    void SendQueuedMessages();
+    QueueStats GetQueueStats() const override;
+
     bool Initialize(void *pcontext) override;
     void Shutdown() override;
 };
@@ -33,13 +61,13 @@ public:
 class CZMQPublishHashBlockNotifier : public CZMQAbstractPublishNotifier
 {
 public:
-    bool NotifyBlock(const CBlockIndex *pindex) override;
+    bool NotifyBlock(const CZMQBlock& block) override;
 };
 
 class CZMQPublishHashChainLockNotifier : public CZMQAbstractPublishNotifier
 {
 public:
-    bool NotifyChainLock(const CBlockIndex *pindex, const std::shared_ptr<const llmq::CChainLockSig>& clsig) override;
+    bool NotifyChainLock(const CZMQBlock& block, const std::shared_ptr<const llmq::CChainLockSig>& clsig) override;
 };
 
 class CZMQPublishHashTransactionNotifier : public CZMQAbstractPublishNotifier
@@ -81,19 +109,19 @@ public:
 class CZMQPublishRawBlockNotifier : public CZMQAbstractPublishNotifier
 {
 public:
-    bool NotifyBlock(const CBlockIndex *pindex) override;
+    bool NotifyBlock(const CZMQBlock& block) override;
 };
 
 class CZMQPublishRawChainLockNotifier : public CZMQAbstractPublishNotifier
 {
 public:
-    bool NotifyChainLock(const CBlockIndex *pindex, const std::shared_ptr<const llmq::CChainLockSig>& clsig) override;
+    bool NotifyChainLock(const CZMQBlock& block, const std::shared_ptr<const llmq::CChainLockSig>& clsig) override;
 };
 
 class CZMQPublishRawChainLockSigNotifier : public CZMQAbstractPublishNotifier
 {
 public:
-    bool NotifyChainLock(const CBlockIndex *pindex, const std::shared_ptr<const llmq::CChainLockSig>& clsig) override;
+    bool NotifyChainLock(const CZMQBlock& block, const std::shared_ptr<const llmq::CChainLockSig>& clsig) override;
 };
 
 class CZMQPublishRawTransactionNotifier : public CZMQAbstractPublishNotifier
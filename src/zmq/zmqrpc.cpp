@@ -28,6 +28,10 @@ UniValue getzmqnotifications(const JSONRPCRequest& request)
                             {RPCResult::Type::STR, "type", "Type of notification"},
                             {RPCResult::Type::STR, "address", "Address of the publisher"},
                             {RPCResult::Type::NUM, "hwm", "Outbound message high water mark"},
+                            {RPCResult::Type::NUM, "queued", "Messages waiting to be sent"},
+                            {RPCResult::Type::NUM, "queuepeak", "Most messages which were waiting to be sent at once"},
+                            {RPCResult::Type::NUM, "dropped", "Messages dropped because the queue was at the high water mark"},
+                            {RPCResult::Type::NUM, "sent", "Messages sent"},
                         }},
                     }
                 },
@@ -45,6 +49,11 @@ UniValue getzmqnotifications(const JSONRPCRequest& request)
             obj.pushKV("type", n->GetType());
             obj.pushKV("address", n->GetAddress());
             obj.pushKV("hwm", n->GetOutboundMessageHighWaterMark());
+            const auto stats = n->GetQueueStats();
+            obj.pushKV("queued", (uint64_t)stats.nQueued);
+            obj.pushKV("queuepeak", (uint64_t)stats.nQueuePeak);
+            obj.pushKV("dropped", stats.nDropped);
+            obj.pushKV("sent", stats.nSent);
             result.push_back(obj);
         }
     }
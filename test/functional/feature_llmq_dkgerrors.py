@@ -71,6 +71,16 @@ class LLMQDKGErrors(CosantaTestFramework):
         qh = self.mine_quorum(expected_contributions=3, expected_complaints=0, expected_justifications=0, expected_commitments=2)
         self.assert_member_valid(qh, self.mninfo[0].proTxHash, True)
 
+        self.log.info("Heal some damage (don't get PoSe banned)")
+        self.heal_masternodes(33)
+
+        self.log.info("Lets send two different contributions")
+        self.mninfo[0].node.quorum('dkgsimerror', 'commit-lie', '0')
+        self.mninfo[0].node.quorum('dkgsimerror', 'contribution-dup', '1')
+        qh = self.mine_quorum(expected_contributions=3, expected_complaints=2)
+        self.assert_member_valid(qh, self.mninfo[0].proTxHash, False)
+        self.mninfo[0].node.quorum('dkgsimerror', 'contribution-dup', '0')
+
     def assert_member_valid(self, quorumHash, proTxHash, expectedValid):
         q = self.nodes[0].quorum('info', 100, quorumHash, True)
         for m in q['members']:
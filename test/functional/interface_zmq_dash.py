@@ -413,7 +413,8 @@ class DashZMQTest (DashTestFramework):
 
     def test_getzmqnotifications(self):
         # Test getzmqnotifications RPC
-        assert_equal(self.nodes[0].getzmqnotifications(), [
+        notifications = self.nodes[0].getzmqnotifications()
+        assert_equal([{k: n[k] for k in ("type", "address", "hwm")} for n in notifications], [
             {"type": "pubhashchainlock", "address": self.address, "hwm": 1000},
             {"type": "pubhashgovernanceobject", "address": self.address, "hwm": 1000},
             {"type": "pubhashgovernancevote", "address": self.address, "hwm": 1000},
@@ -429,6 +430,9 @@ class DashZMQTest (DashTestFramework):
             {"type": "pubrawtxlock", "address": self.address, "hwm": 1000},
             {"type": "pubrawtxlocksig", "address": self.address, "hwm": 1000},
         ])
+        for n in notifications:
+            assert_equal(n["dropped"], 0)
+            assert n["queuepeak"] <= n["hwm"]
 
 if __name__ == '__main__':
     DashZMQTest().main()
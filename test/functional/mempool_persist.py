@@ -33,14 +33,27 @@ Test is as follows:
     mempool.
   - Verify that savemempool throws when the RPC is called if
     node1 can't write to disk.
+  - Create a chain of 3 transactions on node2 and write a mempool.dat
+    for node0 which has the children before their parents and a
+    transaction with a missing input. Verify that node0 loads the
+    chain and rejects the other one.
+  - Write a mempool.dat with 100000 transactions for node0 and stop
+    node0 while it loads them. Verify that it stops at the end of a
+    batch and doesn't dump the partially loaded mempool.
 
 """
 from decimal import Decimal
 import os
+import random
+import re
+import struct
 
+from test_framework.messages import COutPoint, CTransaction, FromHex, ser_compact_size, ser_uint256
 from test_framework.test_framework import BitcoinTestFramework
 from test_framework.util import assert_equal, assert_raises_rpc_error, wait_until
 
+MEMPOOL_LOAD_BATCH_SIZE = 1000
+
 class MempoolPersistTest(BitcoinTestFramework):
     def set_test_params(self):
         self.num_nodes = 3
@@ -119,6 +132,77 @@ class MempoolPersistTest(BitcoinTestFramework):
         assert_raises_rpc_error(-1, "Unable to dump mempool to disk", self.nodes[1].savemempool)
         os.rmdir(mempooldotnew1)
 
+        self.log.debug("Create a chain of transactions on node2, which isn't connected to node0 after its restart")
+        self.stop_nodes()
+        self.start_node(2)
+        wait_until(lambda: self.nodes[2].getmempoolinfo()["loaded"])
+        # a confirmed coin, so node0 knows it as well
+        utxo = self.nodes[2].listunspent()[0]
+        prevout = {"txid": utxo["txid"], "vout": utxo["vout"]}
+        amount = utxo["amount"]
+        chain = []
+        for _ in range(3):
+            amount -= Decimal("0.001")
+            rawtx = self.nodes[2].createrawtransaction([prevout], {self.nodes[2].getnewaddress(): amount})
+            txid = self.nodes[2].sendrawtransaction(self.nodes[2].signrawtransactionwithwallet(rawtx)["hex"])
+            tx = FromHex(CTransaction(), self.nodes[2].getrawtransaction(txid))
+            tx.rehash()
+            chain.append(tx)
+            prevout = {"txid": txid, "vout": 0}
+        self.stop_node(2)
+
+        self.log.debug("Load a mempool.dat with the children stored before their parents and a transaction with a missing input on node0")
+        # spends a coin which doesn't exist
+        orphan = CTransaction(chain[0])
+        orphan.vin[0].prevout = COutPoint(random.getrandbits(256), 0)
+        self.write_mempool_dat(mempooldat0, [tx.serialize() for tx in [chain[2], chain[1], orphan, chain[0]]])
+        with self.nodes[0].assert_debug_log(["Imported mempool transactions from disk: 3 succeeded, 1 failed"]):
+            self.start_node(0)
+            wait_until(lambda: self.nodes[0].getmempoolinfo()["loaded"])
+        assert_equal(sorted(self.nodes[0].getrawmempool()), sorted(tx.hash for tx in chain))
+
+        self.log.debug("Stop node0 while it loads a large mempool.dat. Verify that it stops at the end of a batch")
+        self.stop_node(0)
+        num_txs = 100 * MEMPOOL_LOAD_BATCH_SIZE
+        # spends of coins which don't exist are cheap to create and still validated one by one, only the
+        # hash of the spent coin is replaced in the serialized orphan (after the version and input count)
+        orphan_ser = orphan.serialize()
+        txs = [orphan_ser[:5] + ser_uint256(i + 1) + orphan_ser[37:] for i in range(num_txs)]
+        self.write_mempool_dat(mempooldat0, txs)
+        mempooldat0_size = os.path.getsize(mempooldat0)
+        debug_log = os.path.join(self.nodes[0].datadir, self.chain, 'debug.log')
+        log_start = os.path.getsize(debug_log)
+
+        def read_log():
+            with open(debug_log, encoding='utf-8') as dl:
+                dl.seek(log_start)
+                return dl.read()
+
+        self.start_node(0)
+        wait_until(lambda: "Validating %d mempool transactions from disk" % num_txs in read_log())
+        self.stop_node(0)
+        match = re.search(r"Mempool import interrupted after (\d+) of (\d+) transactions", read_log())
+        assert match is not None
+        num_processed = int(match.group(1))
+        assert_equal(int(match.group(2)), num_txs)
+        assert_equal(num_processed % MEMPOOL_LOAD_BATCH_SIZE, 0)
+        assert num_processed < num_txs
+        # the partially loaded mempool isn't dumped
+        assert "Imported mempool transactions from disk" not in read_log()
+        assert_equal(os.path.getsize(mempooldat0), mempooldat0_size)
+
+    def write_mempool_dat(self, path, txs):
+        """Write the serialized transactions to a mempool.dat in the format without the stored entry data"""
+        with open(path, 'wb') as f:
+            f.write(struct.pack("<Q", 1))
+            f.write(struct.pack("<Q", len(txs)))
+            for tx in txs:
+                f.write(tx)
+                # time and fee delta
+                f.write(struct.pack("<qq", self.mocktime, 0))
+            # no fee deltas
+            f.write(ser_compact_size(0))
+
 
 if __name__ == '__main__':
     MempoolPersistTest().main()
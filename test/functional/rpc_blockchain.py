@@ -181,6 +181,15 @@ class BlockchainTest(BitcoinTestFramework):
         assert_equal(len(res['bestblock']), 64)
         assert_equal(len(res['hash_serialized_2']), 64)
 
+        self.log.info("Test that the incrementally maintained statistics match the full scan")
+        res_muhash = node.gettxoutsetinfo("muhash")
+        for key in ['total_amount', 'height', 'txouts', 'bogosize', 'bestblock', 'disk_size']:
+            assert_equal(res[key], res_muhash[key])
+        assert_equal(len(res_muhash['muhash']), 64)
+        assert 'hash_serialized_2' not in res_muhash
+        assert 'muhash' not in node.gettxoutsetinfo("none")
+        assert_raises_rpc_error(-8, "foo is not a valid hash_type", node.gettxoutsetinfo, "foo")
+
         self.log.info("Test that gettxoutsetinfo() works for blockchain with just the genesis block")
         b1hash = node.getblockhash(1)
         node.invalidateblock(b1hash)
@@ -194,6 +203,11 @@ class BlockchainTest(BitcoinTestFramework):
         assert_equal(res2['bestblock'], node.getblockhash(0))
         assert_equal(len(res2['hash_serialized_2']), 64)
 
+        res2_muhash = node.gettxoutsetinfo("muhash")
+        assert_equal(res2_muhash['txouts'], 0)
+        assert_equal(res2_muhash['total_amount'], Decimal('0'))
+        assert res2_muhash['muhash'] != res_muhash['muhash']
+
         self.log.info("Test that gettxoutsetinfo() returns the same result after invalidate/reconsider block")
         node.reconsiderblock(b1hash)
 
@@ -205,6 +219,11 @@ class BlockchainTest(BitcoinTestFramework):
         assert_equal(res['bogosize'], res3['bogosize'])
         assert_equal(res['bestblock'], res3['bestblock'])
         assert_equal(res['hash_serialized_2'], res3['hash_serialized_2'])
+        assert_equal(res_muhash, node.gettxoutsetinfo("muhash"))
+
+        self.log.info("Test that the statistics are persisted across restarts")
+        self.restart_node(0, extra_args=['-stopatheight=207', '-prune=1', '-txindex=0'])
+        assert_equal(res_muhash['muhash'], node.gettxoutsetinfo("muhash")['muhash'])
 
     def _test_getblockheader(self):
         node = self.nodes[0]
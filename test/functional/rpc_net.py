@@ -60,6 +60,7 @@ class NetTest(BitcoinTestFramework):
 
         self._test_connection_count()
         self._test_getnettotals()
+        self._test_getnetmsgstats()
         self._test_getnetworkinfo()
         self._test_getaddednodeinfo()
         self._test_getpeerinfo()
@@ -102,6 +103,20 @@ class NetTest(BitcoinTestFramework):
             assert_greater_than_or_equal(after['bytesrecv_per_msg']['pong'], before['bytesrecv_per_msg']['pong'] + 32)
             assert_greater_than_or_equal(after['bytessent_per_msg']['ping'], before['bytessent_per_msg']['ping'] + 32)
 
+    def _test_getnetmsgstats(self):
+        # every peer answered the ping above, so all of them have pong processing costs
+        wait_until(lambda: all(['pong' in peer['cost_per_msg'] for peer in self.nodes[0].getpeerinfo()]), timeout=1)
+        peer_info = self.nodes[0].getpeerinfo()
+        msg_stats = self.nodes[0].getnetmsgstats()
+        pong_count = 0
+        for peer in peer_info:
+            pong_cost = peer['cost_per_msg']['pong']
+            assert_greater_than_or_equal(pong_cost['count'], 1)
+            assert_greater_than_or_equal(pong_cost['time'], pong_cost['maxtime'])
+            pong_count += pong_cost['count']
+        assert_greater_than_or_equal(msg_stats['pong']['count'], pong_count)
+        assert_greater_than_or_equal(msg_stats['version']['count'], len(peer_info))
+
     def _test_getnetworkinfo(self):
         assert_equal(self.nodes[0].getnetworkinfo()['networkactive'], True)
         assert_equal(self.nodes[0].getnetworkinfo()['connections'], 3)